@@ -1,24 +1,43 @@
 ### Vertex
 #value(SHADER_VERSION_LONG)
 
+/// One instance per face, advanced once per instance
 layout (location = 0) in uint a_BlockDataLowerBits;
 layout (location = 1) in uint a_BlockDataUpperBits;
 
 #include "assets/shaders/CommonBindings.glsl"
 
-uniform vec3 u_GlobalPosition;
+/// One entry per draw command, xyz is the chunk origin offset to the center of its first block
+/// and w is blocks per cell of LOD meshes, 1 for full meshes
+layout (std430, binding = #value(CHUNK_DRAW_DATA_BINDING)) readonly buffer ChunkDrawDataBuffer
+{
+    vec4 u_ChunkDrawData[];
+};
+
+/// Index of the first draw data entry of this call, gl_DrawID starts from 0 in every call
+uniform int u_DrawDataOffset;
 
-out flat uint v_Layer;
-out vec2 v_TexCoord;
+out flat uint  v_Layer;
+out flat float v_TexOffset;
+out vec2 v_TileCoord;
 out vec3 v_Normal;
+out float v_Brightness;
 
 const float uvWidth  = 1.0 / #value(BLOCK_FACE_COUNT);
 const float uvHeight = 1.0;
 
 const int blockFaceCount       = #value(BLOCK_FACE_COUNT);
+const int blockCornersPerFace  = #value(BLOCK_CORNERS_PER_FACE);
 const int blockVerticesPerFace = #value(BLOCK_VERTICES_PER_FACE);
 
-const vec2 blockFaceUV[blockFaceCount][blockVerticesPerFace] = vec2[blockFaceCount][blockVerticesPerFace](
+/// Two triangles of a face, drawn without an index buffer. Flipped faces are split along the other diagonal
+const uint blockFaceCornerOrder[blockVerticesPerFace]        = uint[](0u, 1u, 2u, 2u, 3u, 0u);
+const uint blockFaceCornerOrderFlipped[blockVerticesPerFace] = uint[](1u, 2u, 3u, 3u, 0u, 1u);
+
+/// Brightness of a corner by its baked occlusion level
+const float blockCornerBrightness[4] = float[](1.0, 0.8, 0.62, 0.45);
+
+const vec2 blockFaceUV[blockFaceCount][blockCornersPerFace] = vec2[blockFaceCount][blockCornersPerFace](
     vec2[](vec2(0.0,           0.0), vec2(uvWidth,       0.0), vec2(uvWidth,       uvHeight), vec2(0.0,           uvHeight)), /// Front
     vec2[](vec2(uvWidth,       0.0), vec2(2.0 * uvWidth, 0.0), vec2(2.0 * uvWidth, uvHeight), vec2(uvWidth,       uvHeight)), /// Left
     vec2[](vec2(2.0 * uvWidth, 0.0), vec2(3.0 * uvWidth, 0.0), vec2(3.0 * uvWidth, uvHeight), vec2(2.0 * uvWidth, uvHeight)), /// Back
@@ -36,7 +55,7 @@ const vec3 blockFaceNormals[blockFaceCount] = vec3[](
     vec3( 0.0, -1.0,  0.0)  /// Bottom
 );
 
-const vec3 blockFacePositions[blockFaceCount][blockVerticesPerFace] = vec3[blockFaceCount][blockVerticesPerFace](
+const vec3 blockFacePositions[blockFaceCount][blockCornersPerFace] = vec3[blockFaceCount][blockCornersPerFace](
     vec3[](vec3(-0.5, -0.5,  0.5), vec3( 0.5, -0.5,  0.5), vec3( 0.5,  0.5,  0.5), vec3(-0.5,  0.5,  0.5)), /// Front
     vec3[](vec3(-0.5, -0.5, -0.5), vec3(-0.5, -0.5,  0.5), vec3(-0.5,  0.5,  0.5), vec3(-0.5,  0.5, -0.5)), /// Left
     vec3[](vec3( 0.5, -0.5, -0.5), vec3(-0.5, -0.5, -0.5), vec3(-0.5,  0.5, -0.5), vec3( 0.5,  0.5, -0.5)), /// Back
@@ -45,6 +64,42 @@ const vec3 blockFacePositions[blockFaceCount][blockVerticesPerFace] = vec3[block
     vec3[](vec3(-0.5, -0.5, -0.5), vec3( 0.5, -0.5, -0.5), vec3( 0.5, -0.5,  0.5), vec3(-0.5, -0.5,  0.5))  /// Bottom
 );
 
+/// Two diagonal quads of cross blocks, each listed once per side
+const int blockCrossFaceCount = #value(BLOCK_CROSS_FACE_COUNT);
+
+const vec3 blockCrossPositions[blockCrossFaceCount][blockCornersPerFace] = vec3[blockCrossFaceCount][blockCornersPerFace](
+    vec3[](vec3(-0.5, -0.5, -0.5), vec3( 0.5, -0.5,  0.5), vec3( 0.5,  0.5,  0.5), vec3(-0.5,  0.5, -0.5)),
+    vec3[](vec3( 0.5, -0.5,  0.5), vec3(-0.5, -0.5, -0.5), vec3(-0.5,  0.5, -0.5), vec3( 0.5,  0.5,  0.5)),
+    vec3[](vec3(-0.5, -0.5,  0.5), vec3( 0.5, -0.5, -0.5), vec3( 0.5,  0.5, -0.5), vec3(-0.5,  0.5,  0.5)),
+    vec3[](vec3( 0.5, -0.5, -0.5), vec3(-0.5, -0.5,  0.5), vec3(-0.5,  0.5,  0.5), vec3( 0.5,  0.5, -0.5))
+);
+
+const vec3 blockCrossNormals[blockCrossFaceCount] = vec3[](
+    vec3(-0.70710678, 0.0,  0.70710678),
+    vec3( 0.70710678, 0.0, -0.70710678),
+    vec3( 0.70710678, 0.0,  0.70710678),
+    vec3(-0.70710678, 0.0, -0.70710678)
+);
+
+/// Greedy quads are stretched along two axes of the face, width along the first and height along the second
+const vec3 blockFaceWidthAxis[blockFaceCount] = vec3[](
+    vec3(1.0, 0.0, 0.0), /// Front
+    vec3(0.0, 0.0, 1.0), /// Left
+    vec3(1.0, 0.0, 0.0), /// Back
+    vec3(0.0, 0.0, 1.0), /// Right
+    vec3(1.0, 0.0, 0.0), /// Top
+    vec3(1.0, 0.0, 0.0)  /// Bottom
+);
+
+const vec3 blockFaceHeightAxis[blockFaceCount] = vec3[](
+    vec3(0.0, 1.0, 0.0), /// Front
+    vec3(0.0, 1.0, 0.0), /// Left
+    vec3(0.0, 1.0, 0.0), /// Back
+    vec3(0.0, 1.0, 0.0), /// Right
+    vec3(0.0, 0.0, 1.0), /// Top
+    vec3(0.0, 0.0, 1.0)  /// Bottom
+);
+
 /// TODO: Do it in compiler time
 uint UnpackBits(uint lower, uint upper, uint shift, uint bits)
 {
@@ -71,6 +126,10 @@ uint UnpackBits(uint lower, uint upper, uint shift, uint bits)
 
 void main()
 {
+    vec4  drawData       = u_ChunkDrawData[u_DrawDataOffset + gl_DrawID];
+    vec3  globalPosition = drawData.xyz;
+    float lodScale       = drawData.w;
+
     /// Extracting block data
     uint positionX = UnpackBits(a_BlockDataLowerBits, a_BlockDataUpperBits, #value(BLOCK_MESH_SHIFT_POSITION_X), #value(BLOCK_MESH_BITS_FOR_POSITION_X));
     uint positionY = UnpackBits(a_BlockDataLowerBits, a_BlockDataUpperBits, #value(BLOCK_MESH_SHIFT_POSITION_Y), #value(BLOCK_MESH_BITS_FOR_POSITION_Y));
@@ -78,23 +137,73 @@ void main()
     uint rotation  = UnpackBits(a_BlockDataLowerBits, a_BlockDataUpperBits, #value(BLOCK_MESH_SHIFT_ROTATION), #value(BLOCK_MESH_BITS_FOR_ROTATION));
 
     uint face        = UnpackBits(a_BlockDataLowerBits, a_BlockDataUpperBits, #value(BLOCK_MESH_SHIFT_FACE), #value(BLOCK_MESH_BITS_FOR_FACE));
-    uint vertexIndex = UnpackBits(a_BlockDataLowerBits, a_BlockDataUpperBits, #value(BLOCK_MESH_SHIFT_VERTEX_INDEX), #value(BLOCK_MESH_BITS_FOR_VERTEX_INDEX));
     uint layer       = UnpackBits(a_BlockDataLowerBits, a_BlockDataUpperBits, #value(BLOCK_MESH_SHIFT_LAYER), #value(BLOCK_MESH_BITS_FOR_LAYER));
+    uint width       = UnpackBits(a_BlockDataLowerBits, a_BlockDataUpperBits, #value(BLOCK_MESH_SHIFT_WIDTH),  #value(BLOCK_MESH_BITS_FOR_SIZE)) + 1u;
+    uint height      = UnpackBits(a_BlockDataLowerBits, a_BlockDataUpperBits, #value(BLOCK_MESH_SHIFT_HEIGHT), #value(BLOCK_MESH_BITS_FOR_SIZE)) + 1u;
+    uint geometry    = UnpackBits(a_BlockDataLowerBits, a_BlockDataUpperBits, #value(BLOCK_MESH_SHIFT_GEOMETRY), #value(BLOCK_MESH_BITS_FOR_GEOMETRY));
+    uint occlusion   = UnpackBits(a_BlockDataLowerBits, a_BlockDataUpperBits, #value(BLOCK_MESH_SHIFT_AO),   #value(BLOCK_MESH_BITS_FOR_AO));
+    uint flipped     = UnpackBits(a_BlockDataLowerBits, a_BlockDataUpperBits, #value(BLOCK_MESH_SHIFT_FLIP), #value(BLOCK_MESH_BITS_FOR_FLIP));
+
+    uint vertexIndex = flipped != 0u ? blockFaceCornerOrderFlipped[gl_VertexID] : blockFaceCornerOrder[gl_VertexID];
+
+    uint cornerOcclusion = (occlusion >> (vertexIndex * #value(BLOCK_MESH_BITS_FOR_AO_CORNER))) & ((1u << #value(BLOCK_MESH_BITS_FOR_AO_CORNER)) - 1u);
+    v_Brightness = blockCornerBrightness[cornerOcclusion];
 
     /// Block data
-    vec3 position = u_GlobalPosition + vec3(positionX, positionY, positionZ);
+    vec3 position = vec3(positionX, positionY, positionZ);
 
-    if (face == #value(BLOCK_MESH_FACE_TOP)) 
-        v_TexCoord = blockFaceUV[face][(vertexIndex - rotation + blockFaceCount) % blockFaceCount];
+    vec2 texCoord;
+    uint texFace = face;
+    if (geometry == #value(BLOCK_GEOMETRY_CROSS))
+    {
+        /// Both diagonals show the front texture
+        texFace  = 0u;
+        texCoord = blockFaceUV[texFace][vertexIndex];
+    }
+    else if (face == #value(BLOCK_MESH_FACE_TOP)) 
+        texCoord = blockFaceUV[face][(vertexIndex - rotation + blockCornersPerFace) % blockCornersPerFace];
     else if (face == #value(BLOCK_MESH_FACE_BOTTOM))
-        v_TexCoord = blockFaceUV[face][(vertexIndex + rotation) % blockFaceCount];
+        texCoord = blockFaceUV[face][(vertexIndex + rotation) % blockCornersPerFace];
     else 
-        v_TexCoord = blockFaceUV[(face + rotation) % blockFaceCount][vertexIndex];
+    {
+        texFace  = (face + rotation) % blockFaceCount;
+        texCoord = blockFaceUV[texFace][vertexIndex];
+    }
 
-    v_Normal = blockFaceNormals[face];
-    v_Layer  = layer;
+    /// Coordinates inside the face are scaled by quad size and wrapped back into the face in the fragment shader,
+    /// faces of one layer are stored side by side so the sampler can not repeat them itself
+    v_TexOffset = float(texFace) * uvWidth;
+    v_TileCoord = vec2((texCoord.x - v_TexOffset) / uvWidth, texCoord.y / uvHeight) * vec2(width, height) * lodScale;
+    v_Layer     = layer;
 
-    gl_Position = u_ViewProjection * vec4(position + blockFacePositions[face][vertexIndex], 1.0);
+    vec3 corner;
+    if (geometry == #value(BLOCK_GEOMETRY_CROSS))
+    {
+        corner   = blockCrossPositions[face][vertexIndex];
+        v_Normal = blockCrossNormals[face];
+    }
+    else
+    {
+        corner   = blockFacePositions[face][vertexIndex];
+        v_Normal = blockFaceNormals[face];
+
+        if (geometry == #value(BLOCK_GEOMETRY_SLAB))
+        {
+            /// Lower half, side faces show the lower half of their texture
+            corner.y = min(corner.y, 0.0);
+            if (face != #value(BLOCK_MESH_FACE_TOP) && face != #value(BLOCK_MESH_FACE_BOTTOM))
+                v_TileCoord.y *= 0.5;
+        }
+        else if (geometry == #value(BLOCK_GEOMETRY_PLANE))
+            corner.y = -0.5 + #value(BLOCK_PLANE_HEIGHT);
+    }
+
+    /// Shaped blocks are never merged, their width and height stay 1
+    vec3 stretch = (corner + 0.5) * (blockFaceWidthAxis[face] * float(width - 1u) + blockFaceHeightAxis[face] * float(height - 1u));
+
+    /// Cells of LOD meshes start at the first block they cover, globalPosition is already offset to the center of that block
+    vec3 local = (position + corner + stretch + 0.5) * lodScale - 0.5;
+    gl_Position = u_ViewProjection * vec4(globalPosition + local, 1.0);
 }
 
 ### Fragment
@@ -105,16 +214,24 @@ layout (location = 1) out vec4 o_Normal;
 
 uniform sampler2DArray u_Textures;
 
-in flat uint v_Layer;
-in vec2 v_TexCoord;
+in flat uint  v_Layer;
+in flat float v_TexOffset;
+in vec2 v_TileCoord;
 in vec3 v_Normal;
+in float v_Brightness;
+
+const float uvWidth  = 1.0 / #value(BLOCK_FACE_COUNT);
+const float uvHeight = 1.0;
 
 void main()
 {
-    vec4 color = texture(u_Textures, vec3(v_TexCoord, v_Layer));
+    /// Gradients come from the unwrapped coordinates, so mip selection does not jump at tile edges
+    vec2 uvScale  = vec2(uvWidth, uvHeight);
+    vec2 texCoord = vec2(v_TexOffset, 0.0) + fract(v_TileCoord) * uvScale;
+    vec4 color = textureGrad(u_Textures, vec3(texCoord, v_Layer), dFdx(v_TileCoord) * uvScale, dFdy(v_TileCoord) * uvScale);
     if (color.a < 0.1)
         discard;
 
-    o_Color = color;
+    o_Color = vec4(color.rgb * v_Brightness, color.a);
     o_Normal = vec4(v_Normal, 1.0);
 }
\ No newline at end of file
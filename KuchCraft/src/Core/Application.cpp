@@ -7,6 +7,22 @@
 
 namespace KuchCraft {
 
+	/// Draw lists are rebuilt by the next ImGui frame while a render thread may still be drawing the previous one
+	static Ref<ImDrawData> CloneImGuiDrawData(const ImDrawData* drawData)
+	{
+		Ref<ImDrawData> clone(new ImDrawData(*drawData), [](ImDrawData* data) {
+			for (int i = 0; i < data->CmdListsCount; i++)
+				IM_DELETE(data->CmdLists[i]);
+
+			delete data;
+		});
+
+		for (int i = 0; i < clone->CmdListsCount; i++)
+			clone->CmdLists[i] = drawData->CmdLists[i]->CloneOutput();
+
+		return clone;
+	}
+
 	Application::Application(int argc, char** argv)
 	{
 		KC_CORE_ASSERT(s_Instance == nullptr, "Application already exists!");
@@ -48,6 +64,19 @@ namespace KuchCraft {
 
 		m_LayerStack.AddLayer(m_GameLayer);
 		m_LayerStack.AddLayer(m_RendererLayer);
+
+		if (m_Config.Renderer.RenderThread)
+		{
+			/// ImGui creates its OpenGL objects on the first NewFrame, later calls only check them
+			if (m_Config.Application.EnableImGui)
+				ImGui_ImplOpenGL3_NewFrame();
+
+			m_Window->ReleaseContext();
+			m_Renderer->StartRenderThread(
+				[window = m_Window.get()]() { window->MakeContextCurrent(); },
+				[window = m_Window.get()]() { window->ReleaseContext();     }
+			);
+		}
 	}
 
 	Application::~Application()
@@ -66,6 +95,8 @@ namespace KuchCraft {
 
 		while (m_Running)
 		{
+			Ref<ImDrawData> imGuiDrawData;
+
 			m_Window->Update();
 			ProcessEvents();
 
@@ -117,11 +148,20 @@ namespace KuchCraft {
 					ImGui::EndFrame();
 
 					ImGui::Render();
-					ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+					if (m_Renderer->IsRenderThreadRunning())
+						imGuiDrawData = CloneImGuiDrawData(ImGui::GetDrawData());
+					else
+						imGuiDrawData = Ref<ImDrawData>(ImGui::GetDrawData(), [](ImDrawData*) {});
 				}
 			}
-	
-			m_Window->SwapBuffers();
+
+			/// Runs after the recorded frame, on the render thread when there is one
+			m_Renderer->Present([window = m_Window.get(), imGuiDrawData]() {
+				if (imGuiDrawData)
+					ImGui_ImplOpenGL3_RenderDrawData(imGuiDrawData.get());
+
+				window->SwapBuffers();
+			});
 			Input::ClearReleasedKeys();
 		}
 
@@ -141,6 +181,12 @@ namespace KuchCraft {
 
 	void Application::OnShutdown()
 	{
+		if (m_Renderer->IsRenderThreadRunning())
+		{
+			m_Renderer->StopRenderThread();
+			m_Window->MakeContextCurrent();
+		}
+
 		m_LayerStack.Clear();
 
 		if (m_Config.Application.EnableImGui)
@@ -39,6 +39,12 @@ namespace KuchCraft {
 			{ "MaxQuadsInBatch",          Renderer.MaxQuadsInBatch },
 			{ "MaxPlanesInBatch",         Renderer.MaxPlanesInBatch },
 			{ "RenderDistance",           Renderer.RenderDistance },
+			{ "GreedyMeshing",            Renderer.GreedyMeshing },
+			{ "AmbientOcclusion",         Renderer.AmbientOcclusion },
+			{ "LodDistance2x",            Renderer.LodDistance2x },
+			{ "LodDistance4x",            Renderer.LodDistance4x },
+			{ "CaveCulling",              Renderer.CaveCulling },
+			{ "RenderThread",             Renderer.RenderThread },
 		};
 
 		configJson["Game"] = {
@@ -162,6 +168,18 @@ namespace KuchCraft {
 				Renderer.MaxPlanesInBatch = rendererJson["MaxPlanesInBatch"];
 			if (rendererJson.contains("RenderDistance"))
 				Renderer.RenderDistance = rendererJson["RenderDistance"];
+			if (rendererJson.contains("GreedyMeshing"))
+				Renderer.GreedyMeshing = rendererJson["GreedyMeshing"];
+			if (rendererJson.contains("AmbientOcclusion"))
+				Renderer.AmbientOcclusion = rendererJson["AmbientOcclusion"];
+			if (rendererJson.contains("LodDistance2x"))
+				Renderer.LodDistance2x = rendererJson["LodDistance2x"];
+			if (rendererJson.contains("LodDistance4x"))
+				Renderer.LodDistance4x = rendererJson["LodDistance4x"];
+			if (rendererJson.contains("CaveCulling"))
+				Renderer.CaveCulling = rendererJson["CaveCulling"];
+			if (rendererJson.contains("RenderThread"))
+				Renderer.RenderThread = rendererJson["RenderThread"];
 		}
 
 		if (configJson.contains("Game"))
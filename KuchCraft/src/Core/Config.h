@@ -62,6 +62,21 @@ namespace KuchCraft {
 
 		uint32_t RenderDistance = 5;
 
+		/// Merge coplanar chunk faces with the same texture into larger quads
+		bool GreedyMeshing = true;
+		/// Darken chunk face corners next to opaque blocks, baked while meshing
+		bool AmbientOcclusion = true;
+
+		/// Chunks at least this far from the player, in chunks, are drawn with 2x and 4x downsampled meshes. 0 disables the level
+		uint32_t LodDistance2x = 8;
+		uint32_t LodDistance4x = 16;
+
+		/// Skip chunk sections that can not be seen through open blocks from the camera section
+		bool CaveCulling = true;
+
+		/// Execute frames on a render thread that owns the OpenGL context while the main thread records the next one
+		bool RenderThread = false;
+
 		std::string GetOpenGlVersion() const { return std::to_string(OpenGlMajorVersion * 100 + OpenGlMinorVersion * 10) + " core"; }
 	};
 
@@ -0,0 +1,183 @@
+#include "kcpch.h"
+#include "Core/Noise.h"
+
+#if defined(__AVX2__) || defined(__SSE4_1__)
+	#include <immintrin.h>
+	#define KC_NOISE_SSE41
+#endif
+
+namespace KuchCraft {
+
+	constexpr uint32_t noise_hash_prime_x = 0x8da6b343u;
+	constexpr uint32_t noise_hash_prime_y = 0xd8163841u;
+	constexpr uint32_t noise_hash_prime_z = 0xcb1ab31fu;
+	constexpr uint32_t noise_hash_mix_a   = 0x2c1b3c6du;
+	constexpr uint32_t noise_hash_mix_b   = 0x297a2d39u;
+
+	/// Keeps the output in roughly [-1, 1] for (+-1, +-1, +-1) gradients
+	constexpr float noise_output_scale = 0.9f;
+
+	static KC_FORCE_INLINE uint32_t HashLattice(uint32_t hx, uint32_t hy, uint32_t hz, uint32_t seed)
+	{
+		uint32_t h = seed ^ hx ^ hy ^ hz;
+		h ^= h >> 15;
+		h *= noise_hash_mix_a;
+		h ^= h >> 12;
+		h *= noise_hash_mix_b;
+		h ^= h >> 15;
+		return h;
+	}
+
+	static KC_FORCE_INLINE float GradientDot(uint32_t h, float x, float y, float z)
+	{
+		return ((h & 1) ? -x : x) + ((h & 2) ? -y : y) + ((h & 4) ? -z : z);
+	}
+
+	static KC_FORCE_INLINE float Fade(float t)
+	{
+		return t * t * t * (t * (t * 6.0f - 15.0f) + 10.0f);
+	}
+
+	static KC_FORCE_INLINE float Lerp(float a, float b, float t)
+	{
+		return a + (b - a) * t;
+	}
+
+	float GradientNoise::Sample(float x, float y, float z) const
+	{
+		const float fx = std::floor(x);
+		const float fy = std::floor(y);
+		const float fz = std::floor(z);
+
+		const float tx = x - fx;
+		const float ty = y - fy;
+		const float tz = z - fz;
+
+		const uint32_t hx0 = static_cast<uint32_t>(static_cast<int32_t>(fx)) * noise_hash_prime_x;
+		const uint32_t hy0 = static_cast<uint32_t>(static_cast<int32_t>(fy)) * noise_hash_prime_y;
+		const uint32_t hz0 = static_cast<uint32_t>(static_cast<int32_t>(fz)) * noise_hash_prime_z;
+		const uint32_t hx1 = hx0 + noise_hash_prime_x;
+		const uint32_t hy1 = hy0 + noise_hash_prime_y;
+		const uint32_t hz1 = hz0 + noise_hash_prime_z;
+
+		const float n000 = GradientDot(HashLattice(hx0, hy0, hz0, m_Seed), tx,        ty,        tz);
+		const float n100 = GradientDot(HashLattice(hx1, hy0, hz0, m_Seed), tx - 1.0f, ty,        tz);
+		const float n010 = GradientDot(HashLattice(hx0, hy1, hz0, m_Seed), tx,        ty - 1.0f, tz);
+		const float n110 = GradientDot(HashLattice(hx1, hy1, hz0, m_Seed), tx - 1.0f, ty - 1.0f, tz);
+		const float n001 = GradientDot(HashLattice(hx0, hy0, hz1, m_Seed), tx,        ty,        tz - 1.0f);
+		const float n101 = GradientDot(HashLattice(hx1, hy0, hz1, m_Seed), tx - 1.0f, ty,        tz - 1.0f);
+		const float n011 = GradientDot(HashLattice(hx0, hy1, hz1, m_Seed), tx,        ty - 1.0f, tz - 1.0f);
+		const float n111 = GradientDot(HashLattice(hx1, hy1, hz1, m_Seed), tx - 1.0f, ty - 1.0f, tz - 1.0f);
+
+		const float u = Fade(tx);
+		const float v = Fade(ty);
+		const float w = Fade(tz);
+
+		const float nx00 = Lerp(n000, n100, u);
+		const float nx10 = Lerp(n010, n110, u);
+		const float nx01 = Lerp(n001, n101, u);
+		const float nx11 = Lerp(n011, n111, u);
+
+		return Lerp(Lerp(nx00, nx10, v), Lerp(nx01, nx11, v), w) * noise_output_scale;
+	}
+
+#if defined(KC_NOISE_SSE41)
+
+	static KC_FORCE_INLINE __m128i HashLattice4(__m128i hx, uint32_t hy, uint32_t hz, uint32_t seed)
+	{
+		__m128i h = _mm_xor_si128(hx, _mm_set1_epi32(static_cast<int>(seed ^ hy ^ hz)));
+		h = _mm_xor_si128(h, _mm_srli_epi32(h, 15));
+		h = _mm_mullo_epi32(h, _mm_set1_epi32(static_cast<int>(noise_hash_mix_a)));
+		h = _mm_xor_si128(h, _mm_srli_epi32(h, 12));
+		h = _mm_mullo_epi32(h, _mm_set1_epi32(static_cast<int>(noise_hash_mix_b)));
+		h = _mm_xor_si128(h, _mm_srli_epi32(h, 15));
+		return h;
+	}
+
+	/// Same as GradientDot, the sign flips are done by moving hash bits into the float sign bit
+	static KC_FORCE_INLINE __m128 GradientDot4(__m128i h, __m128 x, __m128 y, __m128 z)
+	{
+		const __m128i one = _mm_set1_epi32(1);
+		const __m128 sx = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(h, one), 31));
+		const __m128 sy = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(_mm_srli_epi32(h, 1), one), 31));
+		const __m128 sz = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(_mm_srli_epi32(h, 2), one), 31));
+		return _mm_add_ps(_mm_add_ps(_mm_xor_ps(x, sx), _mm_xor_ps(y, sy)), _mm_xor_ps(z, sz));
+	}
+
+	static KC_FORCE_INLINE __m128 Fade4(__m128 t)
+	{
+		__m128 r = _mm_sub_ps(_mm_mul_ps(t, _mm_set1_ps(6.0f)), _mm_set1_ps(15.0f));
+		r = _mm_add_ps(_mm_mul_ps(t, r), _mm_set1_ps(10.0f));
+		return _mm_mul_ps(_mm_mul_ps(_mm_mul_ps(t, t), t), r);
+	}
+
+	static KC_FORCE_INLINE __m128 Lerp4(__m128 a, __m128 b, __m128 t)
+	{
+		return _mm_add_ps(a, _mm_mul_ps(_mm_sub_ps(b, a), t));
+	}
+
+#endif
+
+	void GradientNoise::SampleRowX(float* out, uint32_t count, float x, float stepX, float y, float z) const
+	{
+		uint32_t i = 0;
+
+#if defined(KC_NOISE_SSE41)
+		/// y and z are shared by the whole row, only x varies per lane
+		const float fy = std::floor(y);
+		const float fz = std::floor(z);
+		const float ty = y - fy;
+		const float tz = z - fz;
+
+		const uint32_t hy0 = static_cast<uint32_t>(static_cast<int32_t>(fy)) * noise_hash_prime_y;
+		const uint32_t hz0 = static_cast<uint32_t>(static_cast<int32_t>(fz)) * noise_hash_prime_z;
+		const uint32_t hy1 = hy0 + noise_hash_prime_y;
+		const uint32_t hz1 = hz0 + noise_hash_prime_z;
+
+		const __m128 ty0 = _mm_set1_ps(ty);
+		const __m128 ty1 = _mm_set1_ps(ty - 1.0f);
+		const __m128 tz0 = _mm_set1_ps(tz);
+		const __m128 tz1 = _mm_set1_ps(tz - 1.0f);
+		const __m128 v   = _mm_set1_ps(Fade(ty));
+		const __m128 w   = _mm_set1_ps(Fade(tz));
+
+		const __m128  oneF   = _mm_set1_ps(1.0f);
+		const __m128  laneX  = _mm_mul_ps(_mm_set_ps(3.0f, 2.0f, 1.0f, 0.0f), _mm_set1_ps(stepX));
+		const __m128i primeX = _mm_set1_epi32(static_cast<int>(noise_hash_prime_x));
+		const __m128  scale  = _mm_set1_ps(noise_output_scale);
+
+		for (; i + 4 <= count; i += 4)
+		{
+			const __m128 xs = _mm_add_ps(_mm_set1_ps(x + stepX * static_cast<float>(i)), laneX);
+			const __m128 fx = _mm_floor_ps(xs);
+			const __m128 tx0 = _mm_sub_ps(xs, fx);
+			const __m128 tx1 = _mm_sub_ps(tx0, oneF);
+
+			const __m128i hx0 = _mm_mullo_epi32(_mm_cvttps_epi32(fx), primeX);
+			const __m128i hx1 = _mm_add_epi32(hx0, primeX);
+
+			const __m128 n000 = GradientDot4(HashLattice4(hx0, hy0, hz0, m_Seed), tx0, ty0, tz0);
+			const __m128 n100 = GradientDot4(HashLattice4(hx1, hy0, hz0, m_Seed), tx1, ty0, tz0);
+			const __m128 n010 = GradientDot4(HashLattice4(hx0, hy1, hz0, m_Seed), tx0, ty1, tz0);
+			const __m128 n110 = GradientDot4(HashLattice4(hx1, hy1, hz0, m_Seed), tx1, ty1, tz0);
+			const __m128 n001 = GradientDot4(HashLattice4(hx0, hy0, hz1, m_Seed), tx0, ty0, tz1);
+			const __m128 n101 = GradientDot4(HashLattice4(hx1, hy0, hz1, m_Seed), tx1, ty0, tz1);
+			const __m128 n011 = GradientDot4(HashLattice4(hx0, hy1, hz1, m_Seed), tx0, ty1, tz1);
+			const __m128 n111 = GradientDot4(HashLattice4(hx1, hy1, hz1, m_Seed), tx1, ty1, tz1);
+
+			const __m128 u = Fade4(tx0);
+			const __m128 nx00 = Lerp4(n000, n100, u);
+			const __m128 nx10 = Lerp4(n010, n110, u);
+			const __m128 nx01 = Lerp4(n001, n101, u);
+			const __m128 nx11 = Lerp4(n011, n111, u);
+
+			const __m128 result = Lerp4(Lerp4(nx00, nx10, v), Lerp4(nx01, nx11, v), w);
+			_mm_storeu_ps(out + i, _mm_mul_ps(result, scale));
+		}
+#endif
+
+		for (; i < count; i++)
+			out[i] = Sample(x + stepX * static_cast<float>(i), y, z);
+	}
+
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <stdint.h>
+
+namespace KuchCraft {
+
+	/// Seeded 3D gradient noise.
+	/// Lattice gradients come from an integer hash instead of a permutation table,
+	/// so a whole row of samples can be evaluated without gathers.
+	class GradientNoise
+	{
+	public:
+		GradientNoise() = default;
+		GradientNoise(uint32_t seed) : m_Seed(seed) {}
+
+		void SetSeed(uint32_t seed) { m_Seed = seed; }
+		uint32_t GetSeed() const { return m_Seed; }
+
+		/// Returns noise value in roughly [-1, 1]
+		float Sample(float x, float y, float z) const;
+
+		/// Samples `count` points starting at (x, y, z) and stepping by `stepX` along x.
+		/// Uses SSE4.1 when available (Release/Dist are built with AVX2), scalar otherwise.
+		void SampleRowX(float* out, uint32_t count, float x, float stepX, float y, float z) const;
+
+	private:
+		uint32_t m_Seed = 0;
+	};
+
+}
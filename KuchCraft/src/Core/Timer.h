@@ -0,0 +1,26 @@
+#pragma once
+
+#include <chrono>
+
+namespace KuchCraft {
+
+	/// Simple wall clock timer used for profiling and benchmarks
+	class Timer
+	{
+	public:
+		Timer() { Reset(); }
+
+		void Reset() { m_Start = std::chrono::high_resolution_clock::now(); }
+
+		double GetElapsedSeconds() const
+		{
+			return std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - m_Start).count();
+		}
+
+		double GetElapsedMilliseconds() const { return GetElapsedSeconds() * 1000.0; }
+
+	private:
+		std::chrono::time_point<std::chrono::high_resolution_clock> m_Start;
+	};
+
+}
@@ -213,6 +213,16 @@ namespace KuchCraft {
 		glfwSwapBuffers(m_Window);
 	}
 
+	void Window::MakeContextCurrent()
+	{
+		glfwMakeContextCurrent(m_Window);
+	}
+
+	void Window::ReleaseContext()
+	{
+		glfwMakeContextCurrent(nullptr);
+	}
+
 	void Window::SetSize(int width, int height)
 	{
 		if (width < min_window_width || height < min_window_height ||
@@ -14,6 +14,10 @@ namespace KuchCraft {
 		void ProcessEvents();
 		void SwapBuffers();
 
+		/// The OpenGL context is current on at most one thread, it has to be released there before another thread takes it
+		void MakeContextCurrent();
+		void ReleaseContext();
+
 		int GetWidth()  const { return m_Data.Config.Width; }
 		int GetHeight() const { return m_Data.Config.Height; }
 		std::pair<int, int> GetSize() const { return { m_Data.Config.Width, m_Data.Config.Height }; }
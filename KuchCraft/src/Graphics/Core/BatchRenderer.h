@@ -0,0 +1,257 @@
+#pragma once
+
+#include "Graphics/Core/IndexBuffer.h"
+#include "Graphics/Core/StreamingBuffer.h"
+#include "Graphics/Core/VertexArray.h"
+#include "Graphics/Core/Shader.h"
+#include "Graphics/Core/RenderQueue.h"
+#include "Graphics/Core/RenderCommandBuffer.h"
+#include "Graphics/Core/TextureSlotTable.h"
+
+namespace KuchCraft {
+
+	/// Topology and indices of one primitive made of `VertexCount` vertices, specialized for every shape a BatchRenderer draws
+	template<uint32_t VertexCount, uint32_t IndexCount>
+	struct BatchIndexPattern;
+
+	/// Quad of two triangles, vertices counter clockwise from the bottom left
+	template<>
+	struct BatchIndexPattern<4, 6>
+	{
+		static constexpr PrimitiveTopology topology = PrimitiveTopology::Triangles;
+		static constexpr std::array<uint32_t, 6> indices = { 0, 1, 2, 2, 3, 0 };
+	};
+
+	template<>
+	struct BatchIndexPattern<2, 2>
+	{
+		static constexpr PrimitiveTopology topology = PrimitiveTopology::Lines;
+		static constexpr std::array<uint32_t, 2> indices = { 0, 1 };
+	};
+
+	struct BatchRendererSpecification
+	{
+		/// Prefix of debug names of the buffers
+		std::string Name;
+		/// Its vertex input layout has to match the vertex type, `u_Textures` samplers are set to slots 0 to TextureSlotCount - 1
+		Ref<KuchCraft::Shader> Shader;
+
+		uint32_t MaxPrimitivesInBatch = 10'000;
+		uint32_t TextureSlotCount     = 32;
+		/// Bound to slot 0 for untextured primitives
+		RendererID WhiteTexture = 0;
+	};
+
+	/// Of the last Submit
+	struct BatchRendererStats
+	{
+		uint32_t DrawCalls  = 0;
+		/// Triangles or lines, like Renderer stats count them
+		uint32_t Primitives = 0;
+	};
+
+	/// Collects primitives of one shape during a frame, sorts them with RenderQueue keys and records them in as few draws as
+	/// texture slots and the batch size allow. `Vertex` needs an `int TextureSlot` member, the slot is filled in while batching
+	template<typename Vertex, uint32_t VerticesPerPrimitive, uint32_t IndicesPerPrimitive>
+	class BatchRenderer
+	{
+		static_assert(std::is_trivially_copyable_v<Vertex>, "Batched vertices are recorded as plain data!");
+
+	public:
+		using IndexPattern = BatchIndexPattern<VerticesPerPrimitive, IndicesPerPrimitive>;
+
+		static constexpr uint32_t vertices_per_primitive = VerticesPerPrimitive;
+		static constexpr uint32_t indices_per_primitive  = IndicesPerPrimitive;
+		/// Full batches one streaming region holds, a frame with fewer batches never waits for a fence of its own frame
+		static constexpr uint32_t batches_per_streaming_region = 2;
+
+		/// Creates the buffers, needs the OpenGL context
+		void Init(const BatchRendererSpecification& specification)
+		{
+			m_Specification = specification;
+			m_MaxIndices    = specification.MaxPrimitivesInBatch * IndicesPerPrimitive;
+
+			m_VertexArray = VertexArray::Create();
+			m_VertexArray->Bind();
+			m_VertexArray->SetDebugName(specification.Name + "_VAO");
+
+			/// One vertex more per region leaves room to align the first batch of the region to the vertex stride
+			const size_t batchSize  = static_cast<size_t>(specification.MaxPrimitivesInBatch) * VerticesPerPrimitive * sizeof(Vertex);
+			const size_t regionSize = batchSize * batches_per_streaming_region + sizeof(Vertex);
+			m_StreamingBuffer = StreamingBuffer::Create(regionSize * StreamingRing::default_region_count);
+			m_StreamingBuffer->SetDebugName(specification.Name + "_VBO");
+			m_StreamingBuffer->GetVertexBuffer()->SetLayout(specification.Shader->GetVertexInputLayout());
+			m_VertexArray->AddVertexBuffer(m_StreamingBuffer->GetVertexBuffer());
+
+			std::vector<uint32_t> indices;
+			indices.reserve(m_MaxIndices);
+			for (uint32_t offset = 0; indices.size() < m_MaxIndices; offset += VerticesPerPrimitive)
+			{
+				for (uint32_t index : IndexPattern::indices)
+					indices.push_back(offset + index);
+			}
+
+			m_IndexBuffer = IndexBuffer::Create(indices.data(), m_MaxIndices);
+			m_IndexBuffer->SetDebugName(specification.Name + "_IBO");
+			m_VertexArray->SetIndexBuffer(m_IndexBuffer);
+
+			auto setupTextureSamplers = [textureSlotCount = specification.TextureSlotCount](Shader* shader) {
+				std::vector<int> samplers;
+				samplers.reserve(textureSlotCount);
+				for (uint32_t i = 0; i < textureSlotCount; i++)
+					samplers.push_back(static_cast<int>(i));
+
+				shader->SetIntArray("u_Textures", samplers.data(), static_cast<int>(textureSlotCount));
+			};
+
+			specification.Shader->Bind();
+			setupTextureSamplers(specification.Shader.get());
+			specification.Shader->AddReloadCallback(setupTextureSamplers);
+
+			m_TextureSlots = TextureSlotTable(specification.TextureSlotCount, 1);
+			m_TextureSlots.SetReserved(0, specification.WhiteTexture);
+
+			m_Vertices.reserve(static_cast<size_t>(specification.MaxPrimitivesInBatch) * VerticesPerPrimitive);
+			m_Textures.reserve(specification.MaxPrimitivesInBatch);
+		}
+
+		/// Vertices of one new primitive to be filled by the caller, `texture` 0 draws with the white texture.
+		/// Valid until the next call
+		Vertex* AddPrimitive(RendererID texture)
+		{
+			m_Textures.push_back(texture);
+			m_Vertices.resize(m_Vertices.size() + VerticesPerPrimitive);
+
+			return &m_Vertices[m_Vertices.size() - VerticesPerPrimitive];
+		}
+
+		bool     IsEmpty()  const { return m_Textures.empty(); }
+		uint32_t GetCount() const { return static_cast<uint32_t>(m_Textures.size()); }
+
+		/// Sorts primitives by `key(const Vertex* firstVertex, RendererID texture)`, a RenderSortKey, then records them into
+		/// `commands` and clears them. Render state like blending has to be recorded before
+		template<typename KeyFunction>
+		void Submit(RenderCommandBuffer& commands, KeyFunction&& key)
+		{
+			m_Stats = {};
+			if (IsEmpty())
+				return;
+
+			m_Queue.Clear();
+			m_Queue.Reserve(m_Textures.size());
+			for (uint32_t primitive = 0; primitive < GetCount(); primitive++)
+				m_Queue.Add(key(&m_Vertices[static_cast<size_t>(primitive) * VerticesPerPrimitive], m_Textures[primitive]), primitive);
+
+			m_Queue.Sort();
+
+			/// Primitives are copied in sorted order straight into the data block of `commands`, which the backend copies
+			/// into the mapped streaming buffer. Only commands are recorded below, so `sorted` stays valid
+			const size_t   vertexCount = static_cast<size_t>(GetCount()) * VerticesPerPrimitive;
+			const uint64_t dataOffset  = commands.ReserveData(vertexCount * sizeof(Vertex));
+			Vertex* sorted = reinterpret_cast<Vertex*>(commands.GetData(dataOffset));
+
+			commands.Record(RenderCommands::BindShader{ m_Specification.Shader->GetRendererID() });
+			commands.Record(RenderCommands::BindTexture{ 0, m_Specification.WhiteTexture });
+			commands.Record(RenderCommands::BindVertexArray{ m_VertexArray->GetRendererID() });
+
+			size_t   firstVertex = 0;
+			uint32_t indexCount  = 0;
+			m_TextureSlots.NextBatch();
+
+			const std::vector<RenderQueueItem>& items = m_Queue.GetItems();
+			for (size_t position = 0; position < items.size(); position++)
+			{
+				if (indexCount == m_MaxIndices)
+				{
+					Flush(commands, dataOffset, firstVertex, indexCount);
+					firstVertex += indexCount / IndicesPerPrimitive * VerticesPerPrimitive;
+					indexCount   = 0;
+				}
+
+				const uint32_t primitive = items[position].Index;
+				Vertex* vertices = sorted + position * VerticesPerPrimitive;
+				std::copy_n(&m_Vertices[static_cast<size_t>(primitive) * VerticesPerPrimitive], VerticesPerPrimitive, vertices);
+
+				/// Untextured primitives keep slot 0, the white texture
+				const RendererID texture = m_Textures[primitive];
+				if (texture != 0)
+				{
+					int textureSlot = m_TextureSlots.GetSlot(texture);
+					if (textureSlot == TextureSlotTable::invalid_slot)
+					{
+						Flush(commands, dataOffset, firstVertex, indexCount);
+						firstVertex += indexCount / IndicesPerPrimitive * VerticesPerPrimitive;
+						indexCount   = 0;
+
+						textureSlot = m_TextureSlots.GetSlot(texture);
+					}
+
+					for (uint32_t vertex = 0; vertex < VerticesPerPrimitive; vertex++)
+						vertices[vertex].TextureSlot = textureSlot;
+				}
+
+				indexCount += IndicesPerPrimitive;
+			}
+
+			Flush(commands, dataOffset, firstVertex, indexCount);
+
+			m_Vertices.clear();
+			m_Textures.clear();
+		}
+
+		const Ref<Shader>&        GetShader() const { return m_Specification.Shader; }
+		const BatchRendererStats& GetStats()  const { return m_Stats; }
+
+	private:
+		/// Streams `indexCount` indices of primitives starting at `firstVertex` of the recorded data and draws them
+		/// with the textures of the current batch, then starts the next batch
+		void Flush(RenderCommandBuffer& commands, uint64_t dataOffset, size_t firstVertex, uint32_t indexCount)
+		{
+			if (indexCount == 0)
+				return;
+
+			const size_t size = static_cast<size_t>(indexCount / IndicesPerPrimitive * VerticesPerPrimitive) * sizeof(Vertex);
+
+			/// Aligned to the stride, so the draw can start at the allocation with a base vertex
+			const StreamingAllocation allocation = m_StreamingBuffer->Allocate(size, sizeof(Vertex));
+			KC_CORE_ASSERT(allocation.IsValid(), "Batch does not fit in a streaming region!");
+
+			if (allocation.ClosedRegion != invalid_streaming_region)
+				commands.Record(RenderCommands::FenceStreamingRegion{ m_StreamingBuffer.get(), allocation.ClosedRegion });
+			if (allocation.OpenedRegion != invalid_streaming_region)
+				commands.Record(RenderCommands::WaitStreamingRegion{ m_StreamingBuffer.get(), allocation.OpenedRegion });
+
+			commands.Record(RenderCommands::SetVertexBufferData{ m_StreamingBuffer->GetVertexBuffer().get(), allocation.Offset, size, dataOffset + firstVertex * sizeof(Vertex) });
+
+			for (uint32_t slot = 1; slot < m_TextureSlots.GetUsedSlots(); slot++)
+				commands.Record(RenderCommands::BindTexture{ slot, m_TextureSlots.GetTexture(slot) });
+
+			const int32_t baseVertex = static_cast<int32_t>(allocation.Offset / sizeof(Vertex));
+			commands.Record(RenderCommands::DrawElements{ IndexPattern::topology, indexCount, 0, 1, baseVertex });
+
+			m_Stats.DrawCalls++;
+			m_Stats.Primitives += GetPrimitiveCount(IndexPattern::topology, indexCount);
+
+			m_TextureSlots.NextBatch();
+		}
+
+	private:
+		BatchRendererSpecification m_Specification;
+		uint32_t m_MaxIndices = 0;
+
+		/// In submission order, sorted while they are recorded
+		std::vector<Vertex>     m_Vertices;
+		/// Texture renderer id of every primitive, 0 for the white texture
+		std::vector<RendererID> m_Textures;
+
+		RenderQueue      m_Queue;
+		TextureSlotTable m_TextureSlots;
+
+		Ref<VertexArray>     m_VertexArray;
+		Ref<StreamingBuffer> m_StreamingBuffer;
+		Ref<IndexBuffer>     m_IndexBuffer;
+
+		BatchRendererStats m_Stats;
+	};
+
+}
@@ -0,0 +1,171 @@
+#include "kcpch.h"
+#include "Graphics/Core/BufferAllocator.h"
+
+namespace KuchCraft {
+
+	BufferAllocator::BufferAllocator(uint32_t capacity)
+		: m_Capacity(capacity)
+	{
+		AddFreeRange(0, capacity);
+	}
+
+	BufferAllocationID BufferAllocator::Allocate(uint32_t size)
+	{
+		if (size == 0)
+			return invalid_buffer_allocation;
+
+		auto it = m_FreeBySize.lower_bound({ size, 0 });
+		if (it == m_FreeBySize.end())
+			return invalid_buffer_allocation;
+
+		const auto [rangeSize, rangeOffset] = *it;
+		RemoveFreeRange(rangeOffset, rangeSize);
+		if (rangeSize > size)
+			AddFreeRange(rangeOffset + size, rangeSize - size);
+
+		BufferAllocationID id;
+		if (!m_FreeIDs.empty())
+		{
+			id = m_FreeIDs.back();
+			m_FreeIDs.pop_back();
+		}
+		else
+		{
+			id = (BufferAllocationID)m_Allocations.size();
+			m_Allocations.emplace_back();
+		}
+
+		m_Allocations[id] = { rangeOffset, size, true };
+		m_UsedSize += size;
+
+		return id;
+	}
+
+	void BufferAllocator::Free(BufferAllocationID id)
+	{
+		if (!IsValid(id))
+			return;
+
+		Allocation& allocation = m_Allocations[id];
+		uint32_t offset = allocation.Offset;
+		uint32_t size   = allocation.Size;
+
+		m_UsedSize -= size;
+		allocation  = {};
+		m_FreeIDs.push_back(id);
+
+		// Merge with the free range right after
+		auto next = m_FreeByOffset.find(offset + size);
+		if (next != m_FreeByOffset.end())
+		{
+			const uint32_t nextSize = next->second;
+			RemoveFreeRange(offset + size, nextSize);
+			size += nextSize;
+		}
+
+		// Merge with the free range right before
+		auto previous = m_FreeByOffset.lower_bound(offset);
+		if (previous != m_FreeByOffset.begin())
+		{
+			--previous;
+			if (previous->first + previous->second == offset)
+			{
+				const uint32_t previousOffset = previous->first;
+				const uint32_t previousSize   = previous->second;
+				RemoveFreeRange(previousOffset, previousSize);
+				offset  = previousOffset;
+				size   += previousSize;
+			}
+		}
+
+		AddFreeRange(offset, size);
+	}
+
+	std::vector<BufferAllocatorMove> BufferAllocator::Compact()
+	{
+		std::vector<BufferAllocationID> order;
+		order.reserve(m_Allocations.size());
+		for (BufferAllocationID id = 0; id < (BufferAllocationID)m_Allocations.size(); id++)
+		{
+			if (m_Allocations[id].Used)
+				order.push_back(id);
+		}
+
+		std::sort(order.begin(), order.end(), [this](BufferAllocationID a, BufferAllocationID b) {
+			return m_Allocations[a].Offset < m_Allocations[b].Offset;
+		});
+
+		std::vector<BufferAllocatorMove> moves;
+		uint32_t offset = 0;
+		for (BufferAllocationID id : order)
+		{
+			Allocation& allocation = m_Allocations[id];
+			if (allocation.Offset != offset)
+			{
+				moves.push_back({ allocation.Offset, offset, allocation.Size });
+				allocation.Offset = offset;
+			}
+
+			offset += allocation.Size;
+		}
+
+		m_FreeByOffset.clear();
+		m_FreeBySize.clear();
+		AddFreeRange(offset, m_Capacity - offset);
+
+		return moves;
+	}
+
+	void BufferAllocator::Grow(uint32_t capacity)
+	{
+		KC_CORE_ASSERT(capacity >= m_Capacity, "Buffer allocator can not shrink!");
+
+		if (capacity == m_Capacity)
+			return;
+
+		uint32_t offset = m_Capacity;
+		uint32_t size   = capacity - m_Capacity;
+
+		// Extend the free range that ends at the old capacity
+		auto last = m_FreeByOffset.empty() ? m_FreeByOffset.end() : std::prev(m_FreeByOffset.end());
+		if (last != m_FreeByOffset.end() && last->first + last->second == m_Capacity)
+		{
+			const uint32_t lastOffset = last->first;
+			const uint32_t lastSize   = last->second;
+			RemoveFreeRange(lastOffset, lastSize);
+			offset  = lastOffset;
+			size   += lastSize;
+		}
+
+		m_Capacity = capacity;
+		AddFreeRange(offset, size);
+	}
+
+	BufferAllocatorStats BufferAllocator::GetStats() const
+	{
+		BufferAllocatorStats stats;
+		stats.Capacity         = m_Capacity;
+		stats.UsedSize         = m_UsedSize;
+		stats.AllocationCount  = (uint32_t)(m_Allocations.size() - m_FreeIDs.size());
+		stats.FreeRangeCount   = (uint32_t)m_FreeByOffset.size();
+		stats.LargestFreeRange = m_FreeBySize.empty() ? 0 : m_FreeBySize.rbegin()->first;
+
+		return stats;
+	}
+
+	void BufferAllocator::AddFreeRange(uint32_t offset, uint32_t size)
+	{
+		if (size == 0)
+			return;
+
+		m_FreeByOffset.emplace(offset, size);
+		m_FreeBySize.emplace(size, offset);
+	}
+
+	void BufferAllocator::RemoveFreeRange(uint32_t offset, uint32_t size)
+	{
+		m_FreeByOffset.erase(offset);
+		m_FreeBySize.erase({ size, offset });
+	}
+
+}
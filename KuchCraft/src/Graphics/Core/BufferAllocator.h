@@ -0,0 +1,86 @@
+#pragma once
+
+namespace KuchCraft {
+
+	using BufferAllocationID = uint32_t;
+	constexpr BufferAllocationID invalid_buffer_allocation = std::numeric_limits<BufferAllocationID>::max();
+
+	/// Data of one allocation that has to be copied from `Source` to `Destination`
+	struct BufferAllocatorMove
+	{
+		uint32_t Source      = 0;
+		uint32_t Destination = 0;
+		uint32_t Size        = 0;
+	};
+
+	struct BufferAllocatorStats
+	{
+		uint32_t Capacity         = 0;
+		uint32_t UsedSize         = 0;
+		uint32_t AllocationCount  = 0;
+		uint32_t FreeRangeCount   = 0;
+		uint32_t LargestFreeRange = 0;
+
+		/// 0 when all free space is one range, close to 1 when it is split into many small ones
+		float GetFragmentation() const
+		{
+			const uint32_t freeSize = Capacity - UsedSize;
+			return freeSize > 0 ? 1.0f - (float)LargestFreeRange / (float)freeSize : 0.0f;
+		}
+	};
+
+	/// Offset and size sub-allocator for one large GPU buffer, it never touches the buffer itself.
+	/// Allocations take the smallest free range they fit in, freed ranges are merged with free neighbors.
+	/// Offsets and sizes are in whatever unit the owner uses. Not thread safe
+	class BufferAllocator
+	{
+	public:
+		BufferAllocator(uint32_t capacity);
+		~BufferAllocator() = default;
+
+		/// Returns invalid_buffer_allocation for size 0 or when no free range is large enough, see Compact and Grow
+		BufferAllocationID Allocate(uint32_t size);
+		void Free(BufferAllocationID id);
+
+		bool IsValid(BufferAllocationID id) const { return id < m_Allocations.size() && m_Allocations[id].Used; }
+
+		uint32_t GetOffset(BufferAllocationID id) const { return m_Allocations[id].Offset; }
+		uint32_t GetSize(BufferAllocationID id)   const { return m_Allocations[id].Size;   }
+
+		/// Packs every allocation to the start of the buffer, keeping their order and ids.
+		/// Returns moves in ascending order of offsets, ranges of one move may overlap so the owner should copy through another buffer
+		std::vector<BufferAllocatorMove> Compact();
+
+		/// Adds free space at the end, `capacity` can not be smaller than the current one
+		void Grow(uint32_t capacity);
+
+		uint32_t GetCapacity() const { return m_Capacity; }
+		uint32_t GetUsedSize() const { return m_UsedSize; }
+		uint32_t GetFreeSize() const { return m_Capacity - m_UsedSize; }
+
+		BufferAllocatorStats GetStats() const;
+
+	private:
+		void AddFreeRange(uint32_t offset, uint32_t size);
+		void RemoveFreeRange(uint32_t offset, uint32_t size);
+
+	private:
+		struct Allocation
+		{
+			uint32_t Offset = 0;
+			uint32_t Size   = 0;
+			bool     Used   = false;
+		};
+
+		uint32_t m_Capacity = 0;
+		uint32_t m_UsedSize = 0;
+
+		/// Free ranges as offset -> size, and the same ranges ordered by size for best fit
+		std::map<uint32_t, uint32_t>            m_FreeByOffset;
+		std::set<std::pair<uint32_t, uint32_t>> m_FreeBySize;
+
+		std::vector<Allocation>         m_Allocations;
+		std::vector<BufferAllocationID> m_FreeIDs;
+	};
+
+}
@@ -0,0 +1,151 @@
+#include "kcpch.h"
+#include "Graphics/Core/Frustum.h"
+
+#if defined(__AVX2__) || defined(__SSE4_1__)
+	#include <immintrin.h>
+	#define KC_FRUSTUM_SSE41
+#endif
+
+namespace KuchCraft {
+
+	Frustum::Frustum(const glm::mat4& viewProjection)
+	{
+		/// Rows of the matrix combined as clip space -w <= x, y, z <= w requires
+		const glm::vec4 rowX = glm::row(viewProjection, 0);
+		const glm::vec4 rowY = glm::row(viewProjection, 1);
+		const glm::vec4 rowZ = glm::row(viewProjection, 2);
+		const glm::vec4 rowW = glm::row(viewProjection, 3);
+
+		m_Planes[0] = rowW + rowX;
+		m_Planes[1] = rowW - rowX;
+		m_Planes[2] = rowW + rowY;
+		m_Planes[3] = rowW - rowY;
+		m_Planes[4] = rowW + rowZ;
+		m_Planes[5] = rowW - rowZ;
+
+		for (auto& plane : m_Planes)
+		{
+			const float length = glm::length(glm::vec3(plane));
+			if (length > 0.0f)
+				plane /= length;
+		}
+	}
+
+	bool Frustum::IntersectsAABB(const glm::vec3& min, const glm::vec3& max) const
+	{
+		for (const auto& plane : m_Planes)
+		{
+			/// Corner of the box furthest along the plane normal
+			const glm::vec3 corner = {
+				plane.x >= 0.0f ? max.x : min.x,
+				plane.y >= 0.0f ? max.y : min.y,
+				plane.z >= 0.0f ? max.z : min.z
+			};
+
+			if (glm::dot(glm::vec3(plane), corner) + plane.w < 0.0f)
+				return false;
+		}
+
+		return true;
+	}
+
+	void FrustumCuller::Clear()
+	{
+		m_CenterX.clear(); m_CenterY.clear(); m_CenterZ.clear();
+		m_ExtentX.clear(); m_ExtentY.clear(); m_ExtentZ.clear();
+	}
+
+	void FrustumCuller::Reserve(size_t count)
+	{
+		m_CenterX.reserve(count); m_CenterY.reserve(count); m_CenterZ.reserve(count);
+		m_ExtentX.reserve(count); m_ExtentY.reserve(count); m_ExtentZ.reserve(count);
+	}
+
+	uint32_t FrustumCuller::Add(const glm::vec3& min, const glm::vec3& max)
+	{
+		const glm::vec3 center = (min + max) * 0.5f;
+		const glm::vec3 extent = (max - min) * 0.5f;
+
+		m_CenterX.push_back(center.x); m_CenterY.push_back(center.y); m_CenterZ.push_back(center.z);
+		m_ExtentX.push_back(extent.x); m_ExtentY.push_back(extent.y); m_ExtentZ.push_back(extent.z);
+
+		return GetCount() - 1;
+	}
+
+	uint32_t FrustumCuller::Cull(const Frustum& frustum, std::vector<uint8_t>& visible) const
+	{
+		const size_t count = m_CenterX.size();
+		visible.assign(count, 1);
+
+		const float* centerX = m_CenterX.data();
+		const float* centerY = m_CenterY.data();
+		const float* centerZ = m_CenterZ.data();
+		const float* extentX = m_ExtentX.data();
+		const float* extentY = m_ExtentY.data();
+		const float* extentZ = m_ExtentZ.data();
+		uint8_t*     result  = visible.data();
+
+		const auto& planes = frustum.GetPlanes();
+		size_t i = 0;
+
+#if defined(KC_FRUSTUM_SSE41)
+		/// Four boxes per iteration, they stay in registers while all planes are tested
+		__m128 planeX[6], planeY[6], planeZ[6], planeW[6], absX[6], absY[6], absZ[6];
+		const __m128 signMask = _mm_set1_ps(-0.0f);
+		for (size_t p = 0; p < planes.size(); p++)
+		{
+			planeX[p] = _mm_set1_ps(planes[p].x);
+			planeY[p] = _mm_set1_ps(planes[p].y);
+			planeZ[p] = _mm_set1_ps(planes[p].z);
+			planeW[p] = _mm_set1_ps(planes[p].w);
+			absX[p]   = _mm_andnot_ps(signMask, planeX[p]);
+			absY[p]   = _mm_andnot_ps(signMask, planeY[p]);
+			absZ[p]   = _mm_andnot_ps(signMask, planeZ[p]);
+		}
+
+		const __m128 zero = _mm_setzero_ps();
+		for (; i + 4 <= count; i += 4)
+		{
+			const __m128 cx = _mm_loadu_ps(centerX + i), cy = _mm_loadu_ps(centerY + i), cz = _mm_loadu_ps(centerZ + i);
+			const __m128 ex = _mm_loadu_ps(extentX + i), ey = _mm_loadu_ps(extentY + i), ez = _mm_loadu_ps(extentZ + i);
+
+			__m128 inside = _mm_cmpeq_ps(zero, zero);
+			for (size_t p = 0; p < planes.size(); p++)
+			{
+				/// Same order of operations as the scalar loop, so both give the same results
+				const __m128 distance = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(planeX[p], cx), _mm_mul_ps(planeY[p], cy)), _mm_mul_ps(planeZ[p], cz)), planeW[p]);
+				const __m128 radius   = _mm_add_ps(_mm_add_ps(_mm_mul_ps(absX[p], ex), _mm_mul_ps(absY[p], ey)), _mm_mul_ps(absZ[p], ez));
+				inside = _mm_and_ps(inside, _mm_cmpge_ps(_mm_add_ps(distance, radius), zero));
+			}
+
+			const int mask = _mm_movemask_ps(inside);
+			result[i + 0] = static_cast<uint8_t>( mask       & 1);
+			result[i + 1] = static_cast<uint8_t>((mask >> 1) & 1);
+			result[i + 2] = static_cast<uint8_t>((mask >> 2) & 1);
+			result[i + 3] = static_cast<uint8_t>((mask >> 3) & 1);
+		}
+#endif
+
+		/// Boxes left over by the SIMD loop, or all of them without SSE4.1
+		for (const auto& plane : planes)
+		{
+			const float nx = plane.x, ny = plane.y, nz = plane.z, w = plane.w;
+			const float ax = std::abs(nx), ay = std::abs(ny), az = std::abs(nz);
+
+			/// Signed distance of the center plus the box radius projected on the normal
+			for (size_t j = i; j < count; j++)
+			{
+				const float distance = nx * centerX[j] + ny * centerY[j] + nz * centerZ[j] + w;
+				const float radius   = ax * extentX[j] + ay * extentY[j] + az * extentZ[j];
+				result[j] &= static_cast<uint8_t>(distance + radius >= 0.0f);
+			}
+		}
+
+		uint32_t visibleCount = 0;
+		for (size_t i = 0; i < count; i++)
+			visibleCount += result[i];
+
+		return visibleCount;
+	}
+
+}
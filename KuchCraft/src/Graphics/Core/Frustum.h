@@ -0,0 +1,47 @@
+#pragma once
+
+namespace KuchCraft {
+
+	/// Left, right, bottom, top, near and far plane of a view projection, normals point inside.
+	/// A point is inside when dot(plane.xyz, point) + plane.w >= 0 for every plane
+	class Frustum
+	{
+	public:
+		Frustum() = default;
+		Frustum(const glm::mat4& viewProjection);
+
+		/// False only when the box is fully outside of one plane, boxes near frustum corners may pass
+		bool IntersectsAABB(const glm::vec3& min, const glm::vec3& max) const;
+
+		const std::array<glm::vec4, 6>& GetPlanes() const { return m_Planes; }
+
+	private:
+		/// Default frustum lets everything through
+		std::array<glm::vec4, 6> m_Planes = {
+			glm::vec4(0.0f, 0.0f, 0.0f, 1.0f), glm::vec4(0.0f, 0.0f, 0.0f, 1.0f), glm::vec4(0.0f, 0.0f, 0.0f, 1.0f),
+			glm::vec4(0.0f, 0.0f, 0.0f, 1.0f), glm::vec4(0.0f, 0.0f, 0.0f, 1.0f), glm::vec4(0.0f, 0.0f, 0.0f, 1.0f)
+		};
+	};
+
+	/// Axis aligned boxes stored as separate arrays of centers and half extents, tested against a Frustum all at once.
+	/// With SSE4.1 four boxes are tested against all planes at once, other builds loop over one plane at a time without branches
+	class FrustumCuller
+	{
+	public:
+		void Clear();
+		void Reserve(size_t count);
+
+		/// Returns index of the box
+		uint32_t Add(const glm::vec3& min, const glm::vec3& max);
+
+		/// Sets `visible[i]` to 1 for every box that intersects `frustum` and 0 otherwise. Returns number of visible boxes
+		uint32_t Cull(const Frustum& frustum, std::vector<uint8_t>& visible) const;
+
+		uint32_t GetCount() const { return static_cast<uint32_t>(m_CenterX.size()); }
+
+	private:
+		std::vector<float> m_CenterX, m_CenterY, m_CenterZ;
+		std::vector<float> m_ExtentX, m_ExtentY, m_ExtentZ;
+	};
+
+}
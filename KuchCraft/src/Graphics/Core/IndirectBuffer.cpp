@@ -0,0 +1,66 @@
+#include "kcpch.h"
+#include "Graphics/Core/IndirectBuffer.h"
+
+#include <glad/glad.h>
+
+namespace KuchCraft {
+
+	IndirectBuffer::IndirectBuffer(size_t size)
+		: m_Size(size)
+	{
+		KC_CORE_ASSERT(size > 0, "IndirectBuffer size must be greater than 0.");
+
+		glCreateBuffers(1, &m_RendererID);
+		glNamedBufferData(m_RendererID, m_Size, nullptr, GL_DYNAMIC_DRAW);
+
+		KC_CORE_ASSERT(IsValid(), "Failed to create IndirectBuffer!");
+	}
+
+	IndirectBuffer::~IndirectBuffer()
+	{
+		if (IsValid())
+			glDeleteBuffers(1, &m_RendererID);
+	}
+
+	Ref<IndirectBuffer> IndirectBuffer::Create(size_t size)
+	{
+		return Ref<IndirectBuffer>(new IndirectBuffer(size));
+	}
+
+	void IndirectBuffer::SetData(const void* data, size_t size)
+	{
+		KC_CORE_ASSERT(IsValid(), "IndirectBuffer is not valid.");
+
+		if (size == 0)
+			return;
+
+		if (size > m_Size)
+		{
+			m_Size = std::max(size, m_Size * 2);
+			glNamedBufferData(m_RendererID, m_Size, nullptr, GL_DYNAMIC_DRAW);
+		}
+
+		glNamedBufferSubData(m_RendererID, 0, size, data);
+	}
+
+	void IndirectBuffer::Bind() const
+	{
+		glBindBuffer(GL_DRAW_INDIRECT_BUFFER, m_RendererID);
+	}
+
+	void IndirectBuffer::Unbind() const
+	{
+		glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+	}
+
+	void IndirectBuffer::SetDebugName(const std::string& name)
+	{
+		KC_CORE_ASSERT(IsValid(), "IndirectBuffer is not valid.");
+		KC_CORE_ASSERT(!name.empty(), "IndirectBuffer debug name must not be empty.");
+
+		m_DebugName = name;
+		if (GLAD_GL_KHR_debug)
+			glObjectLabel(GL_BUFFER, m_RendererID, static_cast<GLsizei>(name.length()), name.c_str());
+	}
+
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+namespace KuchCraft {
+
+	/// Same layout as OpenGL reads for glDrawArraysIndirect and glMultiDrawArraysIndirect
+	struct DrawArraysIndirectCommand
+	{
+		uint32_t Count         = 0;
+		uint32_t InstanceCount = 0;
+		uint32_t First         = 0;
+		uint32_t BaseInstance  = 0;
+	};
+
+	static_assert(sizeof(DrawArraysIndirectCommand) == 4 * sizeof(uint32_t), "Indirect commands must be tightly packed!");
+
+	/// Draw commands read by indirect draw calls, offsets passed to them are in bytes from the start of this buffer
+	class IndirectBuffer
+	{
+	public:
+		~IndirectBuffer();
+
+		static Ref<IndirectBuffer> Create(size_t size);
+
+		/// Reallocates the buffer when `size` does not fit
+		void SetData(const void* data, size_t size);
+
+		void Bind() const;
+		void Unbind() const;
+
+		bool IsValid() const { return m_RendererID != 0; }
+
+		size_t GetSize() const { return m_Size; }
+		RendererID GetRendererID() const { return m_RendererID; }
+
+		void SetDebugName(const std::string& name);
+		const std::string& GetDebugName() const { return m_DebugName; }
+
+	private:
+		std::string m_DebugName  = "UnnamedIndirectBuffer";
+		RendererID  m_RendererID = 0;
+		size_t      m_Size       = 0;
+
+		IndirectBuffer(size_t size);
+
+		KC_DISALLOW_COPY(IndirectBuffer);
+		KC_DISALLOW_MOVE(IndirectBuffer);
+	};
+
+}
@@ -0,0 +1,319 @@
+#include "kcpch.h"
+#include "Graphics/Core/OpenGLRenderBackend.h"
+
+#include "Graphics/Core/FrameBuffer.h"
+#include "Graphics/Core/VertexBuffer.h"
+#include "Graphics/Core/UniformBuffer.h"
+#include "Graphics/Core/StorageBuffer.h"
+#include "Graphics/Core/IndirectBuffer.h"
+#include "Graphics/Core/StreamingBuffer.h"
+
+#include <glad/glad.h>
+
+namespace KuchCraft {
+
+	static GLenum ToOpenGLPrimitive(PrimitiveTopology topology)
+	{
+		switch (topology)
+		{
+			case PrimitiveTopology::Points:             return GL_POINTS;
+			case PrimitiveTopology::Lines:              return GL_LINES;
+			case PrimitiveTopology::LineStrip:          return GL_LINE_STRIP;
+			case PrimitiveTopology::Triangles:          return GL_TRIANGLES;
+			case PrimitiveTopology::TriangleStrip:      return GL_TRIANGLE_STRIP;
+			case PrimitiveTopology::TriangleFan:        return GL_TRIANGLE_FAN;
+			case PrimitiveTopology::LinesAdjacency:     return GL_LINES_ADJACENCY;
+			case PrimitiveTopology::TrianglesAdjacency: return GL_TRIANGLES_ADJACENCY;
+			case PrimitiveTopology::Patches:            return GL_PATCHES;
+			default:
+				KC_CORE_ERROR("Unknown PrimitiveTopology: {}", static_cast<int>(topology));
+				return GL_TRIANGLES;
+		}
+	}
+
+	static GLenum ToOpenGLBlendFunc(BlendFunc func)
+	{
+		switch (func)
+		{
+			case BlendFunc::Zero:             return GL_ZERO;
+			case BlendFunc::One:              return GL_ONE;
+			case BlendFunc::SrcAlpha:         return GL_SRC_ALPHA;
+			case BlendFunc::OneMinusSrcAlpha: return GL_ONE_MINUS_SRC_ALPHA;
+		}
+
+		return GL_ONE;
+	}
+
+	static GLenum ToOpenGLPolygonMode(PolygonMode mode)
+	{
+		switch (mode)
+		{
+			case PolygonMode::Fill:  return GL_FILL;
+			case PolygonMode::Line:  return GL_LINE;
+			case PolygonMode::Point: return GL_POINT;
+		}
+
+		return GL_FILL;
+	}
+
+	static GLenum ToOpenGLDepthFunc(DepthFunc func)
+	{
+		switch (func)
+		{
+			case DepthFunc::Never:        return GL_NEVER;
+			case DepthFunc::Less:         return GL_LESS;
+			case DepthFunc::Equal:        return GL_EQUAL;
+			case DepthFunc::LessEqual:    return GL_LEQUAL;
+			case DepthFunc::Greater:      return GL_GREATER;
+			case DepthFunc::NotEqual:     return GL_NOTEQUAL;
+			case DepthFunc::GreaterEqual: return GL_GEQUAL;
+			case DepthFunc::Always:       return GL_ALWAYS;
+		}
+
+		return GL_LEQUAL;
+	}
+
+	static GLenum ToOpenGLCullMode(CullMode mode)
+	{
+		switch (mode)
+		{
+			case CullMode::Front:        return GL_FRONT;
+			case CullMode::Back:         return GL_BACK;
+			case CullMode::FrontAndBack: return GL_FRONT_AND_BACK;
+		}
+
+		return GL_BACK;
+	}
+
+	static void SetCapability(GLenum capability, bool enabled)
+	{
+		if (enabled)
+			glEnable(capability);
+		else
+			glDisable(capability);
+	}
+
+	void OpenGLRenderBackend::Execute(const RenderCommandBuffer& commands)
+	{
+		using namespace RenderCommands;
+
+		commands.ForEach([&commands](RenderCommandType type, const void* payload) {
+			switch (type)
+			{
+				case RenderCommandType::BindFrameBuffer:
+				{
+					const auto command = RenderCommandBuffer::Read<BindFrameBuffer>(payload);
+					glBindFramebuffer(GL_FRAMEBUFFER, command.FrameBuffer);
+					if (command.Width > 0 && command.Height > 0)
+						glViewport(0, 0, command.Width, command.Height);
+					break;
+				}
+				case RenderCommandType::Clear:
+				{
+					const auto command = RenderCommandBuffer::Read<Clear>(payload);
+					glClearColor(command.Color.r, command.Color.g, command.Color.b, command.Color.a);
+					glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT | GL_STENCIL_BUFFER_BIT);
+					break;
+				}
+				case RenderCommandType::ClearFrameBuffer:
+				{
+					RenderCommandBuffer::Read<ClearFrameBuffer>(payload).FrameBuffer->ClearAttachments();
+					break;
+				}
+				case RenderCommandType::BlitFrameBufferToDefault:
+				{
+					const auto command = RenderCommandBuffer::Read<BlitFrameBufferToDefault>(payload);
+					command.FrameBuffer->BlitToDefault(command.Mask, command.Filter);
+					break;
+				}
+
+				case RenderCommandType::SetPolygonMode:
+				{
+					glPolygonMode(GL_FRONT_AND_BACK, ToOpenGLPolygonMode(RenderCommandBuffer::Read<SetPolygonMode>(payload).Mode));
+					break;
+				}
+				case RenderCommandType::SetFrontFaceWinding:
+				{
+					glFrontFace(RenderCommandBuffer::Read<SetFrontFaceWinding>(payload).Winding == FaceWinding::Clockwise ? GL_CW : GL_CCW);
+					break;
+				}
+				case RenderCommandType::SetDepthTest:
+				{
+					SetCapability(GL_DEPTH_TEST, RenderCommandBuffer::Read<SetDepthTest>(payload).Enabled);
+					break;
+				}
+				case RenderCommandType::SetDepthWrite:
+				{
+					glDepthMask(RenderCommandBuffer::Read<SetDepthWrite>(payload).Enabled ? GL_TRUE : GL_FALSE);
+					break;
+				}
+				case RenderCommandType::SetDepthFunc:
+				{
+					glDepthFunc(ToOpenGLDepthFunc(RenderCommandBuffer::Read<SetDepthFunc>(payload).Func));
+					break;
+				}
+				case RenderCommandType::SetBlend:
+				{
+					SetCapability(GL_BLEND, RenderCommandBuffer::Read<SetBlend>(payload).Enabled);
+					break;
+				}
+				case RenderCommandType::SetBlendFunc:
+				{
+					const auto command = RenderCommandBuffer::Read<SetBlendFunc>(payload);
+					glBlendFunc(ToOpenGLBlendFunc(command.Src), ToOpenGLBlendFunc(command.Dst));
+					glBlendEquation(GL_FUNC_ADD);
+					break;
+				}
+				case RenderCommandType::SetCullFace:
+				{
+					SetCapability(GL_CULL_FACE, RenderCommandBuffer::Read<SetCullFace>(payload).Enabled);
+					break;
+				}
+				case RenderCommandType::SetCullMode:
+				{
+					glCullFace(ToOpenGLCullMode(RenderCommandBuffer::Read<SetCullMode>(payload).Mode));
+					break;
+				}
+				case RenderCommandType::SetPolygonOffset:
+				{
+					const auto command = RenderCommandBuffer::Read<SetPolygonOffset>(payload);
+					SetCapability(GL_POLYGON_OFFSET_FILL, command.Enabled);
+					if (command.Enabled)
+						glPolygonOffset(command.Factor, command.Units);
+					break;
+				}
+
+				case RenderCommandType::BindShader:
+				{
+					glUseProgram(RenderCommandBuffer::Read<BindShader>(payload).Shader);
+					break;
+				}
+				case RenderCommandType::BindVertexArray:
+				{
+					glBindVertexArray(RenderCommandBuffer::Read<BindVertexArray>(payload).VertexArray);
+					break;
+				}
+				case RenderCommandType::BindTexture:
+				{
+					const auto command = RenderCommandBuffer::Read<BindTexture>(payload);
+					glBindTextureUnit(command.Slot, command.Texture);
+					break;
+				}
+				case RenderCommandType::BindIndirectBuffer:
+				{
+					glBindBuffer(GL_DRAW_INDIRECT_BUFFER, RenderCommandBuffer::Read<BindIndirectBuffer>(payload).Buffer);
+					break;
+				}
+				case RenderCommandType::SetUniformInt:
+				{
+					const auto command = RenderCommandBuffer::Read<SetUniformInt>(payload);
+					if (command.Location != -1)
+						glProgramUniform1i(command.Shader, command.Location, command.Value);
+					break;
+				}
+
+				case RenderCommandType::SetVertexBufferData:
+				{
+					const auto command = RenderCommandBuffer::Read<SetVertexBufferData>(payload);
+					command.Buffer->SetData(commands.GetData(command.DataOffset), command.Size, command.Offset);
+					break;
+				}
+				case RenderCommandType::SetUniformBufferData:
+				{
+					const auto command = RenderCommandBuffer::Read<SetUniformBufferData>(payload);
+					command.Buffer->SetData(commands.GetData(command.DataOffset), command.Size, static_cast<uint32_t>(command.Offset));
+					break;
+				}
+				case RenderCommandType::SetStorageBufferData:
+				{
+					const auto command = RenderCommandBuffer::Read<SetStorageBufferData>(payload);
+					command.Buffer->SetData(commands.GetData(command.DataOffset), command.Size);
+					break;
+				}
+				case RenderCommandType::SetIndirectBufferData:
+				{
+					const auto command = RenderCommandBuffer::Read<SetIndirectBufferData>(payload);
+					command.Buffer->SetData(commands.GetData(command.DataOffset), command.Size);
+					break;
+				}
+				case RenderCommandType::WaitStreamingRegion:
+				{
+					const auto command = RenderCommandBuffer::Read<WaitStreamingRegion>(payload);
+					command.Buffer->WaitRegion(command.Region);
+					break;
+				}
+				case RenderCommandType::FenceStreamingRegion:
+				{
+					const auto command = RenderCommandBuffer::Read<FenceStreamingRegion>(payload);
+					command.Buffer->FenceRegion(command.Region);
+					break;
+				}
+
+				case RenderCommandType::DrawArrays:
+				{
+					const auto command = RenderCommandBuffer::Read<DrawArrays>(payload);
+					if (command.InstanceCount == 1 && command.BaseInstance == 0)
+						glDrawArrays(ToOpenGLPrimitive(command.Topology), command.First, command.Count);
+					else
+						glDrawArraysInstancedBaseInstance(ToOpenGLPrimitive(command.Topology), command.First, command.Count, command.InstanceCount, command.BaseInstance);
+					break;
+				}
+				case RenderCommandType::DrawElements:
+				{
+					const auto command = RenderCommandBuffer::Read<DrawElements>(payload);
+					const void* indices = reinterpret_cast<const void*>(sizeof(uint32_t) * static_cast<size_t>(command.FirstIndex));
+					if (command.InstanceCount == 1 && command.BaseVertex == 0 && command.BaseInstance == 0)
+						glDrawElements(ToOpenGLPrimitive(command.Topology), command.Count, GL_UNSIGNED_INT, indices);
+					else
+						glDrawElementsInstancedBaseVertexBaseInstance(ToOpenGLPrimitive(command.Topology), command.Count, GL_UNSIGNED_INT, indices,
+							command.InstanceCount, command.BaseVertex, command.BaseInstance);
+					break;
+				}
+				case RenderCommandType::DrawRangeElements:
+				{
+					const auto command = RenderCommandBuffer::Read<DrawRangeElements>(payload);
+					glDrawRangeElements(ToOpenGLPrimitive(command.Topology), command.Start, command.End, command.Count, GL_UNSIGNED_INT, nullptr);
+					break;
+				}
+				case RenderCommandType::MultiDrawArrays:
+				{
+					const auto command = RenderCommandBuffer::Read<MultiDrawArrays>(payload);
+					const GLint*   firsts = reinterpret_cast<const GLint*>(commands.GetData(command.DataOffset));
+					const GLsizei* counts = reinterpret_cast<const GLsizei*>(commands.GetData(command.DataOffset + RenderCommandBuffer::GetAlignedSize(sizeof(GLint) * command.DrawCount)));
+					glMultiDrawArrays(ToOpenGLPrimitive(command.Topology), firsts, counts, static_cast<GLsizei>(command.DrawCount));
+					break;
+				}
+				case RenderCommandType::MultiDrawElements:
+				{
+					const auto command = RenderCommandBuffer::Read<MultiDrawElements>(payload);
+					const GLsizei* counts = reinterpret_cast<const GLsizei*>(commands.GetData(command.DataOffset));
+					const uint64_t* byteOffsets = reinterpret_cast<const uint64_t*>(commands.GetData(command.DataOffset + RenderCommandBuffer::GetAlignedSize(sizeof(GLsizei) * command.DrawCount)));
+
+					std::vector<const void*> offsets(command.DrawCount);
+					for (uint32_t i = 0; i < command.DrawCount; i++)
+						offsets[i] = reinterpret_cast<const void*>(byteOffsets[i]);
+
+					glMultiDrawElements(ToOpenGLPrimitive(command.Topology), counts, GL_UNSIGNED_INT, offsets.data(), static_cast<GLsizei>(command.DrawCount));
+					break;
+				}
+				case RenderCommandType::DrawIndirect:
+				{
+					const auto command = RenderCommandBuffer::Read<DrawIndirect>(payload);
+					const void* indirect = reinterpret_cast<const void*>(command.Offset);
+					if (command.Indexed)
+						glMultiDrawElementsIndirect(ToOpenGLPrimitive(command.Topology), GL_UNSIGNED_INT, indirect, static_cast<GLsizei>(command.DrawCount), 0);
+					else
+						glMultiDrawArraysIndirect(ToOpenGLPrimitive(command.Topology), indirect, static_cast<GLsizei>(command.DrawCount), 0);
+					break;
+				}
+
+				default:
+				{
+					KC_CORE_ERROR("Unknown render command: {}", static_cast<int>(type));
+					break;
+				}
+			}
+		});
+	}
+
+}
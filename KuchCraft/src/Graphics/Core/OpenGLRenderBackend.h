@@ -0,0 +1,14 @@
+#pragma once
+
+#include "Graphics/Core/RenderBackend.h"
+
+namespace KuchCraft {
+
+	/// Replays commands with OpenGL calls, has to run on the thread that owns the context
+	class OpenGLRenderBackend : public RenderBackend
+	{
+	public:
+		virtual void Execute(const RenderCommandBuffer& commands) override;
+	};
+
+}
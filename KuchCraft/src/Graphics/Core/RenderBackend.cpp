@@ -0,0 +1,50 @@
+#include "kcpch.h"
+#include "Graphics/Core/RenderBackend.h"
+
+namespace KuchCraft {
+
+	void NullRenderBackend::Execute(const RenderCommandBuffer& commands)
+	{
+		commands.ForEach([this](RenderCommandType type, const void* payload) {
+			m_Counts[static_cast<size_t>(type)]++;
+			m_CommandCount++;
+
+			switch (type)
+			{
+				case RenderCommandType::DrawArrays:
+				case RenderCommandType::DrawElements:
+				case RenderCommandType::DrawRangeElements:
+				case RenderCommandType::MultiDrawArrays:
+				case RenderCommandType::MultiDrawElements:
+				case RenderCommandType::DrawIndirect:
+					m_DrawCount++;
+					break;
+
+				case RenderCommandType::SetVertexBufferData:
+					m_UploadSize += RenderCommandBuffer::Read<RenderCommands::SetVertexBufferData>(payload).Size;
+					break;
+				case RenderCommandType::SetUniformBufferData:
+					m_UploadSize += RenderCommandBuffer::Read<RenderCommands::SetUniformBufferData>(payload).Size;
+					break;
+				case RenderCommandType::SetStorageBufferData:
+					m_UploadSize += RenderCommandBuffer::Read<RenderCommands::SetStorageBufferData>(payload).Size;
+					break;
+				case RenderCommandType::SetIndirectBufferData:
+					m_UploadSize += RenderCommandBuffer::Read<RenderCommands::SetIndirectBufferData>(payload).Size;
+					break;
+
+				default:
+					break;
+			}
+		});
+	}
+
+	void NullRenderBackend::Reset()
+	{
+		m_Counts.fill(0);
+		m_CommandCount = 0;
+		m_DrawCount    = 0;
+		m_UploadSize   = 0;
+	}
+
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include "Graphics/Core/RenderCommandBuffer.h"
+
+namespace KuchCraft {
+
+	/// Executes recorded commands, the renderer records a frame and hands it to its backend once
+	class RenderBackend
+	{
+	public:
+		virtual ~RenderBackend() = default;
+
+		virtual void Execute(const RenderCommandBuffer& commands) = 0;
+	};
+
+	/// Does not draw anything, only counts executed commands. Lets renderer logic run without an OpenGL context
+	class NullRenderBackend : public RenderBackend
+	{
+	public:
+		virtual void Execute(const RenderCommandBuffer& commands) override;
+
+		uint64_t GetCount(RenderCommandType type) const { return m_Counts[static_cast<size_t>(type)]; }
+		uint64_t GetCommandCount() const { return m_CommandCount; }
+		/// Draw commands of any kind, a multi draw counts once
+		uint64_t GetDrawCount()    const { return m_DrawCount; }
+		/// Bytes of buffer data the commands would upload
+		uint64_t GetUploadSize()   const { return m_UploadSize; }
+
+		void Reset();
+
+	private:
+		std::array<uint64_t, render_command_type_count> m_Counts = {};
+		uint64_t m_CommandCount = 0;
+		uint64_t m_DrawCount    = 0;
+		uint64_t m_UploadSize   = 0;
+	};
+
+}
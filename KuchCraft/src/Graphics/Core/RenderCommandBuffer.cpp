@@ -0,0 +1,32 @@
+#include "kcpch.h"
+#include "Graphics/Core/RenderCommandBuffer.h"
+
+namespace KuchCraft {
+
+	uint64_t RenderCommandBuffer::RecordData(const void* data, size_t size)
+	{
+		const size_t offset = m_Data.size();
+		const uint8_t* bytes = static_cast<const uint8_t*>(data);
+
+		m_Data.insert(m_Data.end(), bytes, bytes + size);
+		m_Data.resize(offset + GetAlignedSize(size));
+
+		return offset;
+	}
+
+	uint64_t RenderCommandBuffer::ReserveData(size_t size)
+	{
+		const size_t offset = m_Data.size();
+		m_Data.resize(offset + GetAlignedSize(size));
+
+		return offset;
+	}
+
+	void RenderCommandBuffer::Clear()
+	{
+		m_Commands.clear();
+		m_Data.clear();
+		m_CommandCount = 0;
+	}
+
+}
@@ -0,0 +1,170 @@
+#pragma once
+
+#include "Graphics/Core/TextureTypes.h"
+
+namespace KuchCraft {
+
+	class FrameBuffer;
+	class VertexBuffer;
+	class UniformBuffer;
+	class StorageBuffer;
+	class IndirectBuffer;
+	class StreamingBuffer;
+
+	enum class FrameBufferBlitMask : uint32_t;
+
+	enum class RenderCommandType : uint8_t
+	{
+		BindFrameBuffer = 0, Clear, ClearFrameBuffer, BlitFrameBufferToDefault,
+
+		SetPolygonMode, SetFrontFaceWinding, SetDepthTest, SetDepthWrite, SetDepthFunc,
+		SetBlend, SetBlendFunc, SetCullFace, SetCullMode, SetPolygonOffset,
+
+		BindShader, BindVertexArray, BindTexture, BindIndirectBuffer, SetUniformInt,
+
+		SetVertexBufferData, SetUniformBufferData, SetStorageBufferData, SetIndirectBufferData,
+		WaitStreamingRegion, FenceStreamingRegion,
+
+		DrawArrays, DrawElements, DrawRangeElements, MultiDrawArrays, MultiDrawElements, DrawIndirect,
+
+		Count
+	};
+
+	constexpr size_t render_command_type_count = static_cast<size_t>(RenderCommandType::Count);
+
+	/// Payloads of every command, plain data only. Objects are referenced by renderer id, or by pointer when the
+	/// backend needs more than the id, those objects must outlive execution of the buffer.
+	/// Arrays and buffer contents are copied to the data block of the command buffer, `DataOffset` points there
+	namespace RenderCommands {
+
+		/// Width and height of 0 keep the viewport
+		struct BindFrameBuffer          { static constexpr RenderCommandType type = RenderCommandType::BindFrameBuffer;          RendererID FrameBuffer = 0; uint32_t Width = 0, Height = 0; };
+		/// Color, depth and stencil of the bound frame buffer
+		struct Clear                    { static constexpr RenderCommandType type = RenderCommandType::Clear;                    glm::vec4 Color = glm::vec4(0.0f); };
+		/// Every attachment with the clear values of its specification
+		struct ClearFrameBuffer         { static constexpr RenderCommandType type = RenderCommandType::ClearFrameBuffer;         KuchCraft::FrameBuffer* FrameBuffer = nullptr; };
+		struct BlitFrameBufferToDefault { static constexpr RenderCommandType type = RenderCommandType::BlitFrameBufferToDefault; const KuchCraft::FrameBuffer* FrameBuffer = nullptr; FrameBufferBlitMask Mask; TextureFilter Filter; };
+
+		struct SetPolygonMode      { static constexpr RenderCommandType type = RenderCommandType::SetPolygonMode;      PolygonMode Mode; };
+		struct SetFrontFaceWinding { static constexpr RenderCommandType type = RenderCommandType::SetFrontFaceWinding; FaceWinding Winding; };
+		struct SetDepthTest        { static constexpr RenderCommandType type = RenderCommandType::SetDepthTest;        bool Enabled = false; };
+		struct SetDepthWrite       { static constexpr RenderCommandType type = RenderCommandType::SetDepthWrite;       bool Enabled = false; };
+		struct SetDepthFunc        { static constexpr RenderCommandType type = RenderCommandType::SetDepthFunc;        DepthFunc Func; };
+		struct SetBlend            { static constexpr RenderCommandType type = RenderCommandType::SetBlend;            bool Enabled = false; };
+		struct SetBlendFunc        { static constexpr RenderCommandType type = RenderCommandType::SetBlendFunc;        BlendFunc Src, Dst; };
+		struct SetCullFace         { static constexpr RenderCommandType type = RenderCommandType::SetCullFace;         bool Enabled = false; };
+		struct SetCullMode         { static constexpr RenderCommandType type = RenderCommandType::SetCullMode;         CullMode Mode; };
+		struct SetPolygonOffset    { static constexpr RenderCommandType type = RenderCommandType::SetPolygonOffset;    bool Enabled = false; float Factor = 0.0f, Units = 0.0f; };
+
+		struct BindShader         { static constexpr RenderCommandType type = RenderCommandType::BindShader;         RendererID Shader = 0; };
+		struct BindVertexArray    { static constexpr RenderCommandType type = RenderCommandType::BindVertexArray;    RendererID VertexArray = 0; };
+		struct BindTexture        { static constexpr RenderCommandType type = RenderCommandType::BindTexture;        uint32_t Slot = 0; RendererID Texture = 0; };
+		/// 0 unbinds
+		struct BindIndirectBuffer { static constexpr RenderCommandType type = RenderCommandType::BindIndirectBuffer; RendererID Buffer = 0; };
+		/// Location -1 is skipped, like a missing uniform
+		struct SetUniformInt      { static constexpr RenderCommandType type = RenderCommandType::SetUniformInt;      RendererID Shader = 0; int Location = -1; int Value = 0; };
+
+		struct SetVertexBufferData   { static constexpr RenderCommandType type = RenderCommandType::SetVertexBufferData;   VertexBuffer*   Buffer = nullptr; uint64_t Offset = 0; uint64_t Size = 0; uint64_t DataOffset = 0; };
+		struct SetUniformBufferData  { static constexpr RenderCommandType type = RenderCommandType::SetUniformBufferData;  UniformBuffer*  Buffer = nullptr; uint64_t Offset = 0; uint64_t Size = 0; uint64_t DataOffset = 0; };
+		/// Storage and indirect buffers grow to fit the data
+		struct SetStorageBufferData  { static constexpr RenderCommandType type = RenderCommandType::SetStorageBufferData;  StorageBuffer*  Buffer = nullptr; uint64_t Size = 0; uint64_t DataOffset = 0; };
+		struct SetIndirectBufferData { static constexpr RenderCommandType type = RenderCommandType::SetIndirectBufferData; IndirectBuffer* Buffer = nullptr; uint64_t Size = 0; uint64_t DataOffset = 0; };
+
+		/// Recorded for the regions a StreamingAllocation reports, see StreamingBuffer
+		struct WaitStreamingRegion  { static constexpr RenderCommandType type = RenderCommandType::WaitStreamingRegion;  StreamingBuffer* Buffer = nullptr; uint32_t Region = 0; };
+		struct FenceStreamingRegion { static constexpr RenderCommandType type = RenderCommandType::FenceStreamingRegion; StreamingBuffer* Buffer = nullptr; uint32_t Region = 0; };
+
+		/// Covers plain, instanced and base instance draws
+		struct DrawArrays        { static constexpr RenderCommandType type = RenderCommandType::DrawArrays;        PrimitiveTopology Topology; uint32_t First = 0, Count = 0, InstanceCount = 1, BaseInstance = 0; };
+		/// Indices are uint32_t, covers plain, instanced, base vertex and base instance draws
+		struct DrawElements      { static constexpr RenderCommandType type = RenderCommandType::DrawElements;      PrimitiveTopology Topology; uint32_t Count = 0, FirstIndex = 0, InstanceCount = 1; int32_t BaseVertex = 0; uint32_t BaseInstance = 0; };
+		struct DrawRangeElements { static constexpr RenderCommandType type = RenderCommandType::DrawRangeElements; PrimitiveTopology Topology; uint32_t Start = 0, End = 0, Count = 0; };
+		/// `DrawCount` int firsts, then `DrawCount` int counts recorded right after them
+		struct MultiDrawArrays   { static constexpr RenderCommandType type = RenderCommandType::MultiDrawArrays;   PrimitiveTopology Topology; uint32_t DrawCount = 0; uint64_t DataOffset = 0; };
+		/// `DrawCount` int counts, then `DrawCount` uint64_t byte offsets into the index buffer recorded right after them
+		struct MultiDrawElements { static constexpr RenderCommandType type = RenderCommandType::MultiDrawElements; PrimitiveTopology Topology; uint32_t DrawCount = 0; uint64_t DataOffset = 0; };
+		/// `Offset` is in bytes of the bound indirect buffer, DrawCount of 1 is a single indirect draw
+		struct DrawIndirect      { static constexpr RenderCommandType type = RenderCommandType::DrawIndirect;      PrimitiveTopology Topology; bool Indexed = false; uint32_t DrawCount = 1; uint64_t Offset = 0; };
+
+	}
+
+	/// Commands of one frame in recording order, executed later by a RenderBackend. Never touches OpenGL.
+	/// Commands and the data they copy are written one after another into two byte arrays that keep their memory between frames
+	class RenderCommandBuffer
+	{
+	public:
+		/// Every header, payload and recorded data starts at a multiple of 8 bytes
+		static constexpr size_t alignment = 8;
+		static constexpr size_t GetAlignedSize(size_t size) { return (size + alignment - 1) & ~(alignment - 1); }
+
+		template<typename Command>
+		void Record(const Command& command)
+		{
+			static_assert(std::is_trivially_copyable_v<Command>, "Render commands must be plain data!");
+			static_assert(sizeof(Command) <= std::numeric_limits<uint16_t>::max(), "Render command is too large!");
+
+			const size_t offset = m_Commands.size();
+			m_Commands.resize(offset + header_size + GetAlignedSize(sizeof(Command)));
+
+			const Header header = { Command::type, static_cast<uint16_t>(sizeof(Command)) };
+			std::memcpy(m_Commands.data() + offset, &header, sizeof(Header));
+			std::memcpy(m_Commands.data() + offset + header_size, &command, sizeof(Command));
+
+			m_CommandCount++;
+		}
+
+		/// Copies `size` bytes to the data block, returns their offset for the command that reads them.
+		/// Data recorded next starts GetAlignedSize(size) bytes later
+		uint64_t RecordData(const void* data, size_t size);
+		/// Like RecordData, but leaves `size` bytes for the caller to write through GetData.
+		/// Pointers into the data block are only valid until the next RecordData or ReserveData
+		uint64_t ReserveData(size_t size);
+
+		const uint8_t* GetData(uint64_t offset) const { return m_Data.data() + offset; }
+		uint8_t*       GetData(uint64_t offset)       { return m_Data.data() + offset; }
+
+		/// Calls `function(RenderCommandType, const void* payload)` for every command in recording order, see Read
+		template<typename Function>
+		void ForEach(Function&& function) const
+		{
+			size_t offset = 0;
+			while (offset < m_Commands.size())
+			{
+				Header header;
+				std::memcpy(&header, m_Commands.data() + offset, sizeof(Header));
+
+				function(header.Type, static_cast<const void*>(m_Commands.data() + offset + header_size));
+				offset += header_size + GetAlignedSize(header.Size);
+			}
+		}
+
+		template<typename Command>
+		static Command Read(const void* payload)
+		{
+			Command command;
+			std::memcpy(&command, payload, sizeof(Command));
+			return command;
+		}
+
+		void Clear();
+
+		uint32_t GetCommandCount() const { return m_CommandCount; }
+		bool     IsEmpty()         const { return m_CommandCount == 0; }
+		/// Bytes of commands and of copied data
+		size_t   GetSize()         const { return m_Commands.size() + m_Data.size(); }
+
+	private:
+		struct Header
+		{
+			RenderCommandType Type = RenderCommandType::Count;
+			uint16_t          Size = 0;
+		};
+
+		static constexpr size_t header_size = (sizeof(Header) + alignment - 1) & ~(alignment - 1);
+
+		std::vector<uint8_t> m_Commands;
+		std::vector<uint8_t> m_Data;
+		uint32_t m_CommandCount = 0;
+	};
+
+}
@@ -0,0 +1,48 @@
+#include "kcpch.h"
+#include "Graphics/Core/RenderQueue.h"
+
+namespace KuchCraft {
+
+	void RenderQueue::Sort()
+	{
+		constexpr uint32_t digit_count = sizeof(uint64_t);
+		constexpr uint32_t bucket_count = 256;
+
+		const size_t count = m_Items.size();
+		if (count < 2)
+			return;
+
+		/// Histograms of every byte are counted in one read of the keys
+		std::array<std::array<uint32_t, bucket_count>, digit_count> histograms = {};
+		for (const RenderQueueItem& item : m_Items)
+		{
+			for (uint32_t digit = 0; digit < digit_count; digit++)
+				histograms[digit][(item.Key >> (digit * 8)) & 0xff]++;
+		}
+
+		m_Scratch.resize(count);
+		for (uint32_t digit = 0; digit < digit_count; digit++)
+		{
+			auto& histogram = histograms[digit];
+
+			/// Every key has the same byte here, the order would not change
+			const uint32_t firstByte = (m_Items.front().Key >> (digit * 8)) & 0xff;
+			if (histogram[firstByte] == count)
+				continue;
+
+			uint32_t offset = 0;
+			for (uint32_t& bucket : histogram)
+			{
+				const uint32_t size = bucket;
+				bucket  = offset;
+				offset += size;
+			}
+
+			for (const RenderQueueItem& item : m_Items)
+				m_Scratch[histogram[(item.Key >> (digit * 8)) & 0xff]++] = item;
+
+			m_Items.swap(m_Scratch);
+		}
+	}
+
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+namespace KuchCraft {
+
+	/// Highest bits of every sort key, items of an earlier pass are always drawn first
+	enum class RenderPass : uint8_t
+	{
+		Opaque = 0, Translucent, Overlay
+	};
+
+	/// Draw items are ordered by one 64 bit integer, fields are compared from the highest bits down.
+	/// Opaque:  pass 4 | shader 12 | texture 16 | depth 32, state changes first then front to back for early depth test.
+	/// Blended: pass 4 | depth 32 | shader 12 | texture 16, back to front first, items at the same depth grouped by state
+	namespace RenderSortKey {
+
+		constexpr uint32_t pass_bits    = 4;
+		constexpr uint32_t shader_bits  = 12;
+		constexpr uint32_t texture_bits = 16;
+		constexpr uint32_t depth_bits   = 32;
+
+		static_assert(pass_bits + shader_bits + texture_bits + depth_bits == 64, "Sort key fields must fill 64 bits!");
+
+		/// Bit pattern of a non negative float grows with its value, so any distance can be used as depth.
+		/// Negative values and NaN are treated as 0
+		inline uint32_t FrontToBack(float depth) { return std::bit_cast<uint32_t>(depth > 0.0f ? depth : 0.0f); }
+		inline uint32_t BackToFront(float depth) { return ~FrontToBack(depth); }
+
+		/// Shader and texture ids are cut to their field, ids sharing the low bits only get grouped together
+		constexpr uint64_t Opaque(RenderPass pass, uint32_t shader, uint32_t texture, uint32_t depth)
+		{
+			return (uint64_t)pass                                 << (shader_bits + texture_bits + depth_bits) |
+				(uint64_t)(shader  & (BIT(shader_bits)  - 1))  << (texture_bits + depth_bits)               |
+				(uint64_t)(texture & (BIT(texture_bits) - 1))  << depth_bits                                |
+				(uint64_t)depth;
+		}
+
+		constexpr uint64_t Blended(RenderPass pass, uint32_t depth, uint32_t shader, uint32_t texture)
+		{
+			return (uint64_t)pass                                 << (depth_bits + shader_bits + texture_bits) |
+				(uint64_t)depth                                 << (shader_bits + texture_bits)              |
+				(uint64_t)(shader  & (BIT(shader_bits)  - 1))  << texture_bits                              |
+				(uint64_t)(texture & (BIT(texture_bits) - 1));
+		}
+
+		constexpr RenderPass GetPass(uint64_t key) { return static_cast<RenderPass>(key >> (64 - pass_bits)); }
+
+	}
+
+	struct RenderQueueItem
+	{
+		uint64_t Key   = 0;
+		/// Index of the item in whatever array the owner keeps its draws in
+		uint32_t Index = 0;
+	};
+
+	/// Draw items of one frame, sorted by their keys before anything is submitted. Does not touch OpenGL
+	class RenderQueue
+	{
+	public:
+		void Clear() { m_Items.clear(); }
+		void Reserve(size_t count) { m_Items.reserve(count); }
+
+		void Add(uint64_t key, uint32_t index) { m_Items.push_back({ key, index }); }
+
+		/// Stable least significant digit radix sort, one byte per pass.
+		/// Passes over bytes that are the same in every key are skipped, so keys with unused fields sort faster
+		void Sort();
+
+		const std::vector<RenderQueueItem>& GetItems() const { return m_Items; }
+		uint32_t GetCount() const { return static_cast<uint32_t>(m_Items.size()); }
+		bool     IsEmpty()  const { return m_Items.empty(); }
+
+	private:
+		std::vector<RenderQueueItem> m_Items;
+		std::vector<RenderQueueItem> m_Scratch;
+	};
+
+}
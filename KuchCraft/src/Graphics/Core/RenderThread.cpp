@@ -0,0 +1,121 @@
+#include "kcpch.h"
+#include "Graphics/Core/RenderThread.h"
+
+namespace KuchCraft {
+
+	RenderThread::RenderThread(RenderBackend& backend, std::function<void()> onStart, std::function<void()> onStop)
+		: m_Backend(backend), m_OnStart(std::move(onStart)), m_OnStop(std::move(onStop))
+	{
+		m_Thread = std::thread(&RenderThread::Run, this);
+	}
+
+	RenderThread::~RenderThread()
+	{
+		{
+			std::lock_guard lock(m_Mutex);
+			m_Stopping = true;
+		}
+
+		m_WorkAvailable.notify_one();
+		m_Thread.join();
+	}
+
+	void RenderThread::Submit(RenderCommandBuffer& commands, std::function<void()> present)
+	{
+		std::unique_lock lock(m_Mutex);
+
+		Timer timer;
+		m_WorkDone.wait(lock, [this]() { return m_FrameCount < max_frames_in_flight; });
+		m_Stats.SubmitWaitTime += timer.GetElapsedMilliseconds();
+
+		Frame& frame = m_Frames[(m_FirstFrame + m_FrameCount) % max_frames_in_flight];
+		std::swap(frame.Commands, commands);
+		frame.Present = std::move(present);
+		m_FrameCount++;
+
+		lock.unlock();
+		m_WorkAvailable.notify_one();
+	}
+
+	void RenderThread::WaitIdle()
+	{
+		std::unique_lock lock(m_Mutex);
+
+		Timer timer;
+		m_WorkDone.wait(lock, [this]() { return m_FrameCount == 0; });
+		m_Stats.SyncTime += timer.GetElapsedMilliseconds();
+		m_Stats.SyncCount++;
+	}
+
+	void RenderThread::Invoke(const std::function<void()>& function)
+	{
+		std::unique_lock lock(m_Mutex);
+
+		Timer timer;
+		m_WorkDone.wait(lock, [this]() { return m_FrameCount == 0; });
+
+		m_Task = &function;
+		m_WorkAvailable.notify_one();
+		m_WorkDone.wait(lock, [this]() { return m_Task == nullptr; });
+
+		m_Stats.SyncTime += timer.GetElapsedMilliseconds();
+		m_Stats.SyncCount++;
+	}
+
+	RenderThreadStats RenderThread::GetStats() const
+	{
+		std::lock_guard lock(m_Mutex);
+		return m_Stats;
+	}
+
+	void RenderThread::Run()
+	{
+		if (m_OnStart)
+			m_OnStart();
+
+		std::unique_lock lock(m_Mutex);
+		while (true)
+		{
+			m_WorkAvailable.wait(lock, [this]() { return m_FrameCount > 0 || m_Task || m_Stopping; });
+
+			/// Queued frames go first, so stopping drains the queue
+			if (m_FrameCount > 0)
+			{
+				Frame& frame = m_Frames[m_FirstFrame];
+				lock.unlock();
+
+				Timer timer;
+				m_Backend.Execute(frame.Commands);
+				if (frame.Present)
+					frame.Present();
+
+				frame.Commands.Clear();
+				frame.Present = nullptr;
+				const double executeTime = timer.GetElapsedMilliseconds();
+
+				lock.lock();
+				m_FirstFrame = (m_FirstFrame + 1) % max_frames_in_flight;
+				m_FrameCount--;
+				m_Stats.Frames++;
+				m_Stats.ExecuteTime += executeTime;
+			}
+			else if (m_Task)
+			{
+				lock.unlock();
+				(*m_Task)();
+				lock.lock();
+
+				m_Task = nullptr;
+			}
+			else
+				break;
+
+			m_WorkDone.notify_all();
+		}
+		lock.unlock();
+
+		if (m_OnStop)
+			m_OnStop();
+	}
+
+}
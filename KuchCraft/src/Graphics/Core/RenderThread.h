@@ -0,0 +1,81 @@
+#pragma once
+
+#include "Graphics/Core/RenderBackend.h"
+
+#include <condition_variable>
+
+namespace KuchCraft {
+
+	/// Times are in milliseconds, summed since the thread started
+	struct RenderThreadStats
+	{
+		uint32_t Frames    = 0;
+		uint32_t SyncCount = 0;
+
+		/// Render thread executing commands and present callbacks
+		double ExecuteTime = 0.0;
+		/// Main thread blocked on a full queue in Submit
+		double SubmitWaitTime = 0.0;
+		/// Main thread blocked in WaitIdle and Invoke
+		double SyncTime = 0.0;
+	};
+
+	/// Worker that executes recorded frames with a backend while the caller records the next one.
+	/// At most max_frames_in_flight frames are queued or executing, Submit blocks while the queue is full.
+	/// Everything the backend touches is only used on the worker, so an OpenGL context can be made current there by `onStart`.
+	/// Submit, WaitIdle and Invoke must be called from one thread
+	class RenderThread
+	{
+	public:
+		static constexpr uint32_t max_frames_in_flight = 2;
+
+		/// `onStart` runs on the worker before the first frame, `onStop` after the last one
+		RenderThread(RenderBackend& backend, std::function<void()> onStart = {}, std::function<void()> onStop = {});
+		/// Executes every queued frame before the worker stops
+		~RenderThread();
+
+		/// Queues `commands` for execution, `present` runs on the worker right after them.
+		/// `commands` is swapped with an empty buffer of an executed frame, so recording keeps its memory
+		void Submit(RenderCommandBuffer& commands, std::function<void()> present = {});
+
+		/// Sync point, blocks until every submitted frame has executed
+		void WaitIdle();
+
+		/// Sync point, runs `function` on the worker once every submitted frame has executed and waits for it.
+		/// For work that needs the context outside of recorded frames, like resizing or reloading resources
+		void Invoke(const std::function<void()>& function);
+
+		RenderThreadStats GetStats() const;
+
+	private:
+		void Run();
+
+	private:
+		struct Frame
+		{
+			RenderCommandBuffer   Commands;
+			std::function<void()> Present;
+		};
+
+		RenderBackend&        m_Backend;
+		std::function<void()> m_OnStart;
+		std::function<void()> m_OnStop;
+
+		/// Ring of frames, `m_FrameCount` of them starting at `m_FirstFrame` wait for or are in execution
+		std::array<Frame, max_frames_in_flight> m_Frames;
+		uint32_t m_FirstFrame = 0;
+		uint32_t m_FrameCount = 0;
+
+		const std::function<void()>* m_Task = nullptr;
+		bool m_Stopping = false;
+
+		RenderThreadStats m_Stats;
+
+		mutable std::mutex      m_Mutex;
+		std::condition_variable m_WorkAvailable;
+		std::condition_variable m_WorkDone;
+
+		std::thread m_Thread;
+	};
+
+}
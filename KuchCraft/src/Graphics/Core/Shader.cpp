@@ -346,6 +346,12 @@ namespace KuchCraft {
 		}
 	}
 
+	int Shader::FindUniformLocation(const std::string& name) const
+	{
+		auto it = m_UniformLocations.find(name);
+		return it != m_UniformLocations.end() ? it->second : -1;
+	}
+
 	int Shader::GetUniformLocation(const std::string& name)
 	{
 		KC_CORE_ASSERT(IsValid(), "Shader is not valid.");
@@ -48,6 +48,9 @@ namespace KuchCraft
 		void SetMat3(const std::string& name, const glm::mat3& value);
 		void SetMat4(const std::string& name, const glm::mat4& value);
 
+		/// Location found when the shader was compiled, -1 otherwise. Never calls OpenGL, so commands can be recorded anywhere
+		int FindUniformLocation(const std::string& name) const;
+
 		const std::unordered_map<std::string, std::string>& GetLocalSubstitutions() const { return m_LocalSubstitutions; }
 		void SetLocalSubstitution(const std::string& name, const std::string& value);
 		void RemoveLocalSubstitution(const std::string& name);
@@ -0,0 +1,78 @@
+#include "kcpch.h"
+#include "Graphics/Core/StorageBuffer.h"
+
+#include <glad/glad.h>
+
+namespace KuchCraft {
+
+	StorageBuffer::StorageBuffer(size_t size)
+		: m_Size(size)
+	{
+		KC_CORE_ASSERT(size > 0, "StorageBuffer size must be greater than 0.");
+
+		m_Binding = AllocateBinding();
+
+		glCreateBuffers(1, &m_RendererID);
+		glNamedBufferData(m_RendererID, m_Size, nullptr, GL_DYNAMIC_DRAW);
+		glBindBufferBase(GL_SHADER_STORAGE_BUFFER, m_Binding, m_RendererID);
+	}
+
+	StorageBuffer::~StorageBuffer()
+	{
+		if (IsValid())
+		{
+			glDeleteBuffers(1, &m_RendererID);
+			ReleaseBinding(m_Binding);
+		}
+	}
+
+	Ref<StorageBuffer> StorageBuffer::Create(size_t size)
+	{
+		return Ref<StorageBuffer>(new StorageBuffer(size));
+	}
+
+	void StorageBuffer::SetData(const void* data, size_t size)
+	{
+		KC_CORE_ASSERT(IsValid(), "StorageBuffer is not valid.");
+
+		if (size == 0)
+			return;
+
+		/// Buffer object stays the same, so the binding does not have to be set again
+		if (size > m_Size)
+		{
+			m_Size = std::max(size, m_Size * 2);
+			glNamedBufferData(m_RendererID, m_Size, nullptr, GL_DYNAMIC_DRAW);
+		}
+
+		glNamedBufferSubData(m_RendererID, 0, size, data);
+	}
+
+	void StorageBuffer::SetDebugName(const std::string& name)
+	{
+		KC_CORE_ASSERT(!name.empty(), "StorageBuffer debug name must not be empty.");
+		KC_CORE_ASSERT(IsValid(), "StorageBuffer is not valid.");
+
+		m_DebugName = name;
+		if (GLAD_GL_KHR_debug)
+			glObjectLabel(GL_BUFFER, m_RendererID, static_cast<GLsizei>(name.length()), name.c_str());
+	}
+
+	uint32_t StorageBuffer::AllocateBinding()
+	{
+		if (!s_FreeBindings.empty())
+		{
+			auto it = s_FreeBindings.begin();
+			uint32_t binding = *it;
+			s_FreeBindings.erase(it);
+			return binding;
+		}
+
+		return s_NextAvailableBinding++;
+	}
+
+	void StorageBuffer::ReleaseBinding(uint32_t binding)
+	{
+		s_FreeBindings.insert(binding);
+	}
+}
@@ -0,0 +1,68 @@
+#include "kcpch.h"
+#include "Graphics/Core/StreamingBuffer.h"
+
+#include <glad/glad.h>
+
+namespace KuchCraft {
+
+	StreamingBuffer::StreamingBuffer(size_t size, uint32_t regionCount)
+		: m_Ring(size, regionCount), m_Fences(regionCount, nullptr)
+	{
+		KC_CORE_ASSERT(regionCount > 0, "StreamingBuffer needs at least one region.");
+
+		m_VertexBuffer = VertexBuffer::Create(VertexBufferDataUsage::Stream, size);
+	}
+
+	StreamingBuffer::~StreamingBuffer()
+	{
+		for (void* fence : m_Fences)
+		{
+			if (fence)
+				glDeleteSync(static_cast<GLsync>(fence));
+		}
+	}
+
+	Ref<StreamingBuffer> StreamingBuffer::Create(size_t size, uint32_t regionCount)
+	{
+		return Ref<StreamingBuffer>(new StreamingBuffer(size, regionCount));
+	}
+
+	void StreamingBuffer::WaitRegion(uint32_t region)
+	{
+		KC_CORE_ASSERT(region < m_Fences.size(), "StreamingBuffer region out of range.");
+
+		GLsync fence = static_cast<GLsync>(m_Fences[region]);
+		if (!fence)
+			return;
+
+		/// Polls once without blocking, the region was left a few regions ago so its fence is usually signaled
+		GLenum result = glClientWaitSync(fence, 0, 0);
+		if (result == GL_TIMEOUT_EXPIRED)
+		{
+			m_BlockedWaits++;
+
+			constexpr GLuint64 timeout = 1'000'000; /// 1 ms in nanoseconds
+			do
+			{
+				result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, timeout);
+			} while (result == GL_TIMEOUT_EXPIRED);
+		}
+
+		if (result == GL_WAIT_FAILED)
+			KC_CORE_ERROR("Waiting for StreamingBuffer fence failed");
+
+		glDeleteSync(fence);
+		m_Fences[region] = nullptr;
+	}
+
+	void StreamingBuffer::FenceRegion(uint32_t region)
+	{
+		KC_CORE_ASSERT(region < m_Fences.size(), "StreamingBuffer region out of range.");
+
+		if (m_Fences[region])
+			glDeleteSync(static_cast<GLsync>(m_Fences[region]));
+
+		m_Fences[region] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+	}
+
+}
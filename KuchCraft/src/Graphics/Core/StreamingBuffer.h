@@ -0,0 +1,48 @@
+#pragma once
+
+#include "Graphics/Core/VertexBuffer.h"
+#include "Graphics/Core/StreamingRing.h"
+
+namespace KuchCraft {
+
+	/// Persistently mapped vertex buffer for data rewritten every frame, split into StreamingRing regions.
+	/// Data is copied straight into the mapping instead of through glNamedBufferSubData, so rewriting the buffer
+	/// several times a frame neither makes the driver copy nor sync. Each region gets a fence once the ring leaves it
+	/// and writing to it again waits for that fence, usually long signaled.
+	/// Allocate runs where commands are recorded, WaitRegion and FenceRegion where they are executed
+	class StreamingBuffer
+	{
+	public:
+		~StreamingBuffer();
+
+		static Ref<StreamingBuffer> Create(size_t size, uint32_t regionCount = StreamingRing::default_region_count);
+
+		StreamingAllocation Allocate(uint64_t size, uint64_t alignment = 1) { return m_Ring.Allocate(size, alignment); }
+
+		/// Blocks until the GPU is done with commands issued before the last FenceRegion of `region`, needs the context
+		void WaitRegion(uint32_t region);
+		/// Marks the end of commands reading `region`, needs the context
+		void FenceRegion(uint32_t region);
+
+		const Ref<VertexBuffer>& GetVertexBuffer() const { return m_VertexBuffer; }
+		const StreamingRing&     GetRing()         const { return m_Ring; }
+		/// WaitRegion calls that had to block because the GPU was still reading the region
+		uint64_t                 GetBlockedWaits() const { return m_BlockedWaits; }
+
+		void SetDebugName(const std::string& name) { m_VertexBuffer->SetDebugName(name); }
+
+	private:
+		Ref<VertexBuffer> m_VertexBuffer;
+		StreamingRing     m_Ring;
+
+		/// GLsync of every region, null when it has no pending fence
+		std::vector<void*> m_Fences;
+		uint64_t           m_BlockedWaits = 0;
+
+		StreamingBuffer(size_t size, uint32_t regionCount);
+
+		KC_DISALLOW_COPY(StreamingBuffer);
+		KC_DISALLOW_MOVE(StreamingBuffer);
+	};
+
+}
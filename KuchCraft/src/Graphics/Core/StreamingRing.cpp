@@ -0,0 +1,61 @@
+#include "kcpch.h"
+#include "Graphics/Core/StreamingRing.h"
+
+namespace KuchCraft {
+
+	StreamingRing::StreamingRing(uint64_t capacity, uint32_t regionCount)
+		: m_RegionSize(regionCount > 0 ? capacity / regionCount : 0), m_RegionCount(regionCount)
+	{
+	}
+
+	StreamingAllocation StreamingRing::Allocate(uint64_t size, uint64_t alignment)
+	{
+		KC_CORE_ASSERT(alignment > 0, "StreamingRing alignment must be greater than 0.");
+
+		StreamingAllocation allocation;
+		if (size == 0 || size > m_RegionSize)
+		{
+			m_Stats.FailedAllocations++;
+			return allocation;
+		}
+
+		auto alignUp = [alignment](uint64_t offset) { return (offset + alignment - 1) / alignment * alignment; };
+
+		uint64_t offset = alignUp(m_Head);
+		if (m_Region == invalid_streaming_region || offset + size > (m_Region + 1) * m_RegionSize)
+		{
+			const uint32_t next   = m_Region == invalid_streaming_region ? 0 : (m_Region + 1) % m_RegionCount;
+			const uint64_t start  = next * m_RegionSize;
+			const uint64_t offsetInNext = alignUp(start);
+
+			/// A region too small for the size after alignment would be skipped forever, report it as not fitting
+			if (offsetInNext + size > start + m_RegionSize)
+			{
+				m_Stats.FailedAllocations++;
+				return allocation;
+			}
+
+			if (m_Region != invalid_streaming_region)
+			{
+				m_Stats.PaddingBytes += (m_Region + 1) * m_RegionSize - m_Head;
+				m_Stats.RegionSwitches++;
+			}
+
+			allocation.ClosedRegion = m_Region;
+			allocation.OpenedRegion = next;
+
+			m_Region = next;
+			m_Head   = start;
+			offset   = offsetInNext;
+		}
+
+		m_Stats.PaddingBytes   += offset - m_Head;
+		m_Stats.AllocatedBytes += size;
+		m_Stats.Allocations++;
+
+		m_Head = offset + size;
+		allocation.Offset = offset;
+		return allocation;
+	}
+
+}
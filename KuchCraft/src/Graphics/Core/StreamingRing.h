@@ -0,0 +1,66 @@
+#pragma once
+
+namespace KuchCraft {
+
+	constexpr uint32_t invalid_streaming_region = std::numeric_limits<uint32_t>::max();
+	constexpr uint64_t invalid_streaming_offset = std::numeric_limits<uint64_t>::max();
+
+	struct StreamingAllocation
+	{
+		/// invalid_streaming_offset when the size does not fit in one region
+		uint64_t Offset = invalid_streaming_offset;
+		/// Region the ring left for this allocation, its owner should fence it after the commands that read it
+		uint32_t ClosedRegion = invalid_streaming_region;
+		/// Region the ring entered for this allocation, its owner has to wait for the fence of it before writing
+		uint32_t OpenedRegion = invalid_streaming_region;
+
+		bool IsValid() const { return Offset != invalid_streaming_offset; }
+	};
+
+	struct StreamingRingStats
+	{
+		uint64_t Allocations    = 0;
+		uint64_t AllocatedBytes = 0;
+		/// Bytes skipped for alignment and at the end of full regions
+		uint64_t PaddingBytes   = 0;
+		uint64_t RegionSwitches = 0;
+		uint64_t FailedAllocations = 0;
+	};
+
+	/// Offsets of a buffer split into equal regions that are written one after another and reused in a ring.
+	/// Allocations never span two regions, when the current one is full the ring moves to the next and reports both,
+	/// so the owner can fence the region it left and wait before overwriting the one it entered.
+	/// Never touches the buffer itself. Not thread safe
+	class StreamingRing
+	{
+	public:
+		/// Three regions let the CPU write one while the GPU may still read the two before
+		static constexpr uint32_t default_region_count = 3;
+
+		/// `capacity` is split into `regionCount` regions, a remainder smaller than the region count is never used
+		StreamingRing(uint64_t capacity = 0, uint32_t regionCount = default_region_count);
+
+		/// `size` bytes at an offset that is a multiple of `alignment`, which does not have to be a power of two
+		/// so vertex strides can be used. The first allocation opens region 0
+		StreamingAllocation Allocate(uint64_t size, uint64_t alignment = 1);
+
+		uint64_t GetCapacity()    const { return m_RegionSize * m_RegionCount; }
+		uint64_t GetRegionSize()  const { return m_RegionSize; }
+		uint32_t GetRegionCount() const { return m_RegionCount; }
+		/// invalid_streaming_region before the first allocation
+		uint32_t GetRegion()      const { return m_Region; }
+
+		const StreamingRingStats& GetStats() const { return m_Stats; }
+
+	private:
+		uint64_t m_RegionSize  = 0;
+		uint32_t m_RegionCount = 0;
+
+		uint32_t m_Region = invalid_streaming_region;
+		/// Next free byte of the current region, absolute offset in the buffer
+		uint64_t m_Head   = 0;
+
+		StreamingRingStats m_Stats;
+	};
+
+}
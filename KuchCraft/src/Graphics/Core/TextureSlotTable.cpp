@@ -0,0 +1,65 @@
+#include "kcpch.h"
+#include "Graphics/Core/TextureSlotTable.h"
+
+namespace KuchCraft {
+
+	TextureSlotTable::TextureSlotTable(uint32_t slotCount, uint32_t reservedSlots)
+		: m_Textures(slotCount, 0), m_ReservedSlots(std::min(reservedSlots, slotCount)), m_UsedSlots(m_ReservedSlots)
+	{
+		const uint32_t entryCount = std::bit_ceil(std::max(slotCount * 2, 2u));
+		m_Entries.resize(entryCount);
+		m_Shift = 32 - std::countr_zero(entryCount);
+	}
+
+	void TextureSlotTable::NextBatch()
+	{
+		m_UsedSlots   = m_ReservedSlots;
+		m_LastTexture = 0;
+
+		/// Entries of every older batch become empty at once, only a wrapped counter needs a real clear
+		if (++m_Generation == 0)
+		{
+			std::fill(m_Entries.begin(), m_Entries.end(), Entry());
+			m_Generation = 1;
+		}
+	}
+
+	int TextureSlotTable::GetSlot(RendererID texture)
+	{
+		/// Sorted quads ask for the same texture many times in a row
+		if (texture == m_LastTexture && texture != 0)
+			return m_LastSlot;
+
+		/// Fibonacci hashing, the top bits of the product spread sequential ids over the table
+		const uint32_t mask  = static_cast<uint32_t>(m_Entries.size()) - 1;
+		uint32_t       index = (texture * 2654435769u) >> m_Shift;
+
+		while (true)
+		{
+			Entry& entry = m_Entries[index & mask];
+			if (entry.Generation != m_Generation)
+			{
+				if (m_UsedSlots >= m_Textures.size())
+					return invalid_slot;
+
+				const int slot = static_cast<int>(m_UsedSlots++);
+				entry = { texture, m_Generation, slot };
+				m_Textures[slot] = texture;
+
+				m_LastTexture = texture;
+				m_LastSlot    = slot;
+				return slot;
+			}
+
+			if (entry.Texture == texture)
+			{
+				m_LastTexture = texture;
+				m_LastSlot    = entry.Slot;
+				return entry.Slot;
+			}
+
+			index++;
+		}
+	}
+
+}
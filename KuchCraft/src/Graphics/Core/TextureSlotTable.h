@@ -0,0 +1,52 @@
+#pragma once
+
+namespace KuchCraft {
+
+	/// Texture slots of one batch, found by texture renderer id in constant time.
+	/// Ids live in an open addressing table with a generation stamp per entry, so starting the next batch
+	/// only bumps the generation instead of clearing the table. Does not touch OpenGL
+	class TextureSlotTable
+	{
+	public:
+		static constexpr int invalid_slot = -1;
+
+		/// Slots below `reservedSlots` are never handed out, their textures are set with SetReserved
+		TextureSlotTable(uint32_t slotCount = 0, uint32_t reservedSlots = 1);
+
+		void SetReserved(uint32_t slot, RendererID texture) { m_Textures[slot] = texture; }
+
+		/// Forgets every assigned slot except the reserved ones
+		void NextBatch();
+
+		/// Slot of `texture` in this batch, the next free one when it has none yet.
+		/// Returns invalid_slot when every slot is taken, the caller should flush and start the next batch
+		int GetSlot(RendererID texture);
+
+		RendererID GetTexture(uint32_t slot) const { return m_Textures[slot]; }
+		/// Reserved slots included
+		uint32_t   GetUsedSlots()  const { return m_UsedSlots; }
+		uint32_t   GetSlotCount()  const { return static_cast<uint32_t>(m_Textures.size()); }
+
+	private:
+		struct Entry
+		{
+			RendererID Texture    = 0;
+			uint32_t   Generation = 0;
+			int        Slot       = invalid_slot;
+		};
+
+		/// Power of two, at least twice the slot count so probes stay short
+		std::vector<Entry>      m_Entries;
+		uint32_t                m_Shift      = 0;
+		uint32_t                m_Generation = 1;
+
+		/// Texture of the previous lookup, 0 when there was none in this batch
+		RendererID              m_LastTexture = 0;
+		int                     m_LastSlot    = invalid_slot;
+
+		std::vector<RendererID> m_Textures;
+		uint32_t                m_ReservedSlots = 0;
+		uint32_t                m_UsedSlots     = 0;
+	};
+
+}
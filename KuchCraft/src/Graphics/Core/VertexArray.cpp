@@ -53,13 +53,14 @@ namespace KuchCraft {
 		glBindVertexArray(0);
 	}
 
-	void VertexArray::AddVertexBuffer(const Ref<VertexBuffer>& vertexBuffer)
+	void VertexArray::AddVertexBuffer(const Ref<VertexBuffer>& vertexBuffer, uint32_t instanceDivisor)
 	{
 		KC_CORE_ASSERT(vertexBuffer, "VertexBuffer cannot be null!");
 
 		const BufferLayout& layout = vertexBuffer->GetLayout();
 
 		glVertexArrayVertexBuffer(m_RendererID, m_AttributeBindingIndex, vertexBuffer->GetRendererID(), 0, layout.GetStride());
+		glVertexArrayBindingDivisor(m_RendererID, m_AttributeBindingIndex, instanceDivisor);
 		for (const auto& element : layout)
 		{
 			glEnableVertexArrayAttrib(m_RendererID, m_AttributeIndex);
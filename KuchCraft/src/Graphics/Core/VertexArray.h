@@ -15,7 +15,8 @@ namespace KuchCraft {
 		void Bind() const;
 		void Unbind() const;
 
-		void AddVertexBuffer(const Ref<VertexBuffer>& vertexBuffer);
+		/// With non zero `instanceDivisor` attributes of the buffer advance once per that many instances instead of once per vertex
+		void AddVertexBuffer(const Ref<VertexBuffer>& vertexBuffer, uint32_t instanceDivisor = 0);
 		void SetIndexBuffer(const Ref<IndexBuffer>& indexBuffer);
 
 		const std::vector<Ref<VertexBuffer>>& GetVertexBuffers() const { return m_VertexBuffers; }
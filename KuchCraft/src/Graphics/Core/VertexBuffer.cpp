@@ -26,6 +26,9 @@ namespace KuchCraft {
 
 	VertexBuffer::~VertexBuffer()
 	{
+		if (m_MappedData)
+			glUnmapNamedBuffer(m_RendererID);
+
 		if (IsValid())
 			glDeleteBuffers(1, &m_RendererID);
 	}
@@ -36,7 +39,19 @@ namespace KuchCraft {
 		KC_CORE_ASSERT(size > 0, "VertexBuffer size must be greater than 0.");
 
 		glCreateBuffers(1, &m_RendererID);
-		glNamedBufferData(m_RendererID, size, data, (usage == VertexBufferDataUsage::Static) ? GL_STATIC_DRAW : GL_DYNAMIC_DRAW);
+		if (usage == VertexBufferDataUsage::Stream)
+		{
+			/// Coherent mapping makes writes visible to commands issued after them without explicit flushes
+			constexpr GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+			glNamedBufferStorage(m_RendererID, size, data, flags);
+			m_MappedData = glMapNamedBufferRange(m_RendererID, 0, size, flags);
+
+			KC_CORE_ASSERT(m_MappedData, "Failed to map VertexBuffer!");
+		}
+		else
+		{
+			glNamedBufferData(m_RendererID, size, data, (usage == VertexBufferDataUsage::Static) ? GL_STATIC_DRAW : GL_DYNAMIC_DRAW);
+		}
 
 		KC_CORE_ASSERT(IsValid(), "Failed to create VertexBuffer!");
 	}
@@ -58,7 +73,23 @@ namespace KuchCraft {
 		KC_CORE_ASSERT(byteOffset + requiredSize <= currentSize,
 			"VertexBuffer data exceeds buffer size. Required: {}, Allocated: {}", byteOffset + requiredSize, currentSize);
 
-		glNamedBufferSubData(m_RendererID, byteOffset, size, data);
+		if (m_MappedData)
+			std::memcpy(static_cast<uint8_t*>(m_MappedData) + byteOffset, data, size);
+		else
+			glNamedBufferSubData(m_RendererID, byteOffset, size, data);
+	}
+
+	void VertexBuffer::CopyData(const Ref<VertexBuffer>& source, size_t sourceOffset, size_t offset, size_t size)
+	{
+		KC_CORE_ASSERT(IsValid(), "VertexBuffer is not valid.");
+		KC_CORE_ASSERT(source && source->IsValid(), "Source VertexBuffer is not valid.");
+		KC_CORE_ASSERT(source.get() != this, "VertexBuffer can not copy from itself.");
+		KC_CORE_ASSERT(sourceOffset + size <= source->GetSize() && offset + size <= m_Size, "VertexBuffer copy exceeds buffer size.");
+
+		if (size == 0)
+			return;
+
+		glCopyNamedBufferSubData(source->GetRendererID(), m_RendererID, sourceOffset, offset, size);
 	}
 
 	void VertexBuffer::SetLayout(const BufferLayout& layout)
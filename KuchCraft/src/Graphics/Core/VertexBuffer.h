@@ -84,7 +84,10 @@ namespace KuchCraft {
 	enum class VertexBufferDataUsage
 	{
 		Static  = 0,
-		Dynamic = 1
+		Dynamic = 1,
+		/// Persistently mapped, SetData copies straight into the mapping without a driver copy or sync.
+		/// The owner has to make sure the GPU is done reading what it overwrites, see StreamingBuffer
+		Stream  = 2
 	};
 
 	class VertexBuffer
@@ -95,10 +98,14 @@ namespace KuchCraft {
 		static Ref<VertexBuffer> Create(VertexBufferDataUsage usage, size_t size, const void* data = nullptr);
 
 		void SetData(const void* data, size_t size, size_t offset = 0);
+		/// Copies `size` bytes from `source` on the GPU, `source` may not be this buffer
+		void CopyData(const Ref<VertexBuffer>& source, size_t sourceOffset, size_t offset, size_t size);
 		bool IsValid() const { return m_RendererID != 0; }	
 
 		RendererID GetRendererID() const { return m_RendererID; }
 		size_t     GetSize()       const { return m_Size;       }
+		/// Null unless the buffer was created with VertexBufferDataUsage::Stream
+		void*      GetMappedData() const { return m_MappedData; }
 
 		void SetLayout(const BufferLayout& layout);
 		const BufferLayout& GetLayout() const { return m_Layout; }
@@ -110,6 +117,7 @@ namespace KuchCraft {
 		std::string  m_DebugName  = "UnnamedVertexBuffer";
 		RendererID   m_RendererID = 0;
 		size_t       m_Size       = 0;
+		void*        m_MappedData = nullptr;
 		BufferLayout m_Layout;
 		VertexBufferDataUsage m_Usage = VertexBufferDataUsage::Static;
 
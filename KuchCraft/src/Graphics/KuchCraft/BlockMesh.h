@@ -0,0 +1,157 @@
+#pragma once
+
+#include "KuchCraft/World/WorldCore.h"
+#include "KuchCraft/World/Block.h"
+
+namespace KuchCraft {
+
+	constexpr uint32_t block_mesh_bits_for_layer = block_bits_for_id;
+	constexpr uint32_t block_mesh_bits_for_position_x = std::bit_width(chunk_size_x - 1);
+	constexpr uint32_t block_mesh_bits_for_position_y = std::bit_width(chunk_size_y - 1);
+	constexpr uint32_t block_mesh_bits_for_position_z = std::bit_width(chunk_size_z - 1);
+	constexpr uint32_t block_mesh_bits_for_rotation     = 2;
+	constexpr uint32_t block_mesh_bits_for_face         = 3;
+	/// Greedy quads never leave their section, size is stored as (size - 1)
+	constexpr uint32_t block_mesh_bits_for_size         = std::bit_width(section_size_x - 1);
+	/// BlockGeometryType of the block the face belongs to, faces of non-cube shapes are reshaped by ChunkMesh.glsl
+	constexpr uint32_t block_mesh_bits_for_geometry     = 2;
+	/// Baked ambient occlusion, level 0 - 3 for each of the 4 face corners
+	constexpr uint32_t block_mesh_bits_for_ao_corner    = 2;
+	constexpr uint32_t block_mesh_bits_for_ao           = block_mesh_bits_for_ao_corner * 4;
+	/// Set when the face is split into triangles along its other diagonal
+	constexpr uint32_t block_mesh_bits_for_flip         = 1;
+
+	/// One BlockMesh is one face instance, the vertex shader expands it into two triangles from gl_VertexID
+	constexpr uint8_t  block_corners_per_face  = 4;
+	constexpr uint8_t  block_vertices_per_face = 6;
+
+	/// Cross blocks are two diagonal quads, each with a face for both of its sides
+	constexpr uint8_t  block_cross_face_count  = 4;
+	/// Height of Plane blocks above the bottom of their block, in blocks
+	constexpr float    block_plane_height      = 1.0f / 16.0f;
+
+	constexpr uint32_t block_mesh_total_bits = block_mesh_bits_for_face + block_mesh_bits_for_rotation +
+		block_mesh_bits_for_position_z + block_mesh_bits_for_position_y + block_mesh_bits_for_position_x +
+		block_mesh_bits_for_layer      + block_mesh_bits_for_size * 2   + block_mesh_bits_for_geometry +
+		block_mesh_bits_for_ao         + block_mesh_bits_for_flip;
+
+	static_assert(block_mesh_total_bits <= 64, "BlockMesh does not fit in 64 bits!");
+	static_assert(BIT(block_mesh_bits_for_face) >= block_face_count, "Not enough bits for block face!");
+	static_assert(BIT(block_mesh_bits_for_geometry) > static_cast<uint32_t>(BlockGeometryType::Plane), "Not enough bits for block geometry!");
+	static_assert(block_mesh_bits_for_ao == block_mesh_bits_for_ao_corner * block_corners_per_face, "Ambient occlusion bits must cover every face corner!");
+	static_assert(BIT(block_mesh_bits_for_size) == section_size_x && section_size_x == section_size_y && section_size_y == section_size_z,
+		"Quad size bits must cover exactly one cubic section!");
+
+	constexpr uint32_t block_mesh_shift_face         = 0;
+	constexpr uint32_t block_mesh_shift_rotation     = block_mesh_shift_face         + block_mesh_bits_for_face;
+	constexpr uint32_t block_mesh_shift_position_z   = block_mesh_shift_rotation     + block_mesh_bits_for_rotation;
+	constexpr uint32_t block_mesh_shift_position_y   = block_mesh_shift_position_z   + block_mesh_bits_for_position_z;
+	constexpr uint32_t block_mesh_shift_position_x   = block_mesh_shift_position_y   + block_mesh_bits_for_position_y;
+	constexpr uint32_t block_mesh_shift_layer        = block_mesh_shift_position_x   + block_mesh_bits_for_position_x;
+	constexpr uint32_t block_mesh_shift_width        = block_mesh_shift_layer        + block_mesh_bits_for_layer;
+	constexpr uint32_t block_mesh_shift_height       = block_mesh_shift_width        + block_mesh_bits_for_size;
+	constexpr uint32_t block_mesh_shift_geometry     = block_mesh_shift_height       + block_mesh_bits_for_size;
+	constexpr uint32_t block_mesh_shift_ao           = block_mesh_shift_geometry     + block_mesh_bits_for_geometry;
+	constexpr uint32_t block_mesh_shift_flip         = block_mesh_shift_ao           + block_mesh_bits_for_ao;
+
+	static_assert(block_mesh_shift_flip + block_mesh_bits_for_flip == block_mesh_total_bits, "BlockMesh fields overlap or leave gaps!");
+
+	constexpr uint64_t block_mesh_mask_face         = BIT(block_mesh_bits_for_face)         - 1;
+	constexpr uint64_t block_mesh_mask_rotation     = BIT(block_mesh_bits_for_rotation)     - 1;
+	constexpr uint64_t block_mesh_mask_position_z   = BIT(block_mesh_bits_for_position_z)   - 1;
+	constexpr uint64_t block_mesh_mask_position_y   = BIT(block_mesh_bits_for_position_y)   - 1;
+	constexpr uint64_t block_mesh_mask_position_x   = BIT(block_mesh_bits_for_position_x)   - 1;
+	constexpr uint64_t block_mesh_mask_layer        = BIT(block_mesh_bits_for_layer)        - 1;
+	constexpr uint64_t block_mesh_mask_size         = BIT(block_mesh_bits_for_size)         - 1;
+	constexpr uint64_t block_mesh_mask_geometry     = BIT(block_mesh_bits_for_geometry)     - 1;
+	constexpr uint64_t block_mesh_mask_ao           = BIT(block_mesh_bits_for_ao)           - 1;
+	constexpr uint64_t block_mesh_mask_ao_corner    = BIT(block_mesh_bits_for_ao_corner)    - 1;
+	constexpr uint64_t block_mesh_mask_flip         = BIT(block_mesh_bits_for_flip)         - 1;
+
+	/// Packed face instance, read once per instance by ChunkMesh.glsl
+	struct BlockMesh
+	{
+		BlockMesh() = default;
+		BlockMesh(uint8_t x, uint8_t y, uint8_t z, uint16_t layer, uint8_t face, uint8_t rot, uint8_t width = 1, uint8_t height = 1,
+			BlockGeometryType geometry = BlockGeometryType::Cube)
+		{
+			Set(x, y, z, layer, face, rot, width, height, geometry);
+		}
+
+		uint32_t LowerBits = 0;
+		uint32_t UpperBits = 0;
+	
+		uint8_t  GetFace()        const { return (GetRaw() >> block_mesh_shift_face)         & block_mesh_mask_face; }
+		uint8_t  GetRotation()    const { return (GetRaw() >> block_mesh_shift_rotation)     & block_mesh_mask_rotation; }
+		uint8_t  GetZ()           const { return (GetRaw() >> block_mesh_shift_position_z)   & block_mesh_mask_position_z; }
+		uint8_t  GetY()           const { return (GetRaw() >> block_mesh_shift_position_y)   & block_mesh_mask_position_y; }
+		uint8_t  GetX()           const { return (GetRaw() >> block_mesh_shift_position_x)   & block_mesh_mask_position_x; }
+		uint16_t GetLayer()       const { return (GetRaw() >> block_mesh_shift_layer)        & block_mesh_mask_layer; }
+		/// Size of the quad in blocks, along the face axes described in ChunkMesh.glsl
+		uint8_t  GetWidth()       const { return ((GetRaw() >> block_mesh_shift_width)  & block_mesh_mask_size) + 1; }
+		uint8_t  GetHeight()      const { return ((GetRaw() >> block_mesh_shift_height) & block_mesh_mask_size) + 1; }
+		/// Cross faces are numbered 0 - 3 instead of using BlockFace, one per side of its two diagonal quads
+		BlockGeometryType GetGeometry() const { return static_cast<BlockGeometryType>((GetRaw() >> block_mesh_shift_geometry) & block_mesh_mask_geometry); }
+		/// Occlusion level of every corner, 2 bits per corner in corner order of ChunkMesh.glsl, 0 is not occluded
+		uint8_t  GetAmbientOcclusion() const { return (GetRaw() >> block_mesh_shift_ao) & block_mesh_mask_ao; }
+		bool     IsFlipped()           const { return (GetRaw() >> block_mesh_shift_flip) & block_mesh_mask_flip; }
+	
+		void SetFace(uint8_t f)        { ModifyBits(f, block_mesh_shift_face,         block_mesh_mask_face); }
+		void SetRotation(uint8_t r)    { ModifyBits(r, block_mesh_shift_rotation,     block_mesh_mask_rotation); }
+		void SetZ(uint8_t z)           { ModifyBits(z, block_mesh_shift_position_z,   block_mesh_mask_position_z); }
+		void SetY(uint8_t y)           { ModifyBits(y, block_mesh_shift_position_y,   block_mesh_mask_position_y); }
+		void SetX(uint8_t x)           { ModifyBits(x, block_mesh_shift_position_x,   block_mesh_mask_position_x); }
+		void SetLayer(uint16_t l)      { ModifyBits(l, block_mesh_shift_layer,        block_mesh_mask_layer); }
+		void SetWidth(uint8_t w)       { ModifyBits(w - 1, block_mesh_shift_width,    block_mesh_mask_size); }
+		void SetHeight(uint8_t h)      { ModifyBits(h - 1, block_mesh_shift_height,   block_mesh_mask_size); }
+		void SetGeometry(BlockGeometryType g) { ModifyBits(static_cast<uint64_t>(g), block_mesh_shift_geometry, block_mesh_mask_geometry); }
+
+		/// Also picks the diagonal the face is split along, it connects the two brighter corners
+		/// so occlusion is interpolated the same way in both directions of the face
+		void SetAmbientOcclusion(uint8_t ao)
+		{
+			auto corner = [ao](uint32_t index) { return (ao >> (index * block_mesh_bits_for_ao_corner)) & block_mesh_mask_ao_corner; };
+
+			ModifyBits(ao, block_mesh_shift_ao, block_mesh_mask_ao);
+			ModifyBits(corner(1) + corner(3) < corner(0) + corner(2), block_mesh_shift_flip, block_mesh_mask_flip);
+		}
+	
+		void Set(uint8_t x, uint8_t y, uint8_t z, uint16_t layer, uint8_t face, uint8_t rot, uint8_t width = 1, uint8_t height = 1,
+			BlockGeometryType geometry = BlockGeometryType::Cube)
+		{
+			uint64_t raw = 0;
+			raw |= (uint64_t(face)  & block_mesh_mask_face)         << block_mesh_shift_face;
+			raw |= (uint64_t(rot)   & block_mesh_mask_rotation)     << block_mesh_shift_rotation;
+			raw |= (uint64_t(z)     & block_mesh_mask_position_z)   << block_mesh_shift_position_z;
+			raw |= (uint64_t(y)     & block_mesh_mask_position_y)   << block_mesh_shift_position_y;
+			raw |= (uint64_t(x)     & block_mesh_mask_position_x)   << block_mesh_shift_position_x;
+			raw |= (uint64_t(layer) & block_mesh_mask_layer)        << block_mesh_shift_layer;
+			raw |= (uint64_t(width  - 1) & block_mesh_mask_size)    << block_mesh_shift_width;
+			raw |= (uint64_t(height - 1) & block_mesh_mask_size)    << block_mesh_shift_height;
+			raw |= (uint64_t(geometry)   & block_mesh_mask_geometry) << block_mesh_shift_geometry;
+			SetRaw(raw);
+		}
+	
+	private:
+		void ModifyBits(uint64_t value, uint32_t shift, uint64_t mask)
+		{
+			uint64_t raw = GetRaw();
+			raw = (raw & ~(mask << shift)) | ((value & mask) << shift);
+			SetRaw(raw);
+		}
+
+		uint64_t GetRaw() const
+		{
+			return (uint64_t(UpperBits) << 32) | LowerBits;
+		}
+
+		void SetRaw(uint64_t value) 
+		{
+			LowerBits = static_cast<uint32_t>(value & 0xFFFFFFFF);
+			UpperBits = static_cast<uint32_t>(value >> 32);
+		}
+	};
+
+	static_assert(sizeof(BlockMesh) == 8, "BlockMesh should stay 8 bytes per face!");
+
+}
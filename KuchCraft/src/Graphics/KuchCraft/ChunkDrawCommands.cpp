@@ -0,0 +1,47 @@
+#include "kcpch.h"
+#include "Graphics/KuchCraft/ChunkDrawCommands.h"
+
+#include "Graphics/KuchCraft/BlockMesh.h"
+
+namespace KuchCraft {
+
+	void ChunkDrawCommandBuilder::Clear()
+	{
+		m_Commands.clear();
+		m_DrawData.clear();
+
+		m_BatchFirst    = 0;
+		m_InstanceCount = 0;
+		m_MergedCount   = 0;
+	}
+
+	uint32_t ChunkDrawCommandBuilder::BeginBatch()
+	{
+		m_BatchFirst = GetCommandCount();
+		return m_BatchFirst;
+	}
+
+	void ChunkDrawCommandBuilder::Add(const glm::vec3& origin, float lodScale, uint32_t first, uint32_t count)
+	{
+		if (count == 0)
+			return;
+
+		m_InstanceCount += count;
+
+		if (GetBatchSize() > 0)
+		{
+			DrawArraysIndirectCommand& previous     = m_Commands.back();
+			const ChunkDrawData&       previousData = m_DrawData.back();
+			if (previous.BaseInstance + previous.InstanceCount == first && previousData.Origin == origin && previousData.LodScale == lodScale)
+			{
+				previous.InstanceCount += count;
+				m_MergedCount++;
+				return;
+			}
+		}
+
+		m_Commands.push_back({ block_vertices_per_face, count, 0, first });
+		m_DrawData.push_back({ origin, lodScale });
+	}
+
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include "Graphics/Core/IndirectBuffer.h"
+
+namespace KuchCraft {
+
+	/// Read by the chunk shader with gl_DrawID, matches one vec4 of a std430 array
+	struct ChunkDrawData
+	{
+		glm::vec3 Origin   = { 0.0f, 0.0f, 0.0f };
+		/// Blocks per cell of the drawn LOD level
+		float     LodScale = 1.0f;
+	};
+
+	static_assert(sizeof(ChunkDrawData) == 4 * sizeof(float), "Chunk draw data must match a std430 vec4!");
+
+	/// Commands of all visible chunk sections, drawn in a few multi draw indirect calls.
+	/// Command i of a batch reads draw data `GetBatchFirst() + gl_DrawID`, faces are read from the chunk buffer from BaseInstance.
+	/// Commands of the same origin whose faces follow each other in the chunk buffer are merged.
+	/// Does not touch OpenGL, the arrays are uploaded by the renderer
+	class ChunkDrawCommandBuilder
+	{
+	public:
+		void Clear();
+
+		/// Commands of the new batch are never merged with earlier ones. Returns index of its first command
+		uint32_t BeginBatch();
+
+		/// `first` and `count` are in faces of the chunk buffer, empty ranges are skipped
+		void Add(const glm::vec3& origin, float lodScale, uint32_t first, uint32_t count);
+
+		const std::vector<DrawArraysIndirectCommand>& GetCommands() const { return m_Commands; }
+		const std::vector<ChunkDrawData>&             GetDrawData() const { return m_DrawData; }
+
+		uint32_t GetCommandCount() const { return static_cast<uint32_t>(m_Commands.size()); }
+		/// Commands added since the last BeginBatch
+		uint32_t GetBatchSize()    const { return GetCommandCount() - m_BatchFirst; }
+		uint32_t GetBatchFirst()   const { return m_BatchFirst; }
+		/// Faces of all commands
+		uint32_t GetInstanceCount() const { return m_InstanceCount; }
+		/// Ranges that were added to an existing command instead of making a new one
+		uint32_t GetMergedCount()   const { return m_MergedCount; }
+
+	private:
+		std::vector<DrawArraysIndirectCommand> m_Commands;
+		std::vector<ChunkDrawData>             m_DrawData;
+
+		uint32_t m_BatchFirst    = 0;
+		uint32_t m_InstanceCount = 0;
+		uint32_t m_MergedCount   = 0;
+	};
+
+}
@@ -2,7 +2,6 @@
 #include "Graphics/KuchCraft/ChunkMesh.h"
 
 #include "KuchCraft/World/Chunk.h"
-#include "KuchCraft/World/World.h"
 
 namespace KuchCraft {
 
@@ -14,8 +13,293 @@ namespace KuchCraft {
 
 	ChunkMesh::~ChunkMesh()
 	{
+		MeshBufferPool& pool = MeshBufferPool::Get();
+		for (auto& buffers : m_Sections)
+		{
+			for (auto& slot : buffers.Slots)
+			{
+				for (auto& buffer : slot.Buffers)
+					pool.Release(buffer);
+			}
+		}
+
+		for (auto& level : m_LodSections)
+		{
+			for (auto& section : level)
+			{
+				for (auto& buffer : section.Buffers)
+					pool.Release(buffer);
+			}
+		}
 	}
 	
+	/// Opacity rows run along x and are padded with one block from each neighbor, bit 0 is x = -1
+	using SectionRow = uint32_t;
+
+	constexpr uint32_t padded_section_size  = section_size_x + 2;
+	constexpr uint32_t padded_section_count = padded_section_size * padded_section_size * padded_section_size;
+	constexpr SectionRow section_row_inner  = ((SectionRow(1) << section_size_x) - 1) << 1;
+
+	constexpr int padded_stride_z = padded_section_size;
+	constexpr int padded_stride_y = padded_section_size * padded_section_size;
+
+	static_assert(section_size_x == section_size_y && section_size_y == section_size_z, "Bitmask mesher expects cubic sections!");
+	static_assert(padded_section_size <= sizeof(SectionRow) * 8, "Padded section row does not fit in SectionRow!");
+
+	/// Sections bordering the meshed one, nullptr where there is no data.
+	/// Side chunks that are not generated yet and the world bottom hide faces, above the chunk is air
+	struct SectionNeighbors
+	{
+		const ChunkSection* Center = nullptr;
+		const ChunkSection* Left   = nullptr;
+		const ChunkSection* Right  = nullptr;
+		const ChunkSection* Back   = nullptr;
+		const ChunkSection* Front  = nullptr;
+		const ChunkSection* Below  = nullptr;
+		const ChunkSection* Above  = nullptr;
+
+		/// Sections touching the meshed one only along an edge or at a corner, filled only when ambient occlusion is baked.
+		/// Indexed [dy + 1][dz + 1][dx + 1], entries of the center and its 6 face neighbors stay nullptr
+		const ChunkSection* Diagonal[3][3][3] = {};
+	};
+
+	/// Copy of a section with a one block halo from its 6 neighbors, so meshing reads only this buffer.
+	/// Halo of a missing neighbor is air, faces towards it are hidden through the Missing flags
+	struct PaddedSection
+	{
+		std::array<Block, padded_section_count> Blocks;
+
+		bool MissingLeft  = false;
+		bool MissingRight = false;
+		bool MissingBack  = false;
+		bool MissingFront = false;
+		bool MissingBelow = false;
+
+		/// x, y, z in [-1, section_size]
+		static KC_FORCE_INLINE int Index(int x, int y, int z) { return (y + 1) * padded_stride_y + (z + 1) * padded_stride_z + (x + 1); }
+
+		Block Get(int x, int y, int z) const { return Blocks[Index(x, y, z)]; }
+	};
+
+	struct SectionMasks
+	{
+		/// Blocks that hide every neighbor face touching them. Indexed [y + 1][z + 1], includes the one block border
+		SectionRow Opaque[padded_section_size][padded_section_size] = {};
+		/// Shapes that hide only the top face of the block below, indexed like Opaque. Filled for the section and the row above it
+		SectionRow OccludesBelow[padded_section_size][padded_section_size] = {};
+		/// Cubes that produce faces, indexed [y][z]
+		SectionRow Visible[section_size_y][section_size_z] = {};
+		/// Visible cubes that hide faces towards the same block, indexed [y][z]
+		SectionRow Transparent[section_size_y][section_size_z] = {};
+		/// Visible blocks of any other geometry, meshed by their own emitter, indexed [y][z]
+		SectionRow Shaped[section_size_y][section_size_z] = {};
+		/// Blocks that darken corners of faces next to them, indexed like Opaque but with every bit, edge and corner filled.
+		/// Missing neighbors are air here. Only built when ambient occlusion is baked
+		SectionRow Occluders[padded_section_size][padded_section_size] = {};
+	};
+
+	static KC_FORCE_INLINE SectionRow RowBit(int x)
+	{
+		return SectionRow(1) << (x + 1);
+	}
+
+	/// Opaque rows of the section itself, without the border
+	static SectionOpacity GetSectionOpacity(const SectionMasks& masks)
+	{
+		SectionOpacity opacity;
+		for (int y = 0; y < (int)section_size_y; y++)
+		{
+			for (int z = 0; z < (int)section_size_z; z++)
+				opacity[y][z] = static_cast<uint16_t>(masks.Opaque[y + 1][z + 1] >> 1);
+		}
+
+		return opacity;
+	}
+
+	static void CopySectionCenter(PaddedSection& padded, const ChunkSection& section)
+	{
+		const auto& blocks = section.GetBlocks();
+		for (int y = 0; y < (int)section_size_y; y++)
+		{
+			for (int z = 0; z < (int)section_size_z; z++)
+				std::copy_n(&blocks[(y * section_size_z + z) * section_size_x], section_size_x, &padded.Blocks[PaddedSection::Index(0, y, z)]);
+		}
+	}
+
+	/// Only copied for sections that have something to mesh, most sections above the terrain are empty
+	static void CopySectionHalo(PaddedSection& padded, const SectionNeighbors& neighbors)
+	{
+		constexpr int last_x = section_size_x - 1;
+		constexpr int last_y = section_size_y - 1;
+		constexpr int last_z = section_size_z - 1;
+
+		auto& blocks = padded.Blocks;
+		for (int y = 0; y < (int)section_size_y; y++)
+		{
+			for (int z = 0; z < (int)section_size_z; z++)
+			{
+				blocks[PaddedSection::Index(-1,             y, z)] = neighbors.Left  ? neighbors.Left ->GetBlock({ last_x, y, z }) : Block();
+				blocks[PaddedSection::Index(section_size_x, y, z)] = neighbors.Right ? neighbors.Right->GetBlock({ 0,      y, z }) : Block();
+			}
+
+			for (int x = 0; x < (int)section_size_x; x++)
+			{
+				blocks[PaddedSection::Index(x, y, -1)]             = neighbors.Back  ? neighbors.Back ->GetBlock({ x, y, last_z }) : Block();
+				blocks[PaddedSection::Index(x, y, section_size_z)] = neighbors.Front ? neighbors.Front->GetBlock({ x, y, 0 })      : Block();
+			}
+		}
+
+		for (int z = 0; z < (int)section_size_z; z++)
+		{
+			Block* below = &blocks[PaddedSection::Index(0, -1,             z)];
+			Block* above = &blocks[PaddedSection::Index(0, section_size_y, z)];
+
+			if (neighbors.Below)
+				std::copy_n(&neighbors.Below->GetBlocks()[(last_y * section_size_z + z) * section_size_x], section_size_x, below);
+			else
+				std::fill_n(below, section_size_x, Block());
+
+			if (neighbors.Above)
+				std::copy_n(&neighbors.Above->GetBlocks()[z * section_size_x], section_size_x, above);
+			else
+				std::fill_n(above, section_size_x, Block());
+		}
+
+		padded.MissingLeft  = !neighbors.Left;
+		padded.MissingRight = !neighbors.Right;
+		padded.MissingBack  = !neighbors.Back;
+		padded.MissingFront = !neighbors.Front;
+		padded.MissingBelow = !neighbors.Below;
+	}
+
+	/// Halo blocks outside of the 6 face neighbors, only read by ambient occlusion
+	static void CopySectionEdges(PaddedSection& padded, const SectionNeighbors& neighbors)
+	{
+		/// Padded coordinates covered by the neighbor in direction `d` along one axis
+		auto range = [](int d, int size) { return d < 0 ? glm::ivec2(-1, 0) : d > 0 ? glm::ivec2(size, size + 1) : glm::ivec2(0, size); };
+
+		for (int dy = -1; dy <= 1; dy++)
+		{
+			for (int dz = -1; dz <= 1; dz++)
+			{
+				for (int dx = -1; dx <= 1; dx++)
+				{
+					if (std::abs(dx) + std::abs(dy) + std::abs(dz) < 2)
+						continue;
+
+					const ChunkSection* section = neighbors.Diagonal[dy + 1][dz + 1][dx + 1];
+					const glm::ivec2 rangeY = range(dy, section_size_y);
+					const glm::ivec2 rangeZ = range(dz, section_size_z);
+					const glm::ivec2 rangeX = range(dx, section_size_x);
+
+					for (int y = rangeY.x; y < rangeY.y; y++)
+					{
+						for (int z = rangeZ.x; z < rangeZ.y; z++)
+						{
+							for (int x = rangeX.x; x < rangeX.y; x++)
+							{
+								const glm::ivec3 local = { x - dx * (int)section_size_x, y - dy * (int)section_size_y, z - dz * (int)section_size_z };
+								padded.Blocks[PaddedSection::Index(x, y, z)] = section ? section->GetBlock(local) : Block();
+							}
+						}
+					}
+				}
+			}
+		}
+	}
+
+	/// Masks of blocks inside the section, returns false if the section has nothing to mesh
+	static bool BuildCenterMasks(SectionMasks& masks, const PaddedSection& padded, const BlockPropertiesTable& properties)
+	{
+		SectionRow anyVisible = 0;
+		for (int y = 0; y < (int)section_size_y; y++)
+		{
+			for (int z = 0; z < (int)section_size_z; z++)
+			{
+				const Block* row = &padded.Blocks[PaddedSection::Index(0, y, z)];
+
+				SectionRow opaque = 0, below = 0, visible = 0, cube = 0, transparent = 0;
+				for (int x = 0; x < (int)section_size_x; x++)
+				{
+					const BlockProperties& blockProperties = properties[row[x].GetId()];
+					const SectionRow bit = RowBit(x);
+
+					opaque      |= blockProperties.OccludesNeighbors() ? bit : 0;
+					below       |= blockProperties.OccludesBelow()     ? bit : 0;
+					visible     |= blockProperties.IsVisible()         ? bit : 0;
+					cube        |= blockProperties.GeometryType == BlockGeometryType::Cube ? bit : 0;
+					transparent |= blockProperties.IsTransparent()     ? bit : 0;
+				}
+
+				masks.Opaque[y + 1][z + 1]        = opaque;
+				masks.OccludesBelow[y + 1][z + 1] = below;
+				masks.Visible[y][z]               = visible & cube;
+				masks.Transparent[y][z]           = visible & cube & transparent;
+				masks.Shaped[y][z]                = visible & ~cube;
+				anyVisible |= visible;
+			}
+		}
+
+		return anyVisible != 0;
+	}
+
+	/// Adds the one block border to the opacity masks, halo must be copied
+	static void BuildHaloMasks(SectionMasks& masks, const PaddedSection& padded, const BlockPropertiesTable& properties)
+	{
+		for (int y = 0; y < (int)section_size_y; y++)
+		{
+			for (int z = 0; z < (int)section_size_z; z++)
+			{
+				const bool left  = padded.MissingLeft  || properties[padded.Get(-1,             y, z).GetId()].OccludesNeighbors();
+				const bool right = padded.MissingRight || properties[padded.Get(section_size_x, y, z).GetId()].OccludesNeighbors();
+				masks.Opaque[y + 1][z + 1] |= (left ? RowBit(-1) : 0) | (right ? RowBit(section_size_x) : 0);
+			}
+		}
+
+		/// Rows outside of the section, only their inner bits are ever read
+		auto haloRow = [&](int y, int z, BlockPropertyFlags flag = BlockPropertyFlags::OccludesNeighbors) {
+			const Block* row = &padded.Blocks[PaddedSection::Index(0, y, z)];
+
+			SectionRow opaque = 0;
+			for (int x = 0; x < (int)section_size_x; x++)
+				opaque |= properties[row[x].GetId()].Has(flag) ? RowBit(x) : 0;
+
+			return opaque;
+		};
+
+		for (int y = 0; y < (int)section_size_y; y++)
+		{
+			masks.Opaque[y + 1][0]                       = padded.MissingBack  ? section_row_inner : haloRow(y, -1);
+			masks.Opaque[y + 1][padded_section_size - 1] = padded.MissingFront ? section_row_inner : haloRow(y, section_size_z);
+		}
+
+		for (int z = 0; z < (int)section_size_z; z++)
+		{
+			masks.Opaque[0][z + 1]                       = padded.MissingBelow ? section_row_inner : haloRow(-1, z);
+			masks.Opaque[padded_section_size - 1][z + 1] = haloRow(section_size_y, z);
+
+			masks.OccludesBelow[padded_section_size - 1][z + 1] = haloRow(section_size_y, z, BlockPropertyFlags::OccludesBelow);
+		}
+	}
+
+	/// Every bit of the padded section, halo and edges must be copied
+	static void BuildOccluderMasks(SectionMasks& masks, const PaddedSection& padded, const BlockPropertiesTable& properties)
+	{
+		for (int y = -1; y <= (int)section_size_y; y++)
+		{
+			for (int z = -1; z <= (int)section_size_z; z++)
+			{
+				const Block* row = &padded.Blocks[PaddedSection::Index(-1, y, z)];
+
+				SectionRow occluders = 0;
+				for (int x = 0; x < (int)padded_section_size; x++)
+					occluders |= properties[row[x].GetId()].OccludesNeighbors() ? SectionRow(1) << x : 0;
+
+				masks.Occluders[y + 1][z + 1] = occluders;
+			}
+		}
+	}
+
 	constexpr glm::ivec3 GetFaceOffset(BlockFace face) {
 		switch (face) {
 			case BlockFace::Right:  return { 1,  0,  0 };
@@ -28,147 +312,906 @@ namespace KuchCraft {
 		};
 	};
 
-	void ChunkMesh::Build()
+	/// Visible faces of one section, one row of bits per (y, z) like SectionMasks
+	struct SectionFaces
 	{
-		if (!m_Chunk)
-			return;
-		
-		m_MeshData.clear();
-		m_MeshData.reserve(block_count_per_chunk);
+		SectionRow Rows[block_face_count][section_size_y][section_size_z] = {};
+	};
 
-		Ref<ItemManager> itemManager = m_Chunk->m_World->GetItemManager();
+	constexpr int GetPaddedFaceOffset(BlockFace face)
+	{
+		const glm::ivec3 offset = GetFaceOffset(face);
+		return offset.x + offset.y * padded_stride_y + offset.z * padded_stride_z;
+	}
 
-		KC_TODO("Create map od offsets to have abbility to render only visible sections");
-		size_t sectionOffset = 0;
-		for (size_t sectionIndex = 0; sectionIndex < m_Chunk->GetSections().size(); sectionIndex++)
+	/// Returns number of visible faces
+	static uint32_t CullSectionFaces(SectionFaces& faces, const SectionMasks& masks, const PaddedSection& padded)
+	{
+		uint32_t faceCount = 0;
+		for (int y = 0; y < (int)section_size_y; y++)
 		{
-			const auto& section = m_Chunk->GetSection(sectionIndex);
-			for (uint32_t y = 0; y < section_size_y; y++)
+			for (int z = 0; z < (int)section_size_z; z++)
 			{
-				for (uint32_t z = 0; z < section_size_z; z++)
+				const SectionRow visible = masks.Visible[y][z];
+				if (!visible)
 				{
-					for (uint32_t x = 0; x < section_size_x; x++)
+					for (uint32_t i = 0; i < block_face_count; i++)
+						faces.Rows[i][y][z] = 0;
+					continue;
+				}
+
+				const SectionRow opaque = masks.Opaque[y + 1][z + 1];
+
+				/// A face is visible where the block is visible and the block behind the face is not opaque
+				SectionRow rows[block_face_count];
+				rows[(int)BlockFace::Right]  = visible & ~(opaque >> 1);
+				rows[(int)BlockFace::Left]   = visible & ~(opaque << 1);
+				rows[(int)BlockFace::Top]    = visible & ~(masks.Opaque[y + 2][z + 1] | masks.OccludesBelow[y + 2][z + 1]);
+				rows[(int)BlockFace::Bottom] = visible & ~masks.Opaque[y][z + 1];
+				rows[(int)BlockFace::Front]  = visible & ~masks.Opaque[y + 1][z + 2];
+				rows[(int)BlockFace::Back]   = visible & ~masks.Opaque[y + 1][z];
+
+				const SectionRow transparent = masks.Transparent[y][z];
+				for (uint32_t i = 0; i < block_face_count; i++)
+				{
+					const int offset = GetPaddedFaceOffset(static_cast<BlockFace>(i));
+
+					/// Faces between two cubes of the same transparent type (glass, leaves) are not visible
+					SectionRow candidates = rows[i] & transparent;
+					while (candidates)
 					{
-						glm::ivec3 inSectionPosition = { x, y, z };
-						glm::ivec3 inChunkPosition   = { inSectionPosition.x, inSectionPosition.y + sectionIndex * section_size_y, inSectionPosition.z};
-
-						Block     block     = section.GetBlock(inSectionPosition);
-						BlockData blockData = itemManager->GetBlockDataUnsafe(block.GetId());
-
-						KC_TODO("Check BlockGeometryType and handle it accordingly");
-						KC_TODO("Check if block is solid or has some flags to not render it");
-						if (block.IsAir() /* check for other flags or states from block data*/)
-							continue;
-						
-						for (uint32_t i = 0; i < block_face_count; i++)
-						{
-							BlockFace face = static_cast<BlockFace>(i);
+						const int x = std::countr_zero(candidates) - 1;
+						candidates &= candidates - 1;
 
-							const auto neighbor = GetNeighbor(inChunkPosition, inSectionPosition, face);
-							if (!neighbor.has_value())
-								continue;
+						const int index = PaddedSection::Index(x, y, z);
+						if (padded.Blocks[index + offset].GetId() == padded.Blocks[index].GetId())
+							rows[i] &= ~RowBit(x);
+					}
 
-							Block     neighborBlock     = neighbor.value();
-							BlockData neighborBlockData = itemManager->GetBlockDataUnsafe(neighborBlock.GetId());
-							if (!neighborBlock.IsAir() /* check for other flags or states */)
-								continue;
+					faces.Rows[i][y][z] = rows[i];
+					faceCount += std::popcount(rows[i]);
+				}
+			}
+		}
 
-							uint16_t layer = itemManager->GetBlockTextureLayer(block.GetId());
-							KC_TODO("Extract rotation from block data by stata or flags depending on block");
-							for (uint8_t vert = 0; vert < block_vertices_per_face; vert++)
-							{
-								BlockMesh mesh(inChunkPosition.x, inChunkPosition.y, inChunkPosition.z, layer, i, 0, vert);
-								m_MeshData.push_back(mesh);
-							}
-						}
+		return faceCount;
+	}
+
+	/// Corners of every face as signs of their offset from the block center, in corner order of ChunkMesh.glsl
+	constexpr glm::ivec3 block_face_corners[block_face_count][block_corners_per_face] = {
+		{ { -1, -1,  1 }, {  1, -1,  1 }, {  1,  1,  1 }, { -1,  1,  1 } }, /// Front
+		{ { -1, -1, -1 }, { -1, -1,  1 }, { -1,  1,  1 }, { -1,  1, -1 } }, /// Left
+		{ {  1, -1, -1 }, { -1, -1, -1 }, { -1,  1, -1 }, {  1,  1, -1 } }, /// Back
+		{ {  1, -1,  1 }, {  1, -1, -1 }, {  1,  1, -1 }, {  1,  1,  1 } }, /// Right
+		{ { -1,  1,  1 }, {  1,  1,  1 }, {  1,  1, -1 }, { -1,  1, -1 } }, /// Top
+		{ { -1, -1, -1 }, {  1, -1, -1 }, {  1, -1,  1 }, { -1, -1,  1 } }  /// Bottom
+	};
+
+	/// Occlusion levels of one face direction for a whole row of blocks, as two bit planes per corner
+	struct FaceOcclusionRow
+	{
+		SectionRow Low[block_corners_per_face]  = {};
+		SectionRow High[block_corners_per_face] = {};
+
+		/// Levels of the face of block `x`, packed like BlockMesh::GetAmbientOcclusion
+		uint8_t Get(int x) const
+		{
+			uint8_t ao = 0;
+			for (uint32_t corner = 0; corner < block_corners_per_face; corner++)
+			{
+				const uint32_t level = ((Low[corner] >> (x + 1)) & 1) | (((High[corner] >> (x + 1)) & 1) << 1);
+				ao |= level << (corner * block_mesh_bits_for_ao_corner);
+			}
+
+			return ao;
+		}
+	};
+
+	/// Row of occluders at `offset` from the blocks of row (y, z), bit x + 1 holds the occluder of block x
+	static KC_FORCE_INLINE SectionRow GetOccluderRow(const SectionMasks& masks, int y, int z, const glm::ivec3& offset)
+	{
+		const SectionRow row = masks.Occluders[y + 1 + offset.y][z + 1 + offset.z];
+		return offset.x < 0 ? row << 1 : offset.x > 0 ? row >> 1 : row;
+	}
+
+	/// Every corner is darkened by the two blocks next to it along the face edges and the block diagonal to it,
+	/// all in the layer in front of the face. With both edge blocks present the corner is fully occluded
+	static FaceOcclusionRow ComputeFaceOcclusion(const SectionMasks& masks, BlockFace face, int y, int z)
+	{
+		const glm::ivec3 normal = GetFaceOffset(face);
+
+		/// Axes in the plane of the face
+		int tangentA = -1, tangentB = -1;
+		for (int axis = 0; axis < 3; axis++)
+		{
+			if (normal[axis] == 0)
+				(tangentA < 0 ? tangentA : tangentB) = axis;
+		}
+
+		FaceOcclusionRow result;
+		for (uint32_t corner = 0; corner < block_corners_per_face; corner++)
+		{
+			const glm::ivec3& sign = block_face_corners[static_cast<size_t>(face)][corner];
+
+			glm::ivec3 sideA = normal, sideB = normal;
+			sideA[tangentA] = sign[tangentA];
+			sideB[tangentB] = sign[tangentB];
+			const glm::ivec3 diagonal = sideA + sideB - normal;
 
+			const SectionRow a = GetOccluderRow(masks, y, z, sideA);
+			const SectionRow b = GetOccluderRow(masks, y, z, sideB);
+			const SectionRow c = GetOccluderRow(masks, y, z, diagonal);
+
+			/// Count of occluders as two bits, raised to 3 where both sides are occluded
+			const SectionRow bothSides = a & b;
+			result.Low[corner]  = (a ^ b ^ c) | bothSides;
+			result.High[corner] = bothSides | (c & (a | b));
+		}
+
+		return result;
+	}
+
+	/// Every corner has the same level, such faces can be stretched over a larger quad without changing their shading
+	constexpr bool IsUniformOcclusion(uint8_t ao)
+	{
+		return ao == (ao & block_mesh_mask_ao_corner) * 0x55;
+	}
+
+	using BucketScratch = std::array<std::vector<BlockMesh>, chunk_mesh_bucket_count>;
+
+	/// Texture rotation of the faces of `block`, shared by every emitter of cube faces
+	static KC_FORCE_INLINE uint8_t GetFaceRotation(Block block)
+	{
+		KC_TODO("Extract rotation from block data by stata or flags depending on block");
+		return 0;
+	}
+
+	static void EmitFaces(BucketScratch& out, const SectionFaces& faces, const SectionMasks& masks, const PaddedSection& padded,
+		const BlockPropertiesTable& properties, uint32_t sectionY, bool ambientOcclusion)
+	{
+		for (int y = 0; y < (int)section_size_y; y++)
+		{
+			for (int z = 0; z < (int)section_size_z; z++)
+			{
+				for (uint32_t i = 0; i < block_face_count; i++)
+				{
+					SectionRow bits = faces.Rows[i][y][z];
+					if (!bits)
+						continue;
+
+					const FaceOcclusionRow occlusion = ambientOcclusion ? ComputeFaceOcclusion(masks, static_cast<BlockFace>(i), y, z) : FaceOcclusionRow();
+					while (bits)
+					{
+						const int x = std::countr_zero(bits) - 1;
+						bits &= bits - 1;
+
+						const Block            block           = padded.Get(x, y, z);
+						const BlockProperties& blockProperties = properties[block.GetId()];
+
+						out[static_cast<size_t>(GetChunkMeshBucket(blockProperties))].emplace_back(x, sectionY + y, z, blockProperties.TextureLayer, i, GetFaceRotation(block))
+							.SetAmbientOcclusion(occlusion.Get(x));
 					}
 				}
 			}
 		}
 	}
 
-	std::optional<Block> ChunkMesh::GetNeighbor(const glm::ivec3& inChunkPosition, const glm::ivec3& inSectionPosition, BlockFace face)
+	/// Axis along the face normal, faces are merged in the plane of the other two axes:
+	/// width runs along z for x faces and along x otherwise, height runs along y for x and z faces and along z for y faces
+	constexpr int GetFaceNormalAxis(BlockFace face)
 	{
-		glm::ivec3 neighborPos = inChunkPosition + GetFaceOffset(face);
 		switch (face)
 		{
 			case BlockFace::Right:
+			case BlockFace::Left:   return 0;
+			case BlockFace::Top:
+			case BlockFace::Bottom: return 1;
+			default:                return 2;
+		}
+	}
+
+	/// Greedy merge key, faces merge only with the same texture layer, ambient occlusion and rotation in the same bucket
+	constexpr uint32_t greedy_key_shift_bucket   = block_mesh_bits_for_layer + 1;
+	constexpr uint32_t greedy_key_shift_ao       = greedy_key_shift_bucket + std::bit_width(chunk_mesh_bucket_count - 1);
+	constexpr uint32_t greedy_key_shift_rotation = greedy_key_shift_ao + block_mesh_bits_for_ao;
+	constexpr uint32_t greedy_key_mask_layer     = BIT(greedy_key_shift_bucket) - 1;
+	constexpr uint32_t greedy_key_mask_bucket    = BIT(greedy_key_shift_ao - greedy_key_shift_bucket) - 1;
+	constexpr uint32_t greedy_key_mask_ao        = BIT(block_mesh_bits_for_ao) - 1;
+
+	static_assert(greedy_key_shift_rotation + block_mesh_bits_for_rotation <= 32, "Greedy merge key does not fit in 32 bits!");
+
+	/// Merge keys of one face direction, indexed [slice][v][u] with slices along the face normal, 0 where there is no face
+	using GreedyKeys = uint32_t[section_size_x][section_size_x][section_size_x];
+
+	static uint32_t MakeGreedyKey(const BlockProperties& blockProperties, uint8_t ao, uint8_t rotation)
+	{
+		return (blockProperties.TextureLayer + 1) |
+			(static_cast<uint32_t>(GetChunkMeshBucket(blockProperties)) << greedy_key_shift_bucket) |
+			(static_cast<uint32_t>(ao) << greedy_key_shift_ao) |
+			(static_cast<uint32_t>(rotation) << greedy_key_shift_rotation);
+	}
+
+	/// Slices are cleared when they are first used, `usedSlices` has a bit per slice
+	static KC_FORCE_INLINE void AddGreedyKey(GreedyKeys& keys, uint32_t& usedSlices, int normalAxis, int x, int y, int z, uint32_t key)
+	{
+		int slice, u, v;
+		switch (normalAxis)
+		{
+			case 0:  slice = x; u = z; v = y; break;
+			case 1:  slice = y; u = x; v = z; break;
+			default: slice = z; u = x; v = y; break;
+		}
+
+		if (!(usedSlices & BIT(slice)))
+		{
+			std::memset(keys[slice], 0, sizeof(keys[slice]));
+			usedSlices |= BIT(slice);
+		}
+		keys[slice][v][u] = key;
+	}
+
+	/// Merges faces of `face` collected by AddGreedyKey into quads as wide and then as high as possible.
+	/// Positions are in the units of the keys, blocks for full meshes and cells for LOD meshes
+	static void EmitGreedySlices(BucketScratch& out, GreedyKeys& keys, uint32_t usedSlices, uint32_t face, uint32_t sectionY)
+	{
+		const int normalAxis = GetFaceNormalAxis(static_cast<BlockFace>(face));
+
+		while (usedSlices)
+		{
+			const int slice = std::countr_zero(usedSlices);
+			usedSlices &= usedSlices - 1;
+
+			auto& sliceKeys = keys[slice];
+			for (int v = 0; v < (int)section_size_x; v++)
+			{
+				for (int u = 0; u < (int)section_size_x; u++)
+				{
+					const uint32_t key = sliceKeys[v][u];
+					if (!key)
+						continue;
+
+					/// Occlusion is interpolated over the whole quad, so only evenly shaded faces are merged
+					const uint8_t ao        = static_cast<uint8_t>((key >> greedy_key_shift_ao) & greedy_key_mask_ao);
+					const bool    mergeable = IsUniformOcclusion(ao);
+
+					int width = 1;
+					while (mergeable && u + width < (int)section_size_x && sliceKeys[v][u + width] == key)
+						width++;
+
+					int height = 1;
+					for (; mergeable && v + height < (int)section_size_x; height++)
+					{
+						bool fullRow = true;
+						for (int k = 0; k < width && fullRow; k++)
+							fullRow = sliceKeys[v + height][u + k] == key;
+
+						if (!fullRow)
+							break;
+					}
+
+					for (int dv = 0; dv < height; dv++)
+						std::fill_n(&sliceKeys[v + dv][u], width, uint32_t(0));
+
+					int x, y, z;
+					switch (normalAxis)
+					{
+						case 0:  x = slice; z = u; y = v; break;
+						case 1:  y = slice; x = u; z = v; break;
+						default: z = slice; x = u; y = v; break;
+					}
+
+					const uint16_t layer    = (key & greedy_key_mask_layer) - 1;
+					const uint32_t bucket   = (key >> greedy_key_shift_bucket) & greedy_key_mask_bucket;
+					const uint8_t  rotation = static_cast<uint8_t>(key >> greedy_key_shift_rotation);
+
+					out[bucket].emplace_back(x, sectionY + y, z, layer, face, rotation, width, height).SetAmbientOcclusion(ao);
+
+					u += width - 1;
+				}
+			}
+		}
+	}
+
+	static void EmitGreedyQuads(BucketScratch& out, const SectionFaces& faces, const SectionMasks& masks, const PaddedSection& padded,
+		const BlockPropertiesTable& properties, uint32_t sectionY, bool ambientOcclusion)
+	{
+		static thread_local GreedyKeys s_Keys;
+
+		for (uint32_t i = 0; i < block_face_count; i++)
+		{
+			const int normalAxis = GetFaceNormalAxis(static_cast<BlockFace>(i));
+
+			uint32_t usedSlices = 0;
+			for (int y = 0; y < (int)section_size_y; y++)
 			{
-				if (neighborPos.x >= chunk_size_x) [[unlikely]]
+				for (int z = 0; z < (int)section_size_z; z++)
 				{
-					Ref<Chunk> rightChunk = m_Chunk->GetRightNeighbor();
-					if (!rightChunk || !rightChunk->IsBuilt())
-						return std::nullopt;
+					SectionRow bits = faces.Rows[i][y][z];
+					if (!bits)
+						continue;
 
-					return rightChunk->GetBlock({ 0, neighborPos.y, neighborPos.z });
+					const FaceOcclusionRow occlusion = ambientOcclusion ? ComputeFaceOcclusion(masks, static_cast<BlockFace>(i), y, z) : FaceOcclusionRow();
+					while (bits)
+					{
+						const int x = std::countr_zero(bits) - 1;
+						bits &= bits - 1;
+
+						const Block            block           = padded.Get(x, y, z);
+						const BlockProperties& blockProperties = properties[block.GetId()];
+						AddGreedyKey(s_Keys, usedSlices, normalAxis, x, y, z, MakeGreedyKey(blockProperties, occlusion.Get(x), GetFaceRotation(block)));
+					}
 				}
-				else [[likely]]
-					return m_Chunk->GetBlock(neighborPos);
 			}
-			case BlockFace::Left:
+
+			EmitGreedySlices(out, s_Keys, usedSlices, i, sectionY);
+		}
+	}
+
+	/// Faces of one block with non-cube geometry, specialized per geometry so cubes never go through this path.
+	/// Shapes are never merged. Returns number of emitted faces
+	template<BlockGeometryType Geometry>
+	static uint32_t EmitShape(BucketScratch& out, const SectionMasks& masks, const BlockProperties& blockProperties, int x, int y, int z, uint32_t sectionY)
+	{
+		auto& bucket = out[static_cast<size_t>(GetChunkMeshBucket(blockProperties))];
+		const size_t previousSize = bucket.size();
+
+		auto occluded = [&](BlockFace face) {
+			const glm::ivec3 neighbor = glm::ivec3(x, y, z) + GetFaceOffset(face);
+			return (masks.Opaque[neighbor.y + 1][neighbor.z + 1] & RowBit(neighbor.x)) != 0;
+		};
+		auto emit = [&](uint8_t face) {
+			bucket.emplace_back(x, sectionY + y, z, blockProperties.TextureLayer, face, 0, 1, 1, Geometry);
+		};
+
+		if constexpr (Geometry == BlockGeometryType::Slab)
+		{
+			/// Lower half of the block, its top face is inside the block and is never hidden
+			for (uint8_t face = 0; face < block_face_count; face++)
 			{
-				if (neighborPos.x < 0) [[unlikely]]
+				if (face == static_cast<uint8_t>(BlockFace::Top) || !occluded(static_cast<BlockFace>(face)))
+					emit(face);
+			}
+		}
+		else if constexpr (Geometry == BlockGeometryType::Cross)
+		{
+			/// Two diagonal quads, each drawn from both sides so back face culling stays on
+			for (uint8_t face = 0; face < block_cross_face_count; face++)
+				emit(face);
+		}
+		else if constexpr (Geometry == BlockGeometryType::Plane)
+		{
+			/// Thin horizontal quad lying on the block below
+			emit(static_cast<uint8_t>(BlockFace::Top));
+			if (!occluded(BlockFace::Bottom))
+				emit(static_cast<uint8_t>(BlockFace::Bottom));
+		}
+
+		return static_cast<uint32_t>(bucket.size() - previousSize);
+	}
+
+	/// Returns number of emitted faces
+	static uint32_t EmitShapedBlocks(BucketScratch& out, const SectionMasks& masks, const PaddedSection& padded, const BlockPropertiesTable& properties, uint32_t sectionY)
+	{
+		uint32_t faceCount = 0;
+		for (int y = 0; y < (int)section_size_y; y++)
+		{
+			for (int z = 0; z < (int)section_size_z; z++)
+			{
+				SectionRow bits = masks.Shaped[y][z];
+				while (bits)
 				{
-					Ref<Chunk> leftChunk = m_Chunk->GetLeftNeighbor();
-					if (!leftChunk || !leftChunk->IsBuilt())
-						return std::nullopt;
+					const int x = std::countr_zero(bits) - 1;
+					bits &= bits - 1;
+
+					const BlockProperties& blockProperties = properties[padded.Get(x, y, z).GetId()];
+					switch (blockProperties.GeometryType)
+					{
+						case BlockGeometryType::Slab:  faceCount += EmitShape<BlockGeometryType::Slab> (out, masks, blockProperties, x, y, z, sectionY); break;
+						case BlockGeometryType::Cross: faceCount += EmitShape<BlockGeometryType::Cross>(out, masks, blockProperties, x, y, z, sectionY); break;
+						case BlockGeometryType::Plane: faceCount += EmitShape<BlockGeometryType::Plane>(out, masks, blockProperties, x, y, z, sectionY); break;
+						default: break;
+					}
+				}
+			}
+		}
+
+		return faceCount;
+	}
+
+	ChunkMeshNeighbors ChunkMeshNeighbors::Resolve(const Chunk& chunk, bool diagonals)
+	{
+		/// Side neighbors that are not generated yet hide border faces, the mesh is rebuilt once they are
+		auto getBuilt = [](Ref<Chunk> neighbor) {
+			return neighbor && neighbor->IsBuilt() ? neighbor : nullptr;
+		};
+
+		ChunkMeshNeighbors neighbors;
+		neighbors.Columns[0][1] = getBuilt(chunk.GetBackNeighbor());
+		neighbors.Columns[1][0] = getBuilt(chunk.GetLeftNeighbor());
+		neighbors.Columns[1][2] = getBuilt(chunk.GetRightNeighbor());
+		neighbors.Columns[2][1] = getBuilt(chunk.GetFrontNeighbor());
+		if (diagonals)
+		{
+			neighbors.Columns[0][0] = getBuilt(chunk.GetNeighbor(-1, -1));
+			neighbors.Columns[0][2] = getBuilt(chunk.GetNeighbor( 1, -1));
+			neighbors.Columns[2][0] = getBuilt(chunk.GetNeighbor(-1,  1));
+			neighbors.Columns[2][2] = getBuilt(chunk.GetNeighbor( 1,  1));
+		}
+
+		return neighbors;
+	}
+
+	void ChunkMesh::Build(const BlockPropertiesTable& properties, const ChunkMeshSettings& settings, const ChunkMeshNeighbors& neighbors)
+	{
+		BuildSections(properties, settings, neighbors, false);
+	}
+
+	uint32_t ChunkMesh::Update(const BlockPropertiesTable& properties, const ChunkMeshSettings& settings, const ChunkMeshNeighbors& neighbors)
+	{
+		return BuildSections(properties, settings, neighbors, true);
+	}
+
+	uint32_t ChunkMesh::BuildSections(const BlockPropertiesTable& properties, const ChunkMeshSettings& settings, const ChunkMeshNeighbors& chunkNeighbors, bool onlyDirty)
+	{
+		if (!m_Chunk)
+			return 0;
+
+		if (m_Building.exchange(true, std::memory_order_acquire))
+			return 0;
+
+		const uint32_t generation = m_Generation.load(std::memory_order_acquire);
+
+		const Chunk* left  = chunkNeighbors.Columns[1][0].get();
+		const Chunk* right = chunkNeighbors.Columns[1][2].get();
+		const Chunk* back  = chunkNeighbors.Columns[0][1].get();
+		const Chunk* front = chunkNeighbors.Columns[2][1].get();
+
+		/// Chunk columns around this one indexed [dz + 1][dx + 1], diagonal ones are only needed by ambient occlusion
+		const Chunk* columns[3][3] = {
+			{ nullptr, back,    nullptr },
+			{ left,    m_Chunk, right   },
+			{ nullptr, front,   nullptr }
+		};
+		if (settings.AmbientOcclusion)
+		{
+			columns[0][0] = chunkNeighbors.Columns[0][0].get();
+			columns[0][2] = chunkNeighbors.Columns[0][2].get();
+			columns[2][0] = chunkNeighbors.Columns[2][0].get();
+			columns[2][2] = chunkNeighbors.Columns[2][2].get();
+		}
+
+		/// Every thread meshing chunks keeps its own copy, meshing never reads chunk data after the copy
+		static thread_local PaddedSection s_Padded;
+		/// Meshes are emitted here and only their exact size is copied into the pool, capacity never shrinks
+		static thread_local BucketScratch s_Scratch;
+		for (auto& scratch : s_Scratch)
+		{
+			if (scratch.capacity() < mesh_buffer_max_size)
+				scratch.reserve(mesh_buffer_max_size);
+		}
+
+		MeshBufferPool& pool = MeshBufferPool::Get();
+
+		SectionMasks masks;
+		SectionFaces faces;
+
+		uint32_t built = 0;
+		for (size_t sectionIndex = 0; sectionIndex < sections_per_chunk; sectionIndex++)
+		{
+			ChunkSection& section = m_Chunk->m_Sections[sectionIndex];
+			/// Cleared before the blocks are copied, a block set during the copy marks the section again
+			const bool dirty = section.m_NeedsMeshUpdate.exchange(false, std::memory_order_acquire);
+			if (onlyDirty && !dirty)
+				continue;
+
+			built |= BIT(sectionIndex);
+
+			SectionMeshBuffers& buffers = m_Sections[sectionIndex];
+			SectionMesh& sectionMesh = buffers.Slots[buffers.Back];
+			sectionMesh.FaceCount    = 0;
+			sectionMesh.Connectivity = section_connectivity_all;
+
+			SectionNeighbors neighbors;
+			neighbors.Center = &section;
+			neighbors.Left   = left  ? &left ->GetSection(sectionIndex) : nullptr;
+			neighbors.Right  = right ? &right->GetSection(sectionIndex) : nullptr;
+			neighbors.Back   = back  ? &back ->GetSection(sectionIndex) : nullptr;
+			neighbors.Front  = front ? &front->GetSection(sectionIndex) : nullptr;
+			neighbors.Below  = sectionIndex > 0                      ? &m_Chunk->GetSection(sectionIndex - 1) : nullptr;
+			neighbors.Above  = sectionIndex + 1 < sections_per_chunk ? &m_Chunk->GetSection(sectionIndex + 1) : nullptr;
 
-					return leftChunk->GetBlock({ chunk_size_x - 1, neighborPos.y, neighborPos.z });
+			if (settings.AmbientOcclusion)
+			{
+				for (int dy = -1; dy <= 1; dy++)
+				{
+					const int index = static_cast<int>(sectionIndex) + dy;
+					for (int dz = -1; dz <= 1; dz++)
+					{
+						for (int dx = -1; dx <= 1; dx++)
+						{
+							const Chunk* column = columns[dz + 1][dx + 1];
+							const bool diagonal = std::abs(dx) + std::abs(dy) + std::abs(dz) >= 2;
+							neighbors.Diagonal[dy + 1][dz + 1][dx + 1] = diagonal && column && index >= 0 && index < (int)sections_per_chunk ? &column->GetSection(index) : nullptr;
+						}
+					}
 				}
-				else [[likely]]
-					return m_Chunk->GetBlock(neighborPos);
 			}
-			case BlockFace::Front:
+
+			for (auto& scratch : s_Scratch)
+				scratch.clear();
+
+			CopySectionCenter(s_Padded, section);
+			if (BuildCenterMasks(masks, s_Padded, properties))
 			{
-				if (neighborPos.z >= chunk_size_z) [[unlikely]]
+				CopySectionHalo(s_Padded, neighbors);
+				BuildHaloMasks(masks, s_Padded, properties);
+				sectionMesh.Connectivity = ComputeSectionConnectivity(GetSectionOpacity(masks));
+
+				if (settings.AmbientOcclusion)
 				{
-					Ref<Chunk> frontChunk = m_Chunk->GetFrontNeighbor();
-					if (!frontChunk || !frontChunk->IsBuilt())
-						return std::nullopt;
+					CopySectionEdges(s_Padded, neighbors);
+					BuildOccluderMasks(masks, s_Padded, properties);
+				}
 
-					return frontChunk->GetBlock({ neighborPos.x, neighborPos.y, 0 });
+				const uint32_t sectionY = sectionIndex * section_size_y;
+
+				sectionMesh.FaceCount = CullSectionFaces(faces, masks, s_Padded);
+				if (sectionMesh.FaceCount > 0)
+				{
+					if (settings.Greedy)
+						EmitGreedyQuads(s_Scratch, faces, masks, s_Padded, properties, sectionY, settings.AmbientOcclusion);
+					else
+						EmitFaces(s_Scratch, faces, masks, s_Padded, properties, sectionY, settings.AmbientOcclusion);
 				}
-				else [[likely]]
-					return m_Chunk->GetBlock(neighborPos);
+
+				sectionMesh.FaceCount += EmitShapedBlocks(s_Scratch, masks, s_Padded, properties, sectionY);
 			}
-			case BlockFace::Back:
+
+			/// Empty buckets give their buffer back
+			for (size_t bucket = 0; bucket < chunk_mesh_bucket_count; bucket++)
+				pool.Assign(sectionMesh.Buffers[bucket], s_Scratch[bucket].data(), static_cast<uint32_t>(s_Scratch[bucket].size()));
+		}
+
+		const bool stale = generation != m_Generation.load(std::memory_order_acquire);
+		for (uint32_t bits = built; bits; bits &= bits - 1)
+		{
+			const int sectionIndex = std::countr_zero(bits);
+			if (stale)
+			{
+				/// Built from data that changed meanwhile, the section is built again by the next update
+				m_Chunk->m_Sections[sectionIndex].MarkMeshUpdate();
+				continue;
+			}
+
+			SectionMeshBuffers& buffers = m_Sections[sectionIndex];
+			const uint8_t previous = buffers.Ready.exchange(buffers.Back | section_mesh_fresh_bit, std::memory_order_acq_rel);
+			buffers.Back = previous & section_mesh_slot_mask;
+		}
+
+		m_Building.store(false, std::memory_order_release);
+
+		return std::popcount(built);
+	}
+
+	bool ChunkMesh::SwapBuffers()
+	{
+		bool swapped = false;
+		for (size_t i = 0; i < sections_per_chunk; i++)
+		{
+			SectionMeshBuffers& buffers = m_Sections[i];
+			if (!(buffers.Ready.load(std::memory_order_acquire) & section_mesh_fresh_bit))
+				continue;
+
+			const uint8_t previous = buffers.Ready.exchange(buffers.Front, std::memory_order_acq_rel);
+			buffers.Front = previous & section_mesh_slot_mask;
+			swapped = true;
+
+			m_UnsortedSections |= BIT(i);
+		}
+
+		if (!swapped)
+			return false;
+
+		/// LOD meshes are rebuilt from the new blocks the next time they are drawn
+		m_LodDirty = ~0u;
+
+		m_QuadCount = 0;
+		m_FaceCount = 0;
+		m_TranslucentSections = 0;
+		for (size_t i = 0; i < sections_per_chunk; i++)
+		{
+			const SectionMesh& sectionMesh = GetSectionMesh(i);
+			m_QuadCount += sectionMesh.GetQuadCount();
+			m_FaceCount += sectionMesh.FaceCount;
+
+			if (!sectionMesh.GetData(ChunkMeshBucket::Translucent).empty())
+				m_TranslucentSections |= BIT(i);
+		}
+		m_UnsortedSections &= m_TranslucentSections;
+
+		return true;
+	}
+
+	/// Level 1 of a whole chunk is the largest LOD grid
+	constexpr uint32_t lod_grid_max_count = block_count_per_chunk / 8;
+	constexpr uint32_t lod_cell_max_count = BIT(3 * (chunk_mesh_lod_count - 1));
+
+	/// Most common visible cube of the cell. Inside the chunk the cell is filled only when at least half of its blocks are cubes,
+	/// on the chunk border any cube fills it, so the LOD mesh never leaves a crack next to a neighbor drawn at another level
+	static ItemID DownsampleCell(const Chunk& chunk, const BlockPropertiesTable& properties, const glm::ivec3& origin, int scale, bool border)
+	{
+		std::array<ItemID,  lod_cell_max_count> ids;
+		std::array<uint8_t, lod_cell_max_count> counts;
+		int distinct = 0, filled = 0;
+
+		for (int y = 0; y < scale; y++)
+		{
+			for (int z = 0; z < scale; z++)
 			{
-				if (neighborPos.z < 0) [[unlikely]]
+				for (int x = 0; x < scale; x++)
 				{
-					Ref<Chunk> backChunk = m_Chunk->GetBackNeighbor();
-					if (!backChunk || !backChunk->IsBuilt())
-						return std::nullopt;
+					const ItemID id = chunk.GetBlock(origin + glm::ivec3(x, y, z)).GetId();
+					const BlockProperties& blockProperties = properties[id];
+					if (!blockProperties.IsVisible() || blockProperties.GeometryType != BlockGeometryType::Cube)
+						continue;
+
+					filled++;
 
-					return backChunk->GetBlock({ neighborPos.x, neighborPos.y, chunk_size_z - 1 });
+					int i = 0;
+					while (i < distinct && ids[i] != id)
+						i++;
+
+					if (i == distinct)
+					{
+						ids[distinct]    = id;
+						counts[distinct] = 0;
+						distinct++;
+					}
+					counts[i]++;
 				}
-				else [[likely]]
-					return m_Chunk->GetBlock(neighborPos);
 			}
-			case BlockFace::Bottom:
+		}
+
+		if (filled == 0 || (!border && filled * 2 < scale * scale * scale))
+			return block_type_air;
+
+		return ids[std::max_element(counts.begin(), counts.begin() + distinct) - counts.begin()];
+	}
+
+	/// Height above the highest visible cube of every block column of `neighbor` that touches this chunk across the side `offset`
+	/// points to, 0 for columns without cubes. Indexed along the side, by z for x sides and by x for z sides
+	static void GetNeighborSurface(const Chunk& neighbor, const glm::ivec3& offset, const BlockPropertiesTable& properties, std::array<int, chunk_size_x>& heights)
+	{
+		static_assert(chunk_size_x == chunk_size_z, "Chunk sides are expected to have the same length!");
+
+		for (int along = 0; along < (int)chunk_size_x; along++)
+		{
+			const int x = offset.x < 0 ? chunk_size_x - 1 : offset.x > 0 ? 0 : along;
+			const int z = offset.z < 0 ? chunk_size_z - 1 : offset.z > 0 ? 0 : along;
+
+			int y = chunk_size_y - 1;
+			for (; y >= 0; y--)
+			{
+				const BlockProperties& blockProperties = properties[neighbor.GetBlock({ x, y, z }).GetId()];
+				if (blockProperties.IsVisible() && blockProperties.GeometryType == BlockGeometryType::Cube)
+					break;
+			}
+			heights[along] = y + 1;
+		}
+	}
+
+	bool ChunkMesh::BuildLod(uint32_t level, const BlockPropertiesTable& properties)
+	{
+		KC_CORE_ASSERT(level > 0 && level < chunk_mesh_lod_count, "Invalid chunk mesh LOD level!");
+		if (!m_Chunk || !IsLodDirty(level))
+			return false;
+
+		const int scale = 1 << level;
+		const int sizeX = chunk_size_x / scale;
+		const int sizeY = chunk_size_y / scale;
+		const int sizeZ = chunk_size_z / scale;
+
+		static thread_local std::array<ItemID, lod_grid_max_count> s_Grid;
+		auto cell = [&](int x, int y, int z) -> ItemID& { return s_Grid[(y * sizeZ + z) * sizeX + x]; };
+
+		for (int y = 0; y < sizeY; y++)
+		{
+			for (int z = 0; z < sizeZ; z++)
 			{
-				if (neighborPos.y < 0) [[unlikely]]
+				for (int x = 0; x < sizeX; x++)
 				{
-					/// Player should never be able to see this face, bedrock is always at y = 0
-					return std::nullopt;
+					const bool border = x == 0 || z == 0 || x == sizeX - 1 || z == sizeZ - 1;
+					cell(x, y, z) = DownsampleCell(*m_Chunk, properties, glm::ivec3(x, y, z) * scale, scale, border);
 				}
-				else [[likely]]
-					return m_Chunk->GetBlock(neighborPos);
 			}
-			case BlockFace::Top:
+		}
+
+		/// Faces on the chunk sides are skirts that cover height differences against neighbors drawn at another level.
+		/// Border cells are filled by any cube, so a neighbor never draws its border below its surface and a side face is
+		/// only needed above the lowest neighbor surface it touches. Like full meshes, faces towards missing neighbors are hidden
+		std::array<std::array<int, chunk_size_x>, block_face_count> sideSurfaces;
+		uint32_t builtSides = 0;
+		for (uint32_t i = 0; i < block_face_count; i++)
+		{
+			const glm::ivec3 offset = GetFaceOffset(static_cast<BlockFace>(i));
+			if (offset.y != 0)
+				continue;
+
+			Ref<Chunk> neighbor = m_Chunk->GetNeighbor(offset.x, offset.z);
+			if (neighbor && neighbor->IsBuilt())
+			{
+				GetNeighborSurface(*neighbor, offset, properties, sideSurfaces[i]);
+				builtSides |= BIT(i);
+			}
+		}
+
+		auto isSkirtExposed = [&](uint32_t face, int x, int y, int z) {
+			if (!(builtSides & BIT(face)))
+				return false;
+
+			const int along = GetFaceNormalAxis(static_cast<BlockFace>(face)) == 0 ? z : x;
+			const int lowestSurface = *std::min_element(sideSurfaces[face].begin() + along * scale, sideSurfaces[face].begin() + (along + 1) * scale);
+			return (y + 1) * scale > lowestSurface;
+		};
+
+		static thread_local BucketScratch s_Scratch;
+		static thread_local GreedyKeys    s_Keys;
+		MeshBufferPool& pool = MeshBufferPool::Get();
+
+		auto& sections = m_LodSections[level - 1];
+		uint32_t& quadCount = m_LodQuadCounts[level - 1];
+		uint32_t& translucentSections = m_LodTranslucentSections[level - 1];
+		quadCount = 0;
+		translucentSections = 0;
+
+		const int cellsPerSection = section_size_y / scale;
+		for (size_t sectionIndex = 0; sectionIndex < sections_per_chunk; sectionIndex++)
+		{
+			for (auto& scratch : s_Scratch)
+				scratch.clear();
+
+			const int sectionY = (int)sectionIndex * cellsPerSection;
+			uint32_t faceCount = 0;
+
+			for (uint32_t i = 0; i < block_face_count; i++)
 			{
-				if (neighborPos.y >= chunk_size_y) [[unlikely]]
+				const glm::ivec3 offset = GetFaceOffset(static_cast<BlockFace>(i));
+				const int normalAxis = GetFaceNormalAxis(static_cast<BlockFace>(i));
+
+				uint32_t usedSlices = 0;
+				for (int y = 0; y < cellsPerSection; y++)
 				{
-					/// We treat the top face as air, so we return an empty block
-					return Block();
+					for (int z = 0; z < sizeZ; z++)
+					{
+						for (int x = 0; x < sizeX; x++)
+						{
+							const ItemID id = cell(x, sectionY + y, z);
+							if (id == block_type_air)
+								continue;
+
+							const glm::ivec3 neighbor = glm::ivec3(x, sectionY + y, z) + offset;
+							if (neighbor.y < 0)
+								continue;
+
+							const BlockProperties& blockProperties = properties[id];
+							if (neighbor.x < 0 || neighbor.z < 0 || neighbor.x >= sizeX || neighbor.z >= sizeZ)
+							{
+								if (!isSkirtExposed(i, x, sectionY + y, z))
+									continue;
+							}
+							else if (neighbor.y < sizeY)
+							{
+								const ItemID neighborId = cell(neighbor.x, neighbor.y, neighbor.z);
+								if (properties[neighborId].OccludesNeighbors() || (blockProperties.IsTransparent() && neighborId == id))
+									continue;
+							}
+
+							/// Cells keep only item ids, so LOD faces are never rotated
+							AddGreedyKey(s_Keys, usedSlices, normalAxis, x, y, z, MakeGreedyKey(blockProperties, 0, 0));
+							faceCount++;
+						}
+					}
 				}
-				else [[likely]]
-					return m_Chunk->GetBlock(neighborPos);
+
+				EmitGreedySlices(s_Scratch, s_Keys, usedSlices, i, sectionY);
 			}
+
+			SectionMesh& sectionMesh = sections[sectionIndex];
+			sectionMesh.FaceCount = faceCount;
+			for (size_t bucket = 0; bucket < chunk_mesh_bucket_count; bucket++)
+				pool.Assign(sectionMesh.Buffers[bucket], s_Scratch[bucket].data(), static_cast<uint32_t>(s_Scratch[bucket].size()));
+
+			quadCount += sectionMesh.GetQuadCount();
+			if (!sectionMesh.GetData(ChunkMeshBucket::Translucent).empty())
+				translucentSections |= BIT(sectionIndex);
 		}
 
-		return std::nullopt;
+		m_LodBuilt |=  BIT(level);
+		m_LodDirty &= ~BIT(level);
+
+		return true;
 	}
 
+	/// Center of the quad relative to the chunk, width and height axes match ChunkMesh.glsl
+	static glm::vec3 GetQuadCenter(const BlockMesh& quad)
+	{
+		if (quad.GetGeometry() == BlockGeometryType::Cross)
+			return glm::vec3(quad.GetX(), quad.GetY(), quad.GetZ()) + 0.5f;
+
+		const BlockFace face = static_cast<BlockFace>(quad.GetFace());
+		const bool xFace = face == BlockFace::Left || face == BlockFace::Right;
+		const bool yFace = face == BlockFace::Top  || face == BlockFace::Bottom;
+
+		const glm::vec3 widthAxis  = xFace ? glm::vec3(0.0f, 0.0f, 1.0f) : glm::vec3(1.0f, 0.0f, 0.0f);
+		const glm::vec3 heightAxis = yFace ? glm::vec3(0.0f, 0.0f, 1.0f) : glm::vec3(0.0f, 1.0f, 0.0f);
+
+		return glm::vec3(quad.GetX(), quad.GetY(), quad.GetZ()) + 0.5f + glm::vec3(GetFaceOffset(face)) * 0.5f +
+			widthAxis * ((quad.GetWidth() - 1) * 0.5f) + heightAxis * ((quad.GetHeight() - 1) * 0.5f);
+	}
+
+	/// Farthest quad first. With `fullSort` false the previous order is assumed to be nearly right
+	/// and insertion sort fixes it up in close to linear time
+	static void SortQuadsBackToFront(BlockMesh* quads, uint32_t count, const glm::vec3& cameraPosition, bool fullSort)
+	{
+		static thread_local std::vector<std::pair<float, BlockMesh>> s_Sorted;
+		s_Sorted.resize(count);
+		for (uint32_t i = 0; i < count; i++)
+			s_Sorted[i] = { glm::distance2(GetQuadCenter(quads[i]), cameraPosition), quads[i] };
+
+		if (fullSort)
+		{
+			std::sort(s_Sorted.begin(), s_Sorted.end(), [](const auto& a, const auto& b) { return a.first > b.first; });
+		}
+		else
+		{
+			for (uint32_t i = 1; i < count; i++)
+			{
+				const auto item = s_Sorted[i];
+
+				uint32_t j = i;
+				for (; j > 0 && s_Sorted[j - 1].first < item.first; j--)
+					s_Sorted[j] = s_Sorted[j - 1];
+
+				s_Sorted[j] = item;
+			}
+		}
+
+		for (uint32_t i = 0; i < count; i++)
+			quads[i] = s_Sorted[i].second;
+	}
+
+	uint32_t ChunkMesh::SortTranslucentFaces(const glm::vec3& cameraPosition)
+	{
+		if (!m_TranslucentSections)
+			return 0;
+
+		const float distance2 = m_HasSortPosition ? glm::distance2(cameraPosition, m_SortPosition) : std::numeric_limits<float>::max();
+		const bool  moved     = distance2 > translucent_sort_distance * translucent_sort_distance;
+		const bool  jumped    = distance2 > translucent_sort_full_distance * translucent_sort_full_distance;
+
+		const uint32_t sections = moved ? m_TranslucentSections : m_UnsortedSections;
+		if (!sections)
+			return 0;
+
+		const glm::vec3 localCamera = cameraPosition - m_GlobalPosition;
+		for (uint32_t bits = sections; bits; bits &= bits - 1)
+		{
+			const int sectionIndex = std::countr_zero(bits);
+
+			SectionMeshBuffers& buffers = m_Sections[sectionIndex];
+			MeshBuffer& buffer = buffers.Slots[buffers.Front].Buffers[static_cast<size_t>(ChunkMeshBucket::Translucent)];
+			SortQuadsBackToFront(buffer.Data, buffer.Size, localCamera, jumped || (m_UnsortedSections & BIT(sectionIndex)));
+			MeshBufferPool::Get().Touch(buffer);
+		}
+
+		if (moved)
+		{
+			m_SortPosition    = cameraPosition;
+			m_HasSortPosition = true;
+		}
+		m_UnsortedSections = 0;
+
+		return std::popcount(sections);
+	}
 
-} 
\ No newline at end of file
+}
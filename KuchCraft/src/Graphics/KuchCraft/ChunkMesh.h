@@ -3,126 +3,188 @@
 #include "KuchCraft/World/WorldCore.h"
 
 #include "KuchCraft/World/Block.h"
+#include "Graphics/KuchCraft/MeshBufferPool.h"
+#include "Graphics/KuchCraft/SectionVisibility.h"
 
 namespace KuchCraft {
 
 	class Chunk;
 
-	constexpr uint32_t block_mesh_bits_for_layer = block_bits_for_id;
-	constexpr uint32_t block_mesh_bits_for_position_x = std::bit_width(chunk_size_x - 1);
-	constexpr uint32_t block_mesh_bits_for_position_y = std::bit_width(chunk_size_y - 1);
-	constexpr uint32_t block_mesh_bits_for_position_z = std::bit_width(chunk_size_z - 1);
-	constexpr uint32_t block_mesh_bits_for_rotation     = 2;
-	constexpr uint32_t block_mesh_bits_for_face         = 3;
-	constexpr uint32_t block_mesh_bits_for_vertex_index = 3;
-
-	constexpr uint8_t  block_vertices_per_face = 4;
-	constexpr uint8_t  block_indicies_per_face = 6;
-
-	constexpr uint32_t block_mesh_total_bits = block_mesh_bits_for_vertex_index + block_mesh_bits_for_face +
-		block_mesh_bits_for_rotation   + block_mesh_bits_for_position_z + block_mesh_bits_for_position_y +
-		block_mesh_bits_for_position_x + block_mesh_bits_for_layer;
-
-	static_assert(block_mesh_total_bits <= 64, "BlockMesh does not fit in 64 bits!");
-
-	constexpr uint32_t block_mesh_shift_vertex_index = 0;
-	constexpr uint32_t block_mesh_shift_face         = block_mesh_shift_vertex_index + block_mesh_bits_for_vertex_index;
-	constexpr uint32_t block_mesh_shift_rotation     = block_mesh_shift_face         + block_mesh_bits_for_face;
-	constexpr uint32_t block_mesh_shift_position_z   = block_mesh_shift_rotation     + block_mesh_bits_for_rotation;
-	constexpr uint32_t block_mesh_shift_position_y   = block_mesh_shift_position_z   + block_mesh_bits_for_position_z;
-	constexpr uint32_t block_mesh_shift_position_x   = block_mesh_shift_position_y   + block_mesh_bits_for_position_y;
-	constexpr uint32_t block_mesh_shift_layer        = block_mesh_shift_position_x   + block_mesh_bits_for_position_x;
-
-	constexpr uint64_t block_mesh_mask_vertex_index = BIT(block_mesh_bits_for_vertex_index) - 1;
-	constexpr uint64_t block_mesh_mask_face         = BIT(block_mesh_bits_for_face)         - 1;
-	constexpr uint64_t block_mesh_mask_rotation     = BIT(block_mesh_bits_for_rotation)     - 1;
-	constexpr uint64_t block_mesh_mask_position_z   = BIT(block_mesh_bits_for_position_z)   - 1;
-	constexpr uint64_t block_mesh_mask_position_y   = BIT(block_mesh_bits_for_position_y)   - 1;
-	constexpr uint64_t block_mesh_mask_position_x   = BIT(block_mesh_bits_for_position_x)   - 1;
-	constexpr uint64_t block_mesh_mask_layer        = BIT(block_mesh_bits_for_layer)        - 1;
-
-	struct BlockMesh
+	struct ChunkMeshSettings
 	{
-		BlockMesh() = default;
-		BlockMesh(uint8_t x, uint8_t y, uint8_t z, uint16_t layer, uint8_t face, uint8_t rot, uint8_t vert)
-		{
-			Set(x, y, z, layer, face, rot, vert);
-		}
+		/// Merges coplanar faces with the same texture into larger quads
+		bool Greedy = true;
+		/// Darkens face corners next to opaque blocks, baked into the mesh
+		bool AmbientOcclusion = true;
+	};
 
-		uint32_t LowerBits = 0;
-		uint32_t UpperBits = 0;
-	
-		uint8_t  GetVertexIndex() const { return (GetRaw() >> block_mesh_shift_vertex_index) & block_mesh_mask_vertex_index; }
-		uint8_t  GetFace()        const { return (GetRaw() >> block_mesh_shift_face)         & block_mesh_mask_face; }
-		uint8_t  GetRotation()    const { return (GetRaw() >> block_mesh_shift_rotation)     & block_mesh_mask_rotation; }
-		uint8_t  GetZ()           const { return (GetRaw() >> block_mesh_shift_position_z)   & block_mesh_mask_position_z; }
-		uint8_t  GetY()           const { return (GetRaw() >> block_mesh_shift_position_y)   & block_mesh_mask_position_y; }
-		uint8_t  GetX()           const { return (GetRaw() >> block_mesh_shift_position_x)   & block_mesh_mask_position_x; }
-		uint16_t GetLayer()       const { return (GetRaw() >> block_mesh_shift_layer)        & block_mesh_mask_layer; }
-	
-		void SetVertexIndex(uint8_t v) { ModifyBits(v, block_mesh_shift_vertex_index, block_mesh_mask_vertex_index); }
-		void SetFace(uint8_t f)        { ModifyBits(f, block_mesh_shift_face,         block_mesh_mask_face); }
-		void SetRotation(uint8_t r)    { ModifyBits(r, block_mesh_shift_rotation,     block_mesh_mask_rotation); }
-		void SetZ(uint8_t z)           { ModifyBits(z, block_mesh_shift_position_z,   block_mesh_mask_position_z); }
-		void SetY(uint8_t y)           { ModifyBits(y, block_mesh_shift_position_y,   block_mesh_mask_position_y); }
-		void SetX(uint8_t x)           { ModifyBits(x, block_mesh_shift_position_x,   block_mesh_mask_position_x); }
-		void SetLayer(uint16_t l)      { ModifyBits(l, block_mesh_shift_layer,        block_mesh_mask_layer); }
-	
-		void Set(uint8_t x, uint8_t y, uint8_t z, uint16_t layer, uint8_t face, uint8_t rot, uint8_t vert)
-		{
-			uint64_t raw = 0;
-			raw |= (uint64_t(vert)  & block_mesh_mask_vertex_index) << block_mesh_shift_vertex_index;
-			raw |= (uint64_t(face)  & block_mesh_mask_face)         << block_mesh_shift_face;
-			raw |= (uint64_t(rot)   & block_mesh_mask_rotation)     << block_mesh_shift_rotation;
-			raw |= (uint64_t(z)     & block_mesh_mask_position_z)   << block_mesh_shift_position_z;
-			raw |= (uint64_t(y)     & block_mesh_mask_position_y)   << block_mesh_shift_position_y;
-			raw |= (uint64_t(x)     & block_mesh_mask_position_x)   << block_mesh_shift_position_x;
-			raw |= (uint64_t(layer) & block_mesh_mask_layer)        << block_mesh_shift_layer;
-			SetRaw(raw);
-		}
-	
-	private:
-		void ModifyBits(uint64_t value, uint32_t shift, uint64_t mask)
-		{
-			uint64_t raw = GetRaw();
-			raw = (raw & ~(mask << shift)) | ((value & mask) << shift);
-			SetRaw(raw);
-		}
+	/// Built chunk columns around the meshed one, indexed [dz + 1][dx + 1], the center is unused.
+	/// Holding the refs keeps the neighbors alive for the whole build even if the World unloads them meanwhile
+	struct ChunkMeshNeighbors
+	{
+		Ref<Chunk> Columns[3][3];
 
-		uint64_t GetRaw() const
-		{
-			return (uint64_t(UpperBits) << 32) | LowerBits;
-		}
+		/// Main thread only, looks the neighbors up in the World of `chunk`.
+		/// Diagonal columns are only needed by ambient occlusion
+		static ChunkMeshNeighbors Resolve(const Chunk& chunk, bool diagonals);
+	};
+
+	/// Faces are split by how they are blended, each bucket is drawn in its own pass
+	enum class ChunkMeshBucket : uint8_t
+	{
+		/// Opaque blocks, drawn first with blending off
+		Opaque = 0,
+		/// Non-opaque blocks without the Transparent flag, texels are either solid or holes, alpha tested with blending off
+		Cutout,
+		/// Transparent blocks and fluids, drawn last with blending and sorted back to front
+		Translucent
+	};
+
+	constexpr uint32_t chunk_mesh_bucket_count = 3;
+
+	inline ChunkMeshBucket GetChunkMeshBucket(const BlockProperties& properties)
+	{
+		if (properties.IsOpaque())
+			return ChunkMeshBucket::Opaque;
+		if (properties.IsTransparent() || properties.Has(BlockPropertyFlags::Fluid))
+			return ChunkMeshBucket::Translucent;
+
+		return ChunkMeshBucket::Cutout;
+	}
+
+	/// Level 0 is the full mesh, level n is built from cells of 2^n blocks along each axis and drawn scaled up by 2^n
+	constexpr uint32_t chunk_mesh_lod_count = 3;
 
-		void SetRaw(uint64_t value) 
+	/// Translucent faces are sorted again once the camera moved this far from where they were last sorted
+	constexpr float translucent_sort_distance      = 1.0f;
+	/// Below this distance the previous order is nearly right and is fixed up with insertion sort instead of a full sort
+	constexpr float translucent_sort_full_distance = 8.0f;
+
+	/// Mesh of one 16^3 section, positions stay relative to the chunk
+	struct SectionMesh
+	{
+		/// Owned by MeshBufferPool, released by ChunkMesh
+		std::array<MeshBuffer, chunk_mesh_bucket_count> Buffers;
+		/// Visible block faces before merging
+		uint32_t FaceCount = 0;
+		/// Faces joined by open blocks, sections that were never built let everything through
+		SectionConnectivity Connectivity = section_connectivity_all;
+
+		bool IsEmpty() const { return std::all_of(Buffers.begin(), Buffers.end(), [](const MeshBuffer& buffer) { return buffer.IsEmpty(); }); }
+		uint32_t GetQuadCount() const { return Buffers[0].Size + Buffers[1].Size + Buffers[2].Size; }
+
+		std::span<const BlockMesh> GetData(ChunkMeshBucket bucket) const
 		{
-			LowerBits = static_cast<uint32_t>(value & 0xFFFFFFFF);
-			UpperBits = static_cast<uint32_t>(value >> 32);
+			const MeshBuffer& buffer = Buffers[static_cast<size_t>(bucket)];
+			return { buffer.Data, buffer.Size };
 		}
 	};
 
+	/// Front, ready and back slot of one section. The builder owns the back slot and the renderer owns the front slot,
+	/// finished meshes are handed over through the ready slot with a single atomic exchange on each side
+	struct SectionMeshBuffers
+	{
+		std::array<SectionMesh, 3> Slots;
+
+		uint8_t Front = 0;
+		uint8_t Back  = 1;
+		/// Index of the ready slot, with section_mesh_fresh_bit set when it holds a mesh newer than the front slot
+		std::atomic<uint8_t> Ready = 2;
+	};
+
+	constexpr uint8_t section_mesh_fresh_bit  = BIT(7);
+	constexpr uint8_t section_mesh_slot_mask  = section_mesh_fresh_bit - 1;
+
+	/// Builds write into back buffers, which may happen on a worker thread, and the renderer only reads front buffers.
+	/// Builds never look chunks up in the World, neighbors are resolved beforehand on the main thread and passed in.
+	/// Finished sections are published by SwapBuffers on the main thread, until then the chunk keeps rendering its previous mesh.
+	/// Swapping never waits for a running build.
+	/// At most one build runs per mesh at a time, a build that is requested while another one is running is skipped
+	/// and its sections stay marked for update
 	class ChunkMesh
 	{
 	public:
 		ChunkMesh(Chunk* chunk);
 		~ChunkMesh();
 
-		void Build();
+		/// Reads block data only through `properties`, chunk does not need to belong to a World.
+		/// Faces are culled per section with padded opacity bitmasks, one row of bits per (y, z).
+		/// Faces on borders without a neighbor in `neighbors` are skipped until the mesh is rebuilt with one
+		void Build(const BlockPropertiesTable& properties, const ChunkMeshSettings& settings = {}, const ChunkMeshNeighbors& neighbors = {});
+
+		/// Rebuilds only sections marked with ChunkSection::NeedsMeshUpdate, returns number of rebuilt sections
+		uint32_t Update(const BlockPropertiesTable& properties, const ChunkMeshSettings& settings = {}, const ChunkMeshNeighbors& neighbors = {});
+
+		/// Main thread only, publishes sections finished since the last swap. Returns false if nothing changed
+		bool SwapBuffers();
+
+		/// Results of builds that are running right now are thrown away instead of published
+		void DiscardPendingBuilds() { m_Generation.fetch_add(1, std::memory_order_acq_rel); }
+
+		/// Main thread only, rebuilds the mesh of LOD `level` from the current blocks if the chunk changed since it was built.
+		/// Returns false if it was already up to date
+		bool BuildLod(uint32_t level, const BlockPropertiesTable& properties);
+
+		/// Built at least once, level 0 is always available
+		bool HasLod(uint32_t level)     const { return level == 0 || (m_LodBuilt & BIT(level)); }
+		/// Not built yet or built before the chunk last changed
+		bool IsLodDirty(uint32_t level) const { return level != 0 && (m_LodDirty & BIT(level)); }
+
+		/// Main thread only, orders translucent faces of front buffers back to front as seen from `cameraPosition`.
+		/// Does nothing while the camera stays within translucent_sort_distance of the last sort and no section changed.
+		/// Returns number of sorted sections
+		uint32_t SortTranslucentFaces(const glm::vec3& cameraPosition);
+
+		bool IsEmpty() const { return m_QuadCount == 0; }
+		/// Translucent faces of LOD meshes are never sorted
+		bool HasTranslucentFaces(uint32_t lod = 0) const { return (lod == 0 ? m_TranslucentSections : m_LodTranslucentSections[lod - 1]) != 0; }
+
+		/// Front buffer, what the renderer should draw. LOD sections cover the same blocks as full sections
+		const SectionMesh& GetSectionMesh(size_t index, uint32_t lod = 0) const
+		{
+			return lod == 0 ? m_Sections[index].Slots[m_Sections[index].Front] : m_LodSections[lod - 1][index];
+		}
 
-		bool IsEmpty() const { return m_MeshData.empty(); }
+		/// Visible block faces before merging, equal to quad count when greedy meshing is disabled
+		uint32_t GetFaceCount() const { return m_FaceCount; }
+		/// Number of BlockMesh instances
+		uint32_t GetQuadCount(uint32_t lod = 0) const { return lod == 0 ? m_QuadCount : m_LodQuadCounts[lod - 1]; }
 
-		const std::vector<BlockMesh>& GetMeshData() const { return m_MeshData; }
+		/// Of the front buffer, built from blocks so it is the same for every LOD level
+		SectionConnectivity GetSectionConnectivity(size_t index) const { return GetSectionMesh(index).Connectivity; }
 
 		const glm::vec3& GetGlobalPosition() const { return m_GlobalPosition; }
 
 	private:
-		std::optional<Block> GetNeighbor(const glm::ivec3& inChunkPosition, const glm::ivec3& inSectionPosition, BlockFace face);
+		uint32_t BuildSections(const BlockPropertiesTable& properties, const ChunkMeshSettings& settings, const ChunkMeshNeighbors& chunkNeighbors, bool onlyDirty);
 
 	private:
 		Chunk* m_Chunk = nullptr;
 		glm::vec3 m_GlobalPosition = { 0.0f, 0.0f, 0.0f };	
 
-		std::vector<BlockMesh> m_MeshData;
+		std::array<SectionMeshBuffers, sections_per_chunk> m_Sections;
+
+		/// Held by a running build, never waited on
+		std::atomic<bool>     m_Building   = false;
+		std::atomic<uint32_t> m_Generation = 0;
+
+		/// Front buffer totals
+		uint32_t m_QuadCount = 0;
+		uint32_t m_FaceCount = 0;
+
+		/// Front buffers with translucent faces, and those of them swapped in since the last sort
+		uint32_t  m_TranslucentSections = 0;
+		uint32_t  m_UnsortedSections    = 0;
+		glm::vec3 m_SortPosition        = { 0.0f, 0.0f, 0.0f };
+		bool      m_HasSortPosition     = false;
+
+		/// Levels 1 and up, built on demand on the main thread and never double buffered
+		std::array<std::array<SectionMesh, sections_per_chunk>, chunk_mesh_lod_count - 1> m_LodSections;
+		std::array<uint32_t, chunk_mesh_lod_count - 1> m_LodQuadCounts          = {};
+		std::array<uint32_t, chunk_mesh_lod_count - 1> m_LodTranslucentSections = {};
+		/// Bit per level
+		uint32_t m_LodBuilt = 0;
+		uint32_t m_LodDirty = ~0u;
 	};
 
 }
\ No newline at end of file
@@ -0,0 +1,120 @@
+#include "kcpch.h"
+#include "Graphics/KuchCraft/MeshBufferPool.h"
+
+namespace KuchCraft {
+
+	MeshBufferPool::~MeshBufferPool()
+	{
+		Trim();
+	}
+
+	MeshBufferPool& MeshBufferPool::Get()
+	{
+		static MeshBufferPool s_Pool;
+		return s_Pool;
+	}
+
+	void MeshBufferPool::Assign(MeshBuffer& buffer, const BlockMesh* data, uint32_t size)
+	{
+		KC_CORE_ASSERT(size <= mesh_buffer_max_size, "Mesh does not fit in largest mesh buffer!");
+
+		if (size == 0)
+		{
+			Release(buffer);
+			return;
+		}
+
+		const uint32_t sizeClass = GetMeshBufferSizeClass(size);
+		{
+			std::lock_guard lock(m_Mutex);
+
+			m_Stats.MeshBytes -= buffer.Size * sizeof(BlockMesh);
+			m_Stats.MeshBytes += size        * sizeof(BlockMesh);
+
+			if (!buffer.Data || buffer.SizeClass != sizeClass)
+			{
+				if (buffer.Data)
+					ReleaseUnlocked(buffer.Data, buffer.SizeClass);
+
+				buffer.Data      = AllocateUnlocked(sizeClass);
+				buffer.SizeClass = sizeClass;
+			}
+		}
+
+		std::memcpy(buffer.Data, data, size * sizeof(BlockMesh));
+		buffer.Size = size;
+		Touch(buffer);
+	}
+
+	void MeshBufferPool::Release(MeshBuffer& buffer)
+	{
+		if (!buffer.Data)
+			return;
+
+		{
+			std::lock_guard lock(m_Mutex);
+			m_Stats.MeshBytes -= buffer.Size * sizeof(BlockMesh);
+			ReleaseUnlocked(buffer.Data, buffer.SizeClass);
+		}
+
+		buffer = {};
+	}
+
+	void MeshBufferPool::Trim()
+	{
+		std::lock_guard lock(m_Mutex);
+
+		for (uint32_t sizeClass = 0; sizeClass < mesh_buffer_class_count; sizeClass++)
+		{
+			auto& freeList = m_FreeLists[sizeClass];
+			for (BlockMesh* data : freeList)
+				::operator delete(data);
+
+			m_Stats.PooledBytes -= freeList.size() * GetMeshBufferClassCapacity(sizeClass) * sizeof(BlockMesh);
+			freeList.clear();
+			freeList.shrink_to_fit();
+		}
+	}
+
+	MeshBufferPoolStats MeshBufferPool::GetStats() const
+	{
+		std::lock_guard lock(m_Mutex);
+		return m_Stats;
+	}
+
+	BlockMesh* MeshBufferPool::AllocateUnlocked(uint32_t sizeClass)
+	{
+		const size_t bytes = GetMeshBufferClassCapacity(sizeClass) * sizeof(BlockMesh);
+		m_Stats.UsedBytes += bytes;
+
+		auto& freeList = m_FreeLists[sizeClass];
+		if (!freeList.empty())
+		{
+			BlockMesh* data = freeList.back();
+			freeList.pop_back();
+
+			m_Stats.PooledBytes -= bytes;
+			m_Stats.Reuses++;
+			return data;
+		}
+
+		m_Stats.SystemAllocations++;
+		return static_cast<BlockMesh*>(::operator new(bytes));
+	}
+
+	void MeshBufferPool::ReleaseUnlocked(BlockMesh* data, uint32_t sizeClass)
+	{
+		const size_t bytes = GetMeshBufferClassCapacity(sizeClass) * sizeof(BlockMesh);
+		m_Stats.UsedBytes -= bytes;
+
+		if (m_Stats.PooledBytes + bytes > mesh_buffer_max_pooled_bytes)
+		{
+			::operator delete(data);
+			return;
+		}
+
+		m_FreeLists[sizeClass].push_back(data);
+		m_Stats.PooledBytes += bytes;
+	}
+
+}
@@ -0,0 +1,111 @@
+#pragma once
+
+#include "Graphics/KuchCraft/BlockMesh.h"
+
+namespace KuchCraft {
+
+	/// Largest possible mesh of one section, every face of every block visible
+	constexpr uint32_t mesh_buffer_max_size = block_count_per_section * block_face_count;
+	constexpr uint32_t mesh_buffer_min_size = 32;
+	/// Capacities grow in quarter steps between powers of two, so a buffer wastes at most a fifth of its memory
+	constexpr uint32_t mesh_buffer_classes_per_octave = 4;
+	/// Released buffers above this many pooled bytes go back to the system
+	constexpr size_t   mesh_buffer_max_pooled_bytes = 64 * 1024 * 1024;
+
+	static_assert(std::has_single_bit(mesh_buffer_min_size) && mesh_buffer_min_size % mesh_buffer_classes_per_octave == 0,
+		"Mesh buffer size classes must split evenly!");
+	static_assert(std::is_trivially_copyable_v<BlockMesh> && std::is_trivially_destructible_v<BlockMesh>,
+		"Mesh buffers are copied and freed as raw memory!");
+
+	constexpr uint32_t GetMeshBufferClassCapacity(uint32_t sizeClass)
+	{
+		const uint32_t base = mesh_buffer_min_size << (sizeClass / mesh_buffer_classes_per_octave);
+		return base + (sizeClass % mesh_buffer_classes_per_octave) * (base / mesh_buffer_classes_per_octave);
+	}
+
+	constexpr uint32_t GetMeshBufferSizeClass(uint32_t size)
+	{
+		if (size <= mesh_buffer_min_size)
+			return 0;
+
+		const uint32_t octave = std::bit_width((size - 1) / mesh_buffer_min_size) - 1;
+		const uint32_t base   = mesh_buffer_min_size << octave;
+		const uint32_t step   = base / mesh_buffer_classes_per_octave;
+		return octave * mesh_buffer_classes_per_octave + (size - base + step - 1) / step;
+	}
+
+	constexpr uint32_t mesh_buffer_class_count = GetMeshBufferSizeClass(mesh_buffer_max_size) + 1;
+
+	static_assert(GetMeshBufferClassCapacity(GetMeshBufferSizeClass(mesh_buffer_max_size)) >= mesh_buffer_max_size, "Largest size class is too small!");
+	static_assert(GetMeshBufferSizeClass(mesh_buffer_min_size + 1) == 1 && GetMeshBufferSizeClass(2 * mesh_buffer_min_size) == mesh_buffer_classes_per_octave,
+		"Mesh buffer size classes are not contiguous!");
+
+	/// Exact size mesh stored in a pooled allocation of its size class
+	struct MeshBuffer
+	{
+		BlockMesh* Data      = nullptr;
+		uint32_t   Size      = 0;
+		uint32_t   SizeClass = 0;
+		/// Changes whenever the records change, 0 while the buffer holds nothing
+		uint32_t   Version   = 0;
+
+		bool IsEmpty() const { return Size == 0; }
+		uint32_t GetCapacity() const { return Data ? GetMeshBufferClassCapacity(SizeClass) : 0; }
+	};
+
+	struct MeshBufferPoolStats
+	{
+		/// Allocated by buffers that hold a mesh right now
+		size_t UsedBytes   = 0;
+		/// Released buffers kept for reuse
+		size_t PooledBytes = 0;
+		/// Bytes of meshes themselves, the rest of UsedBytes is rounding up to size classes
+		size_t MeshBytes   = 0;
+
+		uint64_t SystemAllocations = 0;
+		uint64_t Reuses            = 0;
+	};
+
+	/// Size-classed free lists of mesh buffers shared by all chunk meshes.
+	/// Meshes are built in a thread-local scratch buffer and only their exact result is stored here,
+	/// buffers of unloaded chunks go back to their free list and are handed to the next mesh of the same class.
+	/// All functions are thread safe
+	class MeshBufferPool
+	{
+	public:
+		~MeshBufferPool();
+
+		static MeshBufferPool& Get();
+
+		/// Copies `size` records into `buffer`, keeping its allocation when the size class does not change.
+		/// Size of 0 releases the buffer
+		void Assign(MeshBuffer& buffer, const BlockMesh* data, uint32_t size);
+		void Release(MeshBuffer& buffer);
+
+		/// Gives `buffer` a new version after its records were changed in place
+		void Touch(MeshBuffer& buffer) { buffer.Version = m_NextVersion.fetch_add(1, std::memory_order_relaxed); }
+
+		/// Returns all pooled buffers to the system
+		void Trim();
+
+		MeshBufferPoolStats GetStats() const;
+
+	private:
+		MeshBufferPool() = default;
+
+		BlockMesh* AllocateUnlocked(uint32_t sizeClass);
+		void ReleaseUnlocked(BlockMesh* data, uint32_t sizeClass);
+
+	private:
+		std::array<std::vector<BlockMesh*>, mesh_buffer_class_count> m_FreeLists;
+		mutable std::mutex m_Mutex;
+
+		MeshBufferPoolStats m_Stats;
+
+		std::atomic<uint32_t> m_NextVersion = 1;
+
+		KC_DISALLOW_COPY(MeshBufferPool);
+		KC_DISALLOW_MOVE(MeshBufferPool);
+	};
+
+}
@@ -0,0 +1,218 @@
+#include "kcpch.h"
+#include "Graphics/KuchCraft/SectionVisibility.h"
+
+#include "KuchCraft/World/Block.h"
+
+namespace KuchCraft {
+
+	static const std::array<glm::ivec3, block_face_count> section_face_directions = {
+		glm::ivec3( 0,  0,  1), /// Front
+		glm::ivec3(-1,  0,  0), /// Left
+		glm::ivec3( 0,  0, -1), /// Back
+		glm::ivec3( 1,  0,  0), /// Right
+		glm::ivec3( 0,  1,  0), /// Top
+		glm::ivec3( 0, -1,  0)  /// Bottom
+	};
+
+	static constexpr std::array<uint8_t, block_face_count> section_opposite_faces = { 2, 3, 0, 1, 5, 4 };
+
+	/// Faces of the section the block at (x, y, z) lies on
+	static KC_FORCE_INLINE uint8_t GetBorderFaces(int x, int y, int z)
+	{
+		constexpr int last = section_size_x - 1;
+
+		uint8_t faces = 0;
+		faces |= z == last ? BIT((int)BlockFace::Front)  : 0;
+		faces |= x == 0    ? BIT((int)BlockFace::Left)   : 0;
+		faces |= z == 0    ? BIT((int)BlockFace::Back)   : 0;
+		faces |= x == last ? BIT((int)BlockFace::Right)  : 0;
+		faces |= y == last ? BIT((int)BlockFace::Top)    : 0;
+		faces |= y == 0    ? BIT((int)BlockFace::Bottom) : 0;
+		return faces;
+	}
+
+	SectionConnectivity ComputeSectionConnectivity(const SectionOpacity& opaque)
+	{
+		constexpr int size = section_size_x;
+
+		/// Open blocks not yet flooded, same layout as `opaque`
+		SectionOpacity open;
+		bool anyOpaque = false;
+		bool anyOpen   = false;
+		for (int y = 0; y < size; y++)
+		{
+			for (int z = 0; z < size; z++)
+			{
+				open[y][z] = static_cast<uint16_t>(~opaque[y][z]);
+				anyOpaque |= opaque[y][z] != 0;
+				anyOpen   |= open[y][z]   != 0;
+			}
+		}
+
+		if (!anyOpaque)
+			return section_connectivity_all;
+		if (!anyOpen)
+			return 0;
+
+		thread_local std::vector<uint16_t> s_Stack;
+		s_Stack.clear();
+
+		auto pack = [](int x, int y, int z) { return static_cast<uint16_t>((y * size + z) * size + x); };
+
+		SectionConnectivity connectivity = 0;
+		for (int y = 0; y < size; y++)
+		{
+			for (int z = 0; z < size; z++)
+			{
+				while (open[y][z])
+				{
+					/// New region, flooded depth first
+					const int startX = std::countr_zero(open[y][z]);
+					open[y][z] &= ~(1u << startX);
+					s_Stack.push_back(pack(startX, y, z));
+
+					uint8_t faces = 0;
+					while (!s_Stack.empty())
+					{
+						const int index = s_Stack.back();
+						s_Stack.pop_back();
+
+						const int cx = index % size;
+						const int cz = (index / size) % size;
+						const int cy = index / (size * size);
+						faces |= GetBorderFaces(cx, cy, cz);
+
+						for (const glm::ivec3& direction : section_face_directions)
+						{
+							const int nx = cx + direction.x, ny = cy + direction.y, nz = cz + direction.z;
+							if (nx < 0 || ny < 0 || nz < 0 || nx >= size || ny >= size || nz >= size)
+								continue;
+
+							const uint16_t bit = static_cast<uint16_t>(1u << nx);
+							if (!(open[ny][nz] & bit))
+								continue;
+
+							open[ny][nz] &= ~bit;
+							s_Stack.push_back(pack(nx, ny, nz));
+						}
+					}
+
+					for (uint32_t a = 0; a < block_face_count; a++)
+					{
+						if (!(faces & BIT(a)))
+							continue;
+
+						for (uint32_t b = a + 1; b < block_face_count; b++)
+							connectivity |= (faces & BIT(b)) ? GetSectionFacePairBit(a, b) : 0;
+					}
+
+					if (connectivity == section_connectivity_all)
+						return connectivity;
+				}
+			}
+		}
+
+		return connectivity;
+	}
+
+	void SectionVisibilityGraph::Reset(const glm::ivec2& minChunk, const glm::ivec2& maxChunk)
+	{
+		m_MinChunk = minChunk;
+		m_Size     = glm::max(maxChunk - minChunk + 1, glm::ivec2(0));
+
+		const size_t columns = static_cast<size_t>(m_Size.x) * m_Size.y;
+		m_Connectivity.assign(columns * sections_per_chunk, section_connectivity_all);
+		m_Visible.assign(columns, 0);
+	}
+
+	void SectionVisibilityGraph::SetConnectivity(const glm::ivec2& chunk, uint32_t section, SectionConnectivity connectivity)
+	{
+		KC_CORE_ASSERT(Contains(chunk) && section < sections_per_chunk, "Section is outside of visibility graph!");
+
+		m_Connectivity[GetColumnIndex(chunk) * sections_per_chunk + section] = connectivity;
+	}
+
+	uint32_t SectionVisibilityGraph::Traverse(const glm::vec3& cameraPosition, const Frustum& frustum)
+	{
+		const glm::ivec2 cameraChunk   = { (int)std::floor(cameraPosition.x / chunk_size_x), (int)std::floor(cameraPosition.z / chunk_size_z) };
+		const int        cameraSection = (int)std::floor(cameraPosition.y / section_size_y);
+
+		if (!Contains(cameraChunk) || cameraSection < 0 || cameraSection >= (int)sections_per_chunk)
+		{
+			std::fill(m_Visible.begin(), m_Visible.end(), static_cast<uint32_t>(BIT(sections_per_chunk) - 1));
+			return GetSectionCount();
+		}
+
+		std::fill(m_Visible.begin(), m_Visible.end(), 0u);
+		m_Reached.assign(m_Connectivity.size(), 0);
+		m_Queue.clear();
+
+		const uint32_t start = static_cast<uint32_t>(GetColumnIndex(cameraChunk) * sections_per_chunk + cameraSection);
+		m_Reached[start] = 1;
+		m_Queue.push_back({ start, 0, 0 });
+
+		uint32_t visibleCount = 0;
+		for (size_t head = 0; head < m_Queue.size(); head++)
+		{
+			const Step step = m_Queue[head];
+
+			const uint32_t column  = step.Section / sections_per_chunk;
+			const int      section = static_cast<int>(step.Section % sections_per_chunk);
+			m_Visible[column] |= BIT(section);
+			visibleCount++;
+
+			const glm::ivec2 chunk = { m_MinChunk.x + (int)(column % m_Size.x), m_MinChunk.y + (int)(column / m_Size.x) };
+			const SectionConnectivity connectivity = m_Connectivity[step.Section];
+
+			for (uint32_t face = 0; face < block_face_count; face++)
+			{
+				/// Never back towards the camera
+				if (step.Directions & BIT(section_opposite_faces[face]))
+					continue;
+
+				/// The camera section can be left through any face
+				if (step.Section != start && !(connectivity & GetSectionFacePairBit(step.Entry, face)))
+					continue;
+
+				const glm::ivec3& direction = section_face_directions[face];
+				const glm::ivec2 neighborChunk   = chunk + glm::ivec2(direction.x, direction.z);
+				const int        neighborSection = section + direction.y;
+				if (!Contains(neighborChunk) || neighborSection < 0 || neighborSection >= (int)sections_per_chunk)
+					continue;
+
+				const uint32_t neighbor = static_cast<uint32_t>(GetColumnIndex(neighborChunk) * sections_per_chunk + neighborSection);
+				if (m_Reached[neighbor])
+					continue;
+
+				/// Frustum does not depend on the path, sections outside it are skipped for good
+				m_Reached[neighbor] = 1;
+
+				const glm::vec3 min = { neighborChunk.x * (int)chunk_size_x, neighborSection * (int)section_size_y, neighborChunk.y * (int)chunk_size_z };
+				if (!frustum.IntersectsAABB(min, min + glm::vec3(section_size_x, section_size_y, section_size_z)))
+					continue;
+
+				m_Queue.push_back({ neighbor, static_cast<uint8_t>(step.Directions | BIT(face)), section_opposite_faces[face] });
+			}
+		}
+
+		return visibleCount;
+	}
+
+	uint32_t SectionVisibilityGraph::GetVisibleSections(const glm::ivec2& chunk) const
+	{
+		return Contains(chunk) ? m_Visible[GetColumnIndex(chunk)] : 0;
+	}
+
+	bool SectionVisibilityGraph::Contains(const glm::ivec2& chunk) const
+	{
+		const glm::ivec2 local = chunk - m_MinChunk;
+		return local.x >= 0 && local.y >= 0 && local.x < m_Size.x && local.y < m_Size.y;
+	}
+
+	size_t SectionVisibilityGraph::GetColumnIndex(const glm::ivec2& chunk) const
+	{
+		const glm::ivec2 local = chunk - m_MinChunk;
+		return static_cast<size_t>(local.y) * m_Size.x + local.x;
+	}
+
+}
@@ -0,0 +1,81 @@
+#pragma once
+
+#include "KuchCraft/World/WorldCore.h"
+#include "Graphics/Core/Frustum.h"
+
+namespace KuchCraft {
+
+	/// Bit per pair of section faces, set when a path of non-opaque blocks connects them. Faces are ordered like BlockFace
+	using SectionConnectivity = uint16_t;
+
+	constexpr uint32_t section_face_pair_count = block_face_count * (block_face_count - 1) / 2;
+	constexpr SectionConnectivity section_connectivity_all = (1u << section_face_pair_count) - 1u;
+
+	/// `a` and `b` are different BlockFace values
+	constexpr SectionConnectivity GetSectionFacePairBit(uint32_t a, uint32_t b)
+	{
+		if (a > b)
+			std::swap(a, b);
+
+		return static_cast<SectionConnectivity>(1u << (a * (2 * block_face_count - 1 - a) / 2 + (b - a - 1)));
+	}
+
+	static_assert(GetSectionFacePairBit(block_face_count - 2, block_face_count - 1) == BIT((section_face_pair_count - 1)), "Face pair bits are not contiguous!");
+
+	/// Bit x of row [y][z] is set for blocks that hide everything behind them
+	using SectionOpacity = std::array<std::array<uint16_t, section_size_z>, section_size_y>;
+
+	static_assert(section_size_x == 16, "Section opacity rows hold 16 blocks!");
+
+	/// Flood fills non-opaque blocks of one section and joins faces touched by the same open region
+	SectionConnectivity ComputeSectionConnectivity(const SectionOpacity& opaque);
+
+	/// Sections of a rectangle of chunk columns, walked breadth first from the camera section.
+	/// A section is entered only through a face its neighbor is open towards, left only through faces its open regions
+	/// connect to the entry face, and the walk never turns back towards the camera, so sealed caves and terrain behind
+	/// solid ground are never reached. Sections outside the frustum are not entered.
+	/// Chunk coordinates are chunk positions divided by chunk size. Does not touch OpenGL
+	class SectionVisibilityGraph
+	{
+	public:
+		/// Every section of chunks from `minChunk` to `maxChunk` inclusive starts fully connected
+		void Reset(const glm::ivec2& minChunk, const glm::ivec2& maxChunk);
+
+		void SetConnectivity(const glm::ivec2& chunk, uint32_t section, SectionConnectivity connectivity);
+
+		/// Marks every reachable section visible, returns their number.
+		/// A camera outside the graph or above the world can not be walked from, then every section is visible
+		uint32_t Traverse(const glm::vec3& cameraPosition, const Frustum& frustum);
+
+		/// Bit per section of the chunk column
+		uint32_t GetVisibleSections(const glm::ivec2& chunk) const;
+
+		uint32_t GetSectionCount() const { return static_cast<uint32_t>(m_Connectivity.size()); }
+
+	private:
+		bool   Contains(const glm::ivec2& chunk) const;
+		size_t GetColumnIndex(const glm::ivec2& chunk) const;
+
+	private:
+		glm::ivec2 m_MinChunk = { 0, 0 };
+		glm::ivec2 m_Size     = { 0, 0 };
+
+		/// Indexed by column index * sections_per_chunk + section
+		std::vector<SectionConnectivity> m_Connectivity;
+		/// Bit per section of each column
+		std::vector<uint32_t> m_Visible;
+
+		struct Step
+		{
+			uint32_t Section    = 0;
+			/// BlockFace bits moved along so far
+			uint8_t  Directions = 0;
+			/// Face the section was entered through
+			uint8_t  Entry      = 0;
+		};
+
+		std::vector<uint8_t> m_Reached;
+		std::vector<Step>    m_Queue;
+	};
+
+}
@@ -3,6 +3,8 @@
 
 #include "Core/Application.h"
 
+#include "Graphics/Core/OpenGLRenderBackend.h"
+
 #include <glad/glad.h>
 
 namespace KuchCraft {
@@ -10,6 +12,8 @@ namespace KuchCraft {
 	Renderer::Renderer(Config config)
 		: m_Config(config)
 	{
+		m_Backend = CreateScope<OpenGLRenderBackend>();
+
 		CheckExtensions();
 		SetupLogging();
 		SetGlobalSubstitutions();
@@ -50,6 +54,7 @@ namespace KuchCraft {
 
 	Renderer::~Renderer()
 	{
+		StopRenderThread();
 	}
 
 	Ref<Renderer> Renderer::Create(Config config)
@@ -65,30 +70,97 @@ namespace KuchCraft {
 
 		m_EnvironmentUniformBufferData.ViewProjection  = m_Camera ? m_Camera->GetViewProjection() : glm::mat4(1.0f);
 		m_EnvironmentUniformBufferData.OrthoProjection = glm::ortho(0.0f, (float)width, 0.0f, (float)height);
-		m_EnvironmentUniformBuffer->SetData(&m_EnvironmentUniformBufferData, sizeof(m_EnvironmentUniformBufferData));
+		SetUniformBufferData(m_EnvironmentUniformBuffer.get(), &m_EnvironmentUniformBufferData, sizeof(m_EnvironmentUniformBufferData));
 	}
 
 	void Renderer::EndFrame()
 	{
-		m_SceneRenderTarget->Bind();
-		m_SceneRenderTarget->ClearAttachments();
+		m_Commands.Record(RenderCommands::BindFrameBuffer{ m_SceneRenderTarget->GetRendererID(), (uint32_t)m_SceneRenderTarget->GetWidth(), (uint32_t)m_SceneRenderTarget->GetHeight() });
+		m_Commands.Record(RenderCommands::ClearFrameBuffer{ m_SceneRenderTarget.get() });
 
 		RenderPlanes();
 		RenderChunks();
 
-		m_SceneRenderTarget->Unbind();
 		SetRenderTargetToDefault();
-		m_SceneRenderTarget->BlitToDefault(FrameBufferBlitMask::Color, TextureFilter::Linear);
+		m_Commands.Record(RenderCommands::BlitFrameBufferToDefault{ m_SceneRenderTarget.get(), FrameBufferBlitMask::Color, TextureFilter::Linear });
 
 		RenderSprites();
 	}
 
+	void Renderer::Present(std::function<void()> present)
+	{
+		SubmitCommands(std::move(present));
+
+		m_Stats.Commands     = m_FrameCommands;
+		m_Stats.CommandBytes = m_FrameCommandBytes;
+		m_FrameCommands      = 0;
+		m_FrameCommandBytes  = 0;
+	}
+
+	void Renderer::SubmitCommands(std::function<void()> present)
+	{
+		m_FrameCommands     += m_Commands.GetCommandCount();
+		m_FrameCommandBytes += m_Commands.GetSize();
+
+		if (m_RenderThread)
+		{
+			if (!m_Commands.IsEmpty() || present)
+				m_RenderThread->Submit(m_Commands, std::move(present));
+
+			return;
+		}
+
+		m_Backend->Execute(m_Commands);
+		m_Commands.Clear();
+
+		if (present)
+			present();
+	}
+
+	void Renderer::StartRenderThread(std::function<void()> onStart, std::function<void()> onStop)
+	{
+		KC_CORE_ASSERT(!m_RenderThread, "Render thread is already running!");
+
+		/// Commands recorded so far, like the initial state, are executed with the first frame
+		m_RenderThread = CreateScope<RenderThread>(*m_Backend, std::move(onStart), std::move(onStop));
+
+		KC_CORE_INFO("Render thread started, up to {} frames in flight", RenderThread::max_frames_in_flight);
+	}
+
+	void Renderer::StopRenderThread()
+	{
+		if (!m_RenderThread)
+			return;
+
+		SubmitCommands();
+		m_RenderThread.reset();
+
+		KC_CORE_INFO("Render thread stopped");
+	}
+
+	void Renderer::ExecuteWithContext(const std::function<void()>& function)
+	{
+		SubmitCommands();
+
+		if (m_RenderThread)
+			m_RenderThread->Invoke(function);
+		else
+			function();
+	}
+
+	RenderThreadStats Renderer::GetRenderThreadStats() const
+	{
+		return m_RenderThread ? m_RenderThread->GetStats() : RenderThreadStats();
+	}
+
 	void Renderer::OnWindowResize(int width, int height)
 	{
 		if (width <= 0 || height <= 0)
 			return;
 
-		m_SceneRenderTarget->Resize(width, height);
+		ExecuteWithContext([&]() {
+			m_SceneRenderTarget->Resize(width, height);
+		});
 	}
 
 	void Renderer::DrawLine2D(const glm::vec2& start, const glm::vec2& end, const glm::vec4& color, float thickness)
@@ -135,15 +207,15 @@ namespace KuchCraft {
 		glm::mat4 transform = glm::translate(glm::mat4(1.0f), position)
 			* glm::scale(glm::mat4(1.0f), { size.x, size.y, 1.0f });
 
-		int textureID = 0; /// White texture
+		VertexQuad2D* vertices = m_Sprites.AddPrimitive(0); /// White texture
 		for (uint32_t i = 0; i < quad_vertex_count; i++)
 		{
-			m_Sprites.Vertices.emplace_back(
+			vertices[i] = {
 				glm::vec3(transform * quad_vertex_positions[i]),
 				color,
 				quad_vertex_texture_coords[i],
-				textureID
-			);
+				0
+			};
 		}
 	}
 
@@ -157,18 +229,18 @@ namespace KuchCraft {
 		glm::mat4 transform = glm::translate(glm::mat4(1.0f), position)
 			* glm::scale(glm::mat4(1.0f), { size.x, size.y, 1.0f });
 
-		int textureID = texture->GetRendererID();
+		VertexQuad2D* vertices = m_Sprites.AddPrimitive(texture->GetRendererID());
 		for (uint32_t i = 0; i < quad_vertex_count; i++)
 		{
 			glm::vec2 baseUV = quad_vertex_texture_coords[i];
 			glm::vec2 uv     = glm::mix(uv0, uv1, baseUV) * tilingFactor;
 
-			m_Sprites.Vertices.emplace_back(
+			vertices[i] = {
 				glm::vec3(transform * quad_vertex_positions[i]),
 				tintColor,                                      
 				uv,                                            
-				textureID                                      
-			);
+				0
+			};
 		}
 	}
 
@@ -183,15 +255,15 @@ namespace KuchCraft {
 			* glm::rotate(glm::mat4(1.0f), rotation, { 0.0f, 0.0f, 1.0f })
 			* glm::scale(glm::mat4(1.0f), { size.x, size.y, 1.0f });
 
-		int textureID = 0; /// White texture
+		VertexQuad2D* vertices = m_Sprites.AddPrimitive(0); /// White texture
 		for (uint32_t i = 0; i < quad_vertex_count; i++)
 		{
-			m_Sprites.Vertices.emplace_back(
+			vertices[i] = {
 				glm::vec3(transform * quad_vertex_positions[i]),
 				color,
 				quad_vertex_texture_coords[i],
-				textureID
-			);
+				0
+			};
 		}
 	}
 
@@ -206,49 +278,49 @@ namespace KuchCraft {
 			* glm::rotate(glm::mat4(1.0f), rotation, { 0.0f, 0.0f, 1.0f })
 			* glm::scale(glm::mat4(1.0f), { size.x, size.y, 1.0f });
 
-		int textureID = texture->GetRendererID();
+		VertexQuad2D* vertices = m_Sprites.AddPrimitive(texture->GetRendererID());
 		for (uint32_t i = 0; i < quad_vertex_count; i++)
 		{
 			glm::vec2 baseUV = quad_vertex_texture_coords[i];
 			glm::vec2 uv = glm::mix(uv0, uv1, baseUV) * tilingFactor;
 
-			m_Sprites.Vertices.emplace_back(
+			vertices[i] = {
 				glm::vec3(transform * quad_vertex_positions[i]),
 				tintColor,
 				uv,
-				textureID
-			);
+				0
+			};
 		}
 	}
 
 	void Renderer::DrawSprite(const glm::mat4& transform, const glm::vec4& color)
 	{
-		int textureID = 0; /// White texture
+		VertexQuad2D* vertices = m_Sprites.AddPrimitive(0); /// White texture
 		for (uint32_t i = 0; i < quad_vertex_count; i++)
 		{
-			m_Sprites.Vertices.emplace_back(
+			vertices[i] = {
 				glm::vec3(transform * quad_vertex_positions[i]),
 				color,
 				quad_vertex_texture_coords[i],
-				textureID
-			);
+				0
+			};
 		}
 	}
 
 	void Renderer::DrawSprite(const glm::mat4& transform, const Ref<Texture2D>& texture, float tilingFactor, const glm::vec4& tintColor, glm::vec2 uv0, glm::vec2 uv1)
 	{
-		int textureID = texture->GetRendererID();
+		VertexQuad2D* vertices = m_Sprites.AddPrimitive(texture->GetRendererID());
 		for (uint32_t i = 0; i < quad_vertex_count; i++)
 		{
 			glm::vec2 baseUV = quad_vertex_texture_coords[i];
 			glm::vec2 uv = glm::mix(uv0, uv1, baseUV) * tilingFactor;
 
-			m_Sprites.Vertices.emplace_back(
+			vertices[i] = {
 				glm::vec3(transform * quad_vertex_positions[i]),
 				tintColor,
 				uv,
-				textureID
-			);
+				0
+			};
 		}
 	}
 
@@ -261,16 +333,16 @@ namespace KuchCraft {
 		glm::mat3 normalMatrix = glm::transpose(glm::inverse(glm::mat3(transform)));
 		glm::vec3 normal = glm::normalize(normalMatrix * plane_normal);
 
-		int textureID = 0; /// White texture
+		VertexPlane* vertices = m_Planes.AddPrimitive(0); /// White texture
 		for (uint32_t i = 0; i < plane_vertex_count; i++)
 		{
-			m_Planes.Vertices.emplace_back(
+			vertices[i] = {
 				glm::vec3(transform * plane_vertex_positions[i]),
 				normal,
 				color,
 				plane_vertex_texture_coords[i],
-				textureID
-			);
+				0
+			};
 		}
 	}
 
@@ -283,19 +355,19 @@ namespace KuchCraft {
 		glm::mat3 normalMatrix = glm::transpose(glm::inverse(glm::mat3(transform)));
 		glm::vec3 normal = glm::normalize(normalMatrix * plane_normal);
 
-		int textureID = texture->GetRendererID();
+		VertexPlane* vertices = m_Planes.AddPrimitive(texture->GetRendererID());
 		for (uint32_t i = 0; i < plane_vertex_count; i++)
 		{
 			glm::vec2 baseUV = plane_vertex_texture_coords[i];
 			glm::vec2 uv = glm::mix(uv0, uv1, baseUV) * tilingFactor;
 
-			m_Planes.Vertices.emplace_back(
+			vertices[i] = {
 				glm::vec3(transform * plane_vertex_positions[i]),
 				normal,
 				tintColor,
 				uv,
-				textureID
-			);
+				0
+			};
 		}
 	}
 
@@ -304,16 +376,16 @@ namespace KuchCraft {
 		glm::mat3 normalMatrix = glm::transpose(glm::inverse(glm::mat3(transform)));
 		glm::vec3 normal = glm::normalize(normalMatrix * plane_normal);
 
-		int textureID = 0; /// White texture
+		VertexPlane* vertices = m_Planes.AddPrimitive(0); /// White texture
 		for (uint32_t i = 0; i < plane_vertex_count; i++)
 		{
-			m_Planes.Vertices.emplace_back(
+			vertices[i] = {
 				glm::vec3(transform * plane_vertex_positions[i]),
 				normal,
 				color,
 				plane_vertex_texture_coords[i],
-				textureID
-			);
+				0
+			};
 		}
 	}
 
@@ -322,19 +394,19 @@ namespace KuchCraft {
 		glm::mat3 normalMatrix = glm::transpose(glm::inverse(glm::mat3(transform)));
 		glm::vec3 normal = glm::normalize(normalMatrix * plane_normal);
 
-		int textureID = texture->GetRendererID();
+		VertexPlane* vertices = m_Planes.AddPrimitive(texture->GetRendererID());
 		for (uint32_t i = 0; i < plane_vertex_count; i++)
 		{
 			glm::vec2 baseUV = plane_vertex_texture_coords[i];
 			glm::vec2 uv = glm::mix(uv0, uv1, baseUV) * tilingFactor;
 
-			m_Planes.Vertices.emplace_back(
+			vertices[i] = {
 				glm::vec3(transform * plane_vertex_positions[i]),
 				normal,
 				tintColor,
 				uv,
-				textureID
-			);
+				0
+			};
 		}
 	}
 
@@ -396,21 +468,35 @@ namespace KuchCraft {
 		m_ShaderLibrary.SetGlobalSubstitution("MAX_COMBINED_TEXTURE_SLOTS", std::to_string(m_Config.Renderer.MaxCombinedTextureSlots));
 
 		m_ShaderLibrary.SetGlobalSubstitution("BLOCK_FACE_COUNT",                 std::to_string(block_face_count));
+		m_ShaderLibrary.SetGlobalSubstitution("BLOCK_CORNERS_PER_FACE",           std::to_string(block_corners_per_face));
 		m_ShaderLibrary.SetGlobalSubstitution("BLOCK_VERTICES_PER_FACE",          std::to_string(block_vertices_per_face));
 		m_ShaderLibrary.SetGlobalSubstitution("BLOCK_MESH_SHIFT_POSITION_X",      std::to_string(block_mesh_shift_position_x));
 		m_ShaderLibrary.SetGlobalSubstitution("BLOCK_MESH_SHIFT_POSITION_Y",      std::to_string(block_mesh_shift_position_y));
 		m_ShaderLibrary.SetGlobalSubstitution("BLOCK_MESH_SHIFT_POSITION_Z",      std::to_string(block_mesh_shift_position_z));
 		m_ShaderLibrary.SetGlobalSubstitution("BLOCK_MESH_SHIFT_ROTATION",        std::to_string(block_mesh_shift_rotation));
 		m_ShaderLibrary.SetGlobalSubstitution("BLOCK_MESH_SHIFT_FACE",            std::to_string(block_mesh_shift_face));
-		m_ShaderLibrary.SetGlobalSubstitution("BLOCK_MESH_SHIFT_VERTEX_INDEX",    std::to_string(block_mesh_shift_vertex_index));
 		m_ShaderLibrary.SetGlobalSubstitution("BLOCK_MESH_SHIFT_LAYER",           std::to_string(block_mesh_shift_layer));
+		m_ShaderLibrary.SetGlobalSubstitution("BLOCK_MESH_SHIFT_WIDTH",           std::to_string(block_mesh_shift_width));
+		m_ShaderLibrary.SetGlobalSubstitution("BLOCK_MESH_SHIFT_HEIGHT",          std::to_string(block_mesh_shift_height));
 		m_ShaderLibrary.SetGlobalSubstitution("BLOCK_MESH_BITS_FOR_POSITION_X",   std::to_string(block_mesh_bits_for_position_x));
 		m_ShaderLibrary.SetGlobalSubstitution("BLOCK_MESH_BITS_FOR_POSITION_Y",   std::to_string(block_mesh_bits_for_position_y));
 		m_ShaderLibrary.SetGlobalSubstitution("BLOCK_MESH_BITS_FOR_POSITION_Z",   std::to_string(block_mesh_bits_for_position_z));
 		m_ShaderLibrary.SetGlobalSubstitution("BLOCK_MESH_BITS_FOR_ROTATION",     std::to_string(block_mesh_bits_for_rotation));
 		m_ShaderLibrary.SetGlobalSubstitution("BLOCK_MESH_BITS_FOR_FACE",         std::to_string(block_mesh_bits_for_face));
-		m_ShaderLibrary.SetGlobalSubstitution("BLOCK_MESH_BITS_FOR_VERTEX_INDEX", std::to_string(block_mesh_bits_for_vertex_index));
 		m_ShaderLibrary.SetGlobalSubstitution("BLOCK_MESH_BITS_FOR_LAYER",        std::to_string(block_mesh_bits_for_layer));
+		m_ShaderLibrary.SetGlobalSubstitution("BLOCK_MESH_BITS_FOR_SIZE",         std::to_string(block_mesh_bits_for_size));
+		m_ShaderLibrary.SetGlobalSubstitution("BLOCK_MESH_SHIFT_GEOMETRY",        std::to_string(block_mesh_shift_geometry));
+		m_ShaderLibrary.SetGlobalSubstitution("BLOCK_MESH_BITS_FOR_GEOMETRY",     std::to_string(block_mesh_bits_for_geometry));
+		m_ShaderLibrary.SetGlobalSubstitution("BLOCK_MESH_SHIFT_AO",              std::to_string(block_mesh_shift_ao));
+		m_ShaderLibrary.SetGlobalSubstitution("BLOCK_MESH_BITS_FOR_AO",           std::to_string(block_mesh_bits_for_ao));
+		m_ShaderLibrary.SetGlobalSubstitution("BLOCK_MESH_BITS_FOR_AO_CORNER",    std::to_string(block_mesh_bits_for_ao_corner));
+		m_ShaderLibrary.SetGlobalSubstitution("BLOCK_MESH_SHIFT_FLIP",            std::to_string(block_mesh_shift_flip));
+		m_ShaderLibrary.SetGlobalSubstitution("BLOCK_MESH_BITS_FOR_FLIP",         std::to_string(block_mesh_bits_for_flip));
+		m_ShaderLibrary.SetGlobalSubstitution("BLOCK_GEOMETRY_SLAB",              std::to_string(static_cast<int>(BlockGeometryType::Slab)));
+		m_ShaderLibrary.SetGlobalSubstitution("BLOCK_GEOMETRY_CROSS",             std::to_string(static_cast<int>(BlockGeometryType::Cross)));
+		m_ShaderLibrary.SetGlobalSubstitution("BLOCK_GEOMETRY_PLANE",             std::to_string(static_cast<int>(BlockGeometryType::Plane)));
+		m_ShaderLibrary.SetGlobalSubstitution("BLOCK_CROSS_FACE_COUNT",           std::to_string(block_cross_face_count));
+		m_ShaderLibrary.SetGlobalSubstitution("BLOCK_PLANE_HEIGHT",               std::to_string(block_plane_height));
 		m_ShaderLibrary.SetGlobalSubstitution("BLOCK_MESH_FACE_FRONT",            std::to_string(static_cast<int>(BlockFace::Front)));
 		m_ShaderLibrary.SetGlobalSubstitution("BLOCK_MESH_FACE_LEFT",             std::to_string(static_cast<int>(BlockFace::Left)));
 		m_ShaderLibrary.SetGlobalSubstitution("BLOCK_MESH_FACE_BACK",             std::to_string(static_cast<int>(BlockFace::Back)));
@@ -422,17 +508,15 @@ namespace KuchCraft {
 
 	void Renderer::ClearDefaultFrameBuffer()
 	{
-		glBindFramebuffer(GL_FRAMEBUFFER, 0);
 		constexpr glm::vec4 clear_color = glm::vec4(0.1f, 0.1f, 0.1f, 1.0f);
-		glClearColor(clear_color.r, clear_color.g, clear_color.b, clear_color.a);
-		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT | GL_STENCIL_BUFFER_BIT);
+		m_Commands.Record(RenderCommands::BindFrameBuffer{ 0 });
+		m_Commands.Record(RenderCommands::Clear{ clear_color });
 	}
 
 	void Renderer::SetRenderTargetToDefault()
 	{
 		auto [width, height] = Application::Get().GetWindow()->GetSize();
-		glBindFramebuffer(GL_FRAMEBUFFER, 0);
-		glViewport(0, 0, width, height);
+		m_Commands.Record(RenderCommands::BindFrameBuffer{ 0, (uint32_t)width, (uint32_t)height });
 	}
 
 	void Renderer::InitializeRendererState()
@@ -443,6 +527,7 @@ namespace KuchCraft {
 		SetFrontFaceWinding(m_RendererState.FrontFaceWinding);
 
 		SetDepthTest(m_RendererState.DepthTestEnabled);
+		SetDepthWrite(m_RendererState.DepthWriteEnabled);
 		SetDepthFunc(m_RendererState.DepthFunc);
 
 		SetBlend(m_RendererState.BlendEnabled);
@@ -464,9 +549,11 @@ namespace KuchCraft {
 		m_RendererState.PolygonMode = mode;
 		switch (mode)
 		{
-			case PolygonMode::Fill:   glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);   break;
-			case PolygonMode::Line:   glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);   break;
-			case PolygonMode::Point:  glPolygonMode(GL_FRONT_AND_BACK, GL_POINT);  break;
+			case PolygonMode::Fill:
+			case PolygonMode::Line:
+			case PolygonMode::Point:
+				m_Commands.Record(RenderCommands::SetPolygonMode{ mode });
+				break;
 			default:
 			{
 				KC_CORE_ERROR("Invalid PolygonMode: {}", (int)mode);
@@ -484,8 +571,10 @@ namespace KuchCraft {
 		m_RendererState.FrontFaceWinding = mode;
 		switch (mode)
 		{
-			case FaceWinding::CounterClockwise: glFrontFace(GL_CCW); break;
-			case FaceWinding::Clockwise:        glFrontFace(GL_CW);  break;
+			case FaceWinding::CounterClockwise:
+			case FaceWinding::Clockwise:
+				m_Commands.Record(RenderCommands::SetFrontFaceWinding{ mode });
+				break;
 			default : 
 			{
 				KC_CORE_ERROR("Invalid FrontFace mode: {}", (int)mode);
@@ -501,15 +590,18 @@ namespace KuchCraft {
 			return;
 
 		m_RendererState.DepthTestEnabled = enabled;
+		m_Commands.Record(RenderCommands::SetDepthTest{ enabled });
 		if (enabled)
-		{
-			glEnable(GL_DEPTH_TEST);
 			SetDepthFunc(m_RendererState.DepthFunc);
-		}
-		else
-		{
-			glDisable(GL_DEPTH_TEST);
-		}
+	}
+
+	void Renderer::SetDepthWrite(bool enabled)
+	{
+		if (!m_RendererState.ForceSet && m_RendererState.DepthWriteEnabled == enabled)
+			return;
+
+		m_RendererState.DepthWriteEnabled = enabled;
+		m_Commands.Record(RenderCommands::SetDepthWrite{ enabled });
 	}
 
 	void Renderer::SetDepthFunc(DepthFunc func)
@@ -520,14 +612,16 @@ namespace KuchCraft {
 		m_RendererState.DepthFunc = func;
 		switch (func)
 		{
-			case DepthFunc::Never:        glDepthFunc(GL_NEVER);    break;
-			case DepthFunc::Less:         glDepthFunc(GL_LESS);     break;
-			case DepthFunc::Equal:        glDepthFunc(GL_EQUAL);    break;
-			case DepthFunc::LessEqual:    glDepthFunc(GL_LEQUAL);   break;
-			case DepthFunc::Greater:      glDepthFunc(GL_GREATER);  break;
-			case DepthFunc::NotEqual:     glDepthFunc(GL_NOTEQUAL); break;
-			case DepthFunc::GreaterEqual: glDepthFunc(GL_GEQUAL);   break;
-			case DepthFunc::Always:       glDepthFunc(GL_ALWAYS);   break;
+			case DepthFunc::Never:
+			case DepthFunc::Less:
+			case DepthFunc::Equal:
+			case DepthFunc::LessEqual:
+			case DepthFunc::Greater:
+			case DepthFunc::NotEqual:
+			case DepthFunc::GreaterEqual:
+			case DepthFunc::Always:
+				m_Commands.Record(RenderCommands::SetDepthFunc{ func });
+				break;
 			default:
 			{
 				KC_CORE_ERROR("Invalid DepthFunc mode: {}", (int)func);
@@ -543,28 +637,9 @@ namespace KuchCraft {
 			return;
 
 		m_RendererState.BlendEnabled = enabled;
+		m_Commands.Record(RenderCommands::SetBlend{ enabled });
 		if (enabled)
-		{
-			glEnable(GL_BLEND);
 			SetBlendFunc(m_RendererState.SrcBlendFunc, m_RendererState.DstBlendFunc);
-		}
-		else
-		{
-			glDisable(GL_BLEND);
-		}
-	}
-
-	GLenum BlendFuncToGLenum(BlendFunc func)
-	{
-		switch (func)
-		{
-			case BlendFunc::Zero:             return GL_ZERO;
-			case BlendFunc::One:              return GL_ONE;
-			case BlendFunc::SrcAlpha:         return GL_SRC_ALPHA;
-			case BlendFunc::OneMinusSrcAlpha: return GL_ONE_MINUS_SRC_ALPHA;
-		}
-
-		return GL_ONE;
 	}
 
 	void Renderer::SetBlendFunc(BlendFunc src, BlendFunc dst)
@@ -582,8 +657,7 @@ namespace KuchCraft {
 			return;
 		}
 
-		glBlendFunc(BlendFuncToGLenum(src), BlendFuncToGLenum(dst));
-		glBlendEquation(GL_FUNC_ADD);
+		m_Commands.Record(RenderCommands::SetBlendFunc{ src, dst });
 	}
 
 	void Renderer::SetCullFace(bool enabled)
@@ -592,15 +666,9 @@ namespace KuchCraft {
 			return;
 
 		m_RendererState.CullFaceEnabled = enabled;
+		m_Commands.Record(RenderCommands::SetCullFace{ enabled });
 		if (enabled)
-		{
-			glEnable(GL_CULL_FACE);
 			SetCullMode(m_RendererState.CullFaceMode);
-		}
-		else
-		{
-			glDisable(GL_CULL_FACE);
-		}
 	}
 
 	void Renderer::SetCullMode(CullMode mode)
@@ -611,9 +679,11 @@ namespace KuchCraft {
 		m_RendererState.CullFaceMode = mode;
 		switch (mode)
 		{
-			case CullMode::Front:        glCullFace(GL_FRONT);          break;
-			case CullMode::Back:         glCullFace(GL_BACK);           break;
-			case CullMode::FrontAndBack: glCullFace(GL_FRONT_AND_BACK); break;
+			case CullMode::Front:
+			case CullMode::Back:
+			case CullMode::FrontAndBack:
+				m_Commands.Record(RenderCommands::SetCullMode{ mode });
+				break;
 			default:
 			{
 				KC_CORE_ERROR("Invalid CullMode: {}", (int)mode);
@@ -633,39 +703,12 @@ namespace KuchCraft {
 		m_RendererState.PolygonOffsetFactor  = factor;
 		m_RendererState.PolygonOffsetUnits   = units;
 
-		if (enabled)
-		{
-			glEnable(GL_POLYGON_OFFSET_FILL);
-			glPolygonOffset(factor, units);
-		}
-		else
-		{
-			glDisable(GL_POLYGON_OFFSET_FILL);
-		}
-	}
-
-	inline GLenum ToOpenGLPrimitive(PrimitiveTopology topology)
-	{
-		switch (topology)
-		{
-			case PrimitiveTopology::Points:             return GL_POINTS;
-			case PrimitiveTopology::Lines:              return GL_LINES;
-			case PrimitiveTopology::LineStrip:          return GL_LINE_STRIP;
-			case PrimitiveTopology::Triangles:          return GL_TRIANGLES;
-			case PrimitiveTopology::TriangleStrip:      return GL_TRIANGLE_STRIP;
-			case PrimitiveTopology::TriangleFan:        return GL_TRIANGLE_FAN;
-			case PrimitiveTopology::LinesAdjacency:     return GL_LINES_ADJACENCY;
-			case PrimitiveTopology::TrianglesAdjacency: return GL_TRIANGLES_ADJACENCY;
-			case PrimitiveTopology::Patches:            return GL_PATCHES;
-			default:
-				KC_CORE_ERROR("Unknown PrimitiveTopology: {}", static_cast<int>(topology));
-				return GL_TRIANGLES;
-		}
+		m_Commands.Record(RenderCommands::SetPolygonOffset{ enabled, factor, units });
 	}
 
 	void Renderer::DrawArrays(PrimitiveTopology topology, uint32_t firstVertex, uint32_t vertexCount)
 	{
-		glDrawArrays(ToOpenGLPrimitive(topology), firstVertex, vertexCount);
+		m_Commands.Record(RenderCommands::DrawArrays{ topology, firstVertex, vertexCount });
 
 		m_Stats.DrawCalls++;
 		m_Stats.Primitives += GetPrimitiveCount(topology, vertexCount);
@@ -673,7 +716,15 @@ namespace KuchCraft {
 
 	void Renderer::DrawArraysInstanced(PrimitiveTopology topology, uint32_t firstVertex, uint32_t vertexCount, uint32_t instanceCount)
 	{
-		glDrawArraysInstanced(ToOpenGLPrimitive(topology), firstVertex, vertexCount, instanceCount);
+		m_Commands.Record(RenderCommands::DrawArrays{ topology, firstVertex, vertexCount, instanceCount });
+
+		m_Stats.DrawCalls++;
+		m_Stats.Primitives += GetPrimitiveCount(topology, vertexCount) * instanceCount;
+	}
+
+	void Renderer::DrawArraysInstancedBaseInstance(PrimitiveTopology topology, uint32_t firstVertex, uint32_t vertexCount, uint32_t instanceCount, uint32_t baseInstance)
+	{
+		m_Commands.Record(RenderCommands::DrawArrays{ topology, firstVertex, vertexCount, instanceCount, baseInstance });
 
 		m_Stats.DrawCalls++;
 		m_Stats.Primitives += GetPrimitiveCount(topology, vertexCount) * instanceCount;
@@ -681,7 +732,7 @@ namespace KuchCraft {
 
 	void Renderer::DrawElements(PrimitiveTopology topology, uint32_t indexCount, uint32_t firstIndex)
 	{
-		glDrawElements(ToOpenGLPrimitive(topology), indexCount, GL_UNSIGNED_INT, (void*)(sizeof(uint32_t) * firstIndex));
+		m_Commands.Record(RenderCommands::DrawElements{ topology, indexCount, firstIndex });
 
 		m_Stats.DrawCalls++;
 		m_Stats.Primitives += GetPrimitiveCount(topology, indexCount);
@@ -689,7 +740,7 @@ namespace KuchCraft {
 
 	void Renderer::DrawElementsInstanced(PrimitiveTopology topology, uint32_t indexCount, uint32_t firstIndex, uint32_t instanceCount)
 	{
-		glDrawElementsInstanced(ToOpenGLPrimitive(topology), indexCount, GL_UNSIGNED_INT, (void*)(sizeof(uint32_t) * firstIndex), instanceCount);
+		m_Commands.Record(RenderCommands::DrawElements{ topology, indexCount, firstIndex, instanceCount });
 
 		m_Stats.DrawCalls++;
 		m_Stats.Primitives += GetPrimitiveCount(topology, indexCount) * instanceCount;
@@ -697,7 +748,7 @@ namespace KuchCraft {
 
 	void Renderer::DrawElementsBaseVertex(PrimitiveTopology topology, uint32_t indexCount, uint32_t firstIndex, int32_t baseVertex)
 	{
-		glDrawElementsBaseVertex(ToOpenGLPrimitive(topology), indexCount, GL_UNSIGNED_INT, (void*)(sizeof(uint32_t) * firstIndex), baseVertex);
+		m_Commands.Record(RenderCommands::DrawElements{ topology, indexCount, firstIndex, 1, baseVertex });
 
 		m_Stats.DrawCalls++;
 		m_Stats.Primitives += GetPrimitiveCount(topology, indexCount);
@@ -705,7 +756,7 @@ namespace KuchCraft {
 
 	void Renderer::DrawElementsInstancedBaseVertex(PrimitiveTopology topology, uint32_t indexCount, uint32_t firstIndex, uint32_t instanceCount, int32_t baseVertex)
 	{
-		glDrawElementsInstancedBaseVertex(ToOpenGLPrimitive(topology), indexCount, GL_UNSIGNED_INT, (void*)(sizeof(uint32_t) * firstIndex), instanceCount, baseVertex);
+		m_Commands.Record(RenderCommands::DrawElements{ topology, indexCount, firstIndex, instanceCount, baseVertex });
 
 		m_Stats.DrawCalls++;
 		m_Stats.Primitives += GetPrimitiveCount(topology, indexCount) * instanceCount;
@@ -713,7 +764,7 @@ namespace KuchCraft {
 
 	void Renderer::DrawElementsInstancedBaseVertexBaseInstance(PrimitiveTopology topology, uint32_t indexCount, uint32_t firstIndex, uint32_t instanceCount, int32_t baseVertex, uint32_t baseInstance)
 	{
-		glDrawElementsInstancedBaseVertexBaseInstance(ToOpenGLPrimitive(topology), indexCount, GL_UNSIGNED_INT, (void*)(sizeof(uint32_t) * firstIndex), instanceCount, baseVertex, baseInstance);
+		m_Commands.Record(RenderCommands::DrawElements{ topology, indexCount, firstIndex, instanceCount, baseVertex, baseInstance });
 
 		m_Stats.DrawCalls++;
 		m_Stats.Primitives += GetPrimitiveCount(topology, indexCount) * instanceCount;
@@ -721,7 +772,7 @@ namespace KuchCraft {
 
 	void Renderer::DrawRangeElements(PrimitiveTopology topology, uint32_t start, uint32_t end, uint32_t count)
 	{
-		glDrawRangeElements(ToOpenGLPrimitive(topology), start, end, count, GL_UNSIGNED_INT, nullptr);
+		m_Commands.Record(RenderCommands::DrawRangeElements{ topology, start, end, count });
 
 		m_Stats.DrawCalls++;
 		m_Stats.Primitives += GetPrimitiveCount(topology, count);
@@ -729,103 +780,121 @@ namespace KuchCraft {
 
 	void Renderer::MultiDrawArrays(PrimitiveTopology topology, const std::vector<int>& firsts, const std::vector<int>& counts)
 	{
-		glMultiDrawArrays(ToOpenGLPrimitive(topology), firsts.data(), counts.data(), static_cast<GLsizei>(counts.size()));
+		const uint64_t dataOffset = m_Commands.RecordData(firsts.data(), firsts.size() * sizeof(int));
+		m_Commands.RecordData(counts.data(), counts.size() * sizeof(int));
+		m_Commands.Record(RenderCommands::MultiDrawArrays{ topology, static_cast<uint32_t>(counts.size()), dataOffset });
 
 		m_Stats.DrawCalls++;
 		for (auto count : counts)
 			m_Stats.Primitives += GetPrimitiveCount(topology, count);
 	}
 
-	void Renderer::MultiDrawElements(PrimitiveTopology topology, const std::vector<GLsizei>& counts, const std::vector<void*>& offsets)
+	void Renderer::MultiDrawElements(PrimitiveTopology topology, const std::vector<int>& counts, const std::vector<uint64_t>& offsets)
 	{
-		glMultiDrawElements(ToOpenGLPrimitive(topology), counts.data(), GL_UNSIGNED_INT, offsets.data(), static_cast<GLsizei>(counts.size()));
+		const uint64_t dataOffset = m_Commands.RecordData(counts.data(), counts.size() * sizeof(int));
+		m_Commands.RecordData(offsets.data(), offsets.size() * sizeof(uint64_t));
+		m_Commands.Record(RenderCommands::MultiDrawElements{ topology, static_cast<uint32_t>(counts.size()), dataOffset });
 
 		m_Stats.DrawCalls++;
 		for (auto count : counts)
 			m_Stats.Primitives += GetPrimitiveCount(topology, count);
 	}
 
-	void Renderer::DrawArraysIndirect(PrimitiveTopology topology, const void* indirect)
+	void Renderer::DrawArraysIndirect(PrimitiveTopology topology, uint64_t indirect)
 	{
-		glDrawArraysIndirect(ToOpenGLPrimitive(topology), indirect);
+		m_Commands.Record(RenderCommands::DrawIndirect{ topology, false, 1, indirect });
 
 		m_Stats.DrawCalls++;
 	}
 
-	void Renderer::DrawElementsIndirect(PrimitiveTopology topology, const void* indirect)
+	void Renderer::MultiDrawArraysIndirect(PrimitiveTopology topology, uint64_t indirect, uint32_t drawCount)
 	{
-		glDrawElementsIndirect(ToOpenGLPrimitive(topology), GL_UNSIGNED_INT, indirect);
+		m_Commands.Record(RenderCommands::DrawIndirect{ topology, false, drawCount, indirect });
 
 		m_Stats.DrawCalls++;
 	}
 
+	void Renderer::DrawElementsIndirect(PrimitiveTopology topology, uint64_t indirect)
+	{
+		m_Commands.Record(RenderCommands::DrawIndirect{ topology, true, 1, indirect });
 
-	void Renderer::ResetStats()
+		m_Stats.DrawCalls++;
+	}
+
+	void Renderer::BindShader(const Ref<Shader>& shader)
 	{
-		m_Stats.DrawCalls  = 0;
-		m_Stats.Primitives = 0;
+		m_Commands.Record(RenderCommands::BindShader{ shader->GetRendererID() });
 	}
 
-	void Renderer::InitSprites()
+	void Renderer::BindVertexArray(const Ref<VertexArray>& vertexArray)
 	{
-		/// Graphics
-		m_Sprites.MaxQuadsInBatch = m_Config.Renderer.MaxQuadsInBatch;
-		m_Sprites.MaxIndices  = m_Sprites.MaxQuadsInBatch * quad_index_count;
-		m_Sprites.MaxVertices = m_Sprites.MaxQuadsInBatch * quad_vertex_count;
+		m_Commands.Record(RenderCommands::BindVertexArray{ vertexArray->GetRendererID() });
+	}
 
-		m_Sprites.Shader = m_ShaderLibrary.Load(std::filesystem::path("Sprite.glsl"));
-		m_Sprites.Shader->Bind();
+	void Renderer::BindTexture(uint32_t slot, RendererID texture)
+	{
+		m_Commands.Record(RenderCommands::BindTexture{ slot, texture });
+	}
 
-		m_Sprites.VertexArray = VertexArray::Create();
-		m_Sprites.VertexArray->Bind();
-		m_Sprites.VertexArray->SetDebugName("Sprites_VAO");
+	void Renderer::SetUniformInt(const Ref<Shader>& shader, const std::string& name, int value)
+	{
+		m_Commands.Record(RenderCommands::SetUniformInt{ shader->GetRendererID(), shader->FindUniformLocation(name), value });
+	}
 
-		m_Sprites.VertexBuffer = VertexBuffer::Create(VertexBufferDataUsage::Dynamic, m_Sprites.MaxVertices * sizeof(VertexQuad2D));
-		m_Sprites.VertexBuffer->SetDebugName("Sprites_VBO");
-		m_Sprites.VertexBuffer->SetLayout(m_Sprites.Shader->GetVertexInputLayout());
-		m_Sprites.VertexArray ->AddVertexBuffer(m_Sprites.VertexBuffer);
+	void Renderer::SetVertexBufferData(VertexBuffer* buffer, const void* data, size_t size, size_t offset)
+	{
+		m_Commands.Record(RenderCommands::SetVertexBufferData{ buffer, offset, size, m_Commands.RecordData(data, size) });
+	}
 
-		std::vector<uint32_t> indices;
-		indices.reserve(m_Sprites.MaxIndices);
-		uint32_t offset = 0;
-		for (uint32_t i = 0; i < m_Sprites.MaxIndices; i += quad_index_count)
-		{
-			indices.push_back(offset + 0);
-			indices.push_back(offset + 1);
-			indices.push_back(offset + 2);
-			indices.push_back(offset + 2);
-			indices.push_back(offset + 3);
-			indices.push_back(offset + 0);
-
-			offset += quad_vertex_count;
-		}
+	void Renderer::SetUniformBufferData(UniformBuffer* buffer, const void* data, size_t size, size_t offset)
+	{
+		m_Commands.Record(RenderCommands::SetUniformBufferData{ buffer, offset, size, m_Commands.RecordData(data, size) });
+	}
 
-		m_Sprites.IndexBuffer = IndexBuffer::Create(indices.data(), m_Sprites.MaxIndices);
-		m_Sprites.IndexBuffer->SetDebugName("Sprites_IBO");
-		m_Sprites.VertexArray->SetIndexBuffer(m_Sprites.IndexBuffer);
+	void Renderer::SetStorageBufferData(StorageBuffer* buffer, const void* data, size_t size)
+	{
+		m_Commands.Record(RenderCommands::SetStorageBufferData{ buffer, size, m_Commands.RecordData(data, size) });
+	}
 
-		auto setupTexturesSamplers = [this](Shader* shader) {
-			std::vector<int> samplers;
-			samplers.reserve(m_Config.Renderer.MaxCombinedTextureSlots);
-			for (int i = 0; i < m_Config.Renderer.MaxCombinedTextureSlots; i++)
-				samplers.push_back(i);
+	void Renderer::SetIndirectBufferData(IndirectBuffer* buffer, const void* data, size_t size)
+	{
+		m_Commands.Record(RenderCommands::SetIndirectBufferData{ buffer, size, m_Commands.RecordData(data, size) });
+	}
 
-			shader->SetIntArray("u_Textures", samplers.data(), m_Config.Renderer.MaxCombinedTextureSlots);
-		};	
+	void Renderer::ResetStats()
+	{
+		m_Stats.DrawCalls        = 0;
+		m_Stats.Primitives       = 0;
+		m_Stats.ChunkUploadBytes = 0;
+		m_Stats.VisibleChunks    = 0;
+		m_Stats.CulledChunks     = 0;
+		m_Stats.VisibleSections  = 0;
+		m_Stats.CulledSections   = 0;
+		m_Stats.OccludedSections = 0;
+		m_Stats.VisibilityMilliseconds = 0.0f;
+	}
 
-		setupTexturesSamplers(m_Sprites.Shader.get());
-		m_Sprites.Shader->AddReloadCallback(setupTexturesSamplers);
+	void Renderer::AddBatchStats(const BatchRendererStats& stats)
+	{
+		m_Stats.DrawCalls  += stats.DrawCalls;
+		m_Stats.Primitives += stats.Primitives;
+	}
 
-		/// Internal
-		m_Sprites.Textures.resize(m_Config.Renderer.MaxCombinedTextureSlots, 0);
-		m_Sprites.Textures[0] = m_WhiteTexture->GetRendererID();
+	void Renderer::InitSprites()
+	{
+		BatchRendererSpecification specification;
+		specification.Name                 = "Sprites";
+		specification.Shader               = m_ShaderLibrary.Load(std::filesystem::path("Sprite.glsl"));
+		specification.MaxPrimitivesInBatch = m_Config.Renderer.MaxQuadsInBatch;
+		specification.TextureSlotCount     = m_Config.Renderer.MaxCombinedTextureSlots;
+		specification.WhiteTexture         = m_WhiteTexture->GetRendererID();
 
-		m_Sprites.Vertices.reserve(m_Sprites.MaxVertices);
+		m_Sprites.Init(specification);
 	}
 
 	void Renderer::RenderSprites()
 	{
-		if (m_Sprites.Vertices.empty())
+		if (m_Sprites.IsEmpty())
 			return;
 
 		SetBlend(true);
@@ -836,283 +905,406 @@ namespace KuchCraft {
 		SetPolygonMode(PolygonMode::Fill);
 		SetPolygonOffset(false);
 
-		m_Sprites.Shader     ->Bind();
-		m_WhiteTexture       ->Bind(0);
-		m_Sprites.VertexArray->Bind();
+		/// Sprites are blended, so farther ones go first. Sprites at the same depth are grouped by texture,
+		/// overlapping ones need different depths to keep their order
+		const RendererID spriteShader = m_Sprites.GetShader()->GetRendererID();
+		const glm::mat4& orthoProjection = m_EnvironmentUniformBufferData.OrthoProjection;
 
-		m_Sprites.VertexOffset = 0;
+		m_Sprites.Submit(m_Commands, [&](const VertexQuad2D* quad, RendererID texture) {
+			/// Normalized device depth moved from [-1, 1] to [0, 2]
+			const float depth = (orthoProjection * glm::vec4(quad[0].Position, 1.0f)).z + 1.0f;
+			return RenderSortKey::Blended(RenderPass::Overlay, RenderSortKey::BackToFront(depth), spriteShader, texture);
+		});
 
-		StartBatchSprites();
-		for (size_t i = 0; i < m_Sprites.Vertices.size(); i += quad_vertex_count)
-		{
-			if (m_Sprites.CurrentIndexCount == m_Sprites.MaxIndices)
-				NextBatchSprites();
+		AddBatchStats(m_Sprites.GetStats());
+	}
 
-			/// TextureSlot temporarily holds the texture rendererID
-			if (m_Sprites.Vertices[i].TextureSlot == 0)
-			{
-				/// Just color, white texture is bound to slot 0
-				m_Sprites.CurrentIndexCount += quad_index_count;
-			}
-			else
-			{
-				/// Do we already have assigned slot to that texture?
-				int textureSlot = 0;
-				for (size_t j = 1; j < m_Sprites.CurrentTextureSlot; j++)
-				{
-					if (m_Sprites.Textures[j] == (RendererID)m_Sprites.Vertices[i].TextureSlot) /// TextureSlot temporarily holds the texture rendererID
-					{
-						textureSlot = (int)j;
-						break;
-					}
-				}
+	void Renderer::InitPlanes()
+	{
+		BatchRendererSpecification specification;
+		specification.Name                 = "Planes";
+		specification.Shader               = m_ShaderLibrary.Load(std::filesystem::path("Plane.glsl"));
+		specification.MaxPrimitivesInBatch = m_Config.Renderer.MaxPlanesInBatch;
+		specification.TextureSlotCount     = m_Config.Renderer.MaxCombinedTextureSlots;
+		specification.WhiteTexture         = m_WhiteTexture->GetRendererID();
 
-				/// If not, do it
-				if (textureSlot == 0)
-				{
-					if (m_Sprites.CurrentTextureSlot >= m_Config.Renderer.MaxCombinedTextureSlots)
-						NextBatchSprites();
+		m_Planes.Init(specification);
+	}
 
-					textureSlot = (int)m_Sprites.CurrentTextureSlot;
-					m_Sprites.Textures[m_Sprites.CurrentTextureSlot] = (RendererID)m_Sprites.Vertices[i].TextureSlot;
-					m_Sprites.CurrentTextureSlot++;
-				}
+	void Renderer::RenderPlanes()
+	{
+		if (m_Planes.IsEmpty())
+			return;
 
-				m_Sprites.Vertices[i + 0].TextureSlot = textureSlot;
-				m_Sprites.Vertices[i + 1].TextureSlot = textureSlot;
-				m_Sprites.Vertices[i + 2].TextureSlot = textureSlot;
-				m_Sprites.Vertices[i + 3].TextureSlot = textureSlot;
+		SetBlend(true);
+		SetBlendFunc(BlendFunc::SrcAlpha, BlendFunc::OneMinusSrcAlpha);
+		SetCullFace(false);
+		SetDepthTest(true);
+		SetDepthFunc(DepthFunc::LessEqual);
+		SetPolygonMode(PolygonMode::Fill);
+		SetPolygonOffset(false);
 
-				m_Sprites.CurrentIndexCount += quad_index_count;
-			}
-		}
+		/// Planes are blended, so the farthest from the camera go first and planes at the same distance are grouped by texture
+		const RendererID planeShader    = m_Planes.GetShader()->GetRendererID();
+		const glm::vec3  cameraPosition = m_Camera ? m_Camera->GetPosition() : glm::vec3(0.0f);
 
-		FlushSprites();
+		m_Planes.Submit(m_Commands, [&](const VertexPlane* plane, RendererID texture) {
+			const glm::vec3 center = (plane[0].Position + plane[2].Position) * 0.5f;
+			return RenderSortKey::Blended(RenderPass::Translucent, RenderSortKey::BackToFront(glm::distance2(center, cameraPosition)), planeShader, texture);
+		});
 
-		m_Sprites.Vertices.clear();
+		AddBatchStats(m_Planes.GetStats());
 	}
 
-	void Renderer::StartBatchSprites()
+	void Renderer::InitChunks()
 	{
-		m_Sprites.CurrentIndexCount  = 0;
-		m_Sprites.CurrentTextureSlot = 1; /// 0 is reserved for a default white texture
+		/// Grown on demand by SetData, a few thousand sections are drawn in a typical frame
+		constexpr size_t initial_chunk_draw_count = 4096;
+
+		m_Chunks.DrawDataBuffer = StorageBuffer::Create(initial_chunk_draw_count * sizeof(ChunkDrawData));
+		m_Chunks.DrawDataBuffer->SetDebugName("ChunkDrawData_SSBO");
+		m_ShaderLibrary.SetGlobalSubstitution("CHUNK_DRAW_DATA_BINDING", std::to_string(m_Chunks.DrawDataBuffer->GetBinding()));
+
+		m_Chunks.IndirectBuffer = IndirectBuffer::Create(initial_chunk_draw_count * sizeof(DrawArraysIndirectCommand));
+		m_Chunks.IndirectBuffer->SetDebugName("ChunkDrawCommands");
+
+		m_Chunks.Shader = m_ShaderLibrary.Load(std::filesystem::path("ChunkMesh.glsl"));
+		m_Chunks.Shader->Bind();
+
+		m_Chunks.Allocator = CreateScope<BufferAllocator>(m_Chunks.InitialCapacity);
+		CreateChunkBuffer(m_Chunks.InitialCapacity);
 	}
 
-	void Renderer::NextBatchSprites()
+	void Renderer::CreateChunkBuffer(uint32_t capacity)
 	{
-		FlushSprites();
-		StartBatchSprites();
+		m_Chunks.VertexArray = VertexArray::Create();
+		m_Chunks.VertexArray->Bind();
+		m_Chunks.VertexArray->SetDebugName("ChunkMesh_VAO");
+
+		m_Chunks.VertexBuffer = VertexBuffer::Create(VertexBufferDataUsage::Dynamic, static_cast<size_t>(capacity) * sizeof(BlockMesh));
+		m_Chunks.VertexBuffer->SetDebugName("ChunkMesh_VBO");
+		m_Chunks.VertexBuffer->SetLayout(m_Chunks.Shader->GetVertexInputLayout());
+		m_Chunks.VertexArray->AddVertexBuffer(m_Chunks.VertexBuffer, 1);
 	}
 
-	void Renderer::FlushSprites()
+	BufferAllocationID Renderer::AllocateChunkFaces(uint32_t faceCount)
 	{
-		if (m_Sprites.CurrentIndexCount == 0)
-			return;
+		if (faceCount == 0)
+			return invalid_buffer_allocation;
 
-		uint32_t vertexCount = m_Sprites.CurrentIndexCount / quad_index_count * quad_vertex_count;
-		m_Sprites.VertexBuffer->SetData(&m_Sprites.Vertices[m_Sprites.VertexOffset], vertexCount * sizeof(VertexQuad2D));
+		BufferAllocationID allocation = m_Chunks.Allocator->Allocate(faceCount);
+		if (allocation != invalid_buffer_allocation)
+			return allocation;
 
-		m_Sprites.VertexOffset += vertexCount;
-		for (int slot = 1; slot < (int)m_Sprites.CurrentTextureSlot; slot++)
-			Texture::Bind(slot, m_Sprites.Textures[slot]);
-		
-		DrawElements(PrimitiveTopology::Triangles, m_Sprites.CurrentIndexCount, 0);
-	}
+		/// Free space is either split into too small ranges or used up, both are fixed by moving every mesh into a new buffer.
+		/// A quarter of it is left free so the next failure is not right behind
+		const uint32_t required = m_Chunks.Allocator->GetUsedSize() + faceCount;
+		uint32_t capacity = m_Chunks.Allocator->GetCapacity();
+		while (capacity - capacity / 4 < required)
+			capacity *= 2;
 
-	void Renderer::InitPlanes()
-	{
-		/// Graphics
-		m_Planes.MaxPlanesInBatch = m_Config.Renderer.MaxPlanesInBatch;
-		m_Planes.MaxIndices  = m_Planes.MaxPlanesInBatch * plane_index_count;
-		m_Planes.MaxVertices = m_Planes.MaxPlanesInBatch * plane_vertex_count;
+		const uint32_t previousCapacity = m_Chunks.Allocator->GetCapacity();
+		const std::vector<BufferAllocatorMove> moves = m_Chunks.Allocator->Compact();
+		m_Chunks.Allocator->Grow(capacity);
 
-		m_Planes.Shader = m_ShaderLibrary.Load(std::filesystem::path("Plane.glsl"));
-		m_Planes.Shader->Bind();
+		/// Uploads recorded earlier in the frame land in the previous buffer before it is copied
+		ExecuteWithContext([&]() {
+			Ref<VertexBuffer> previous = m_Chunks.VertexBuffer;
+			CreateChunkBuffer(capacity);
 
-		m_Planes.VertexArray = VertexArray::Create();
-		m_Planes.VertexArray->Bind();
-		m_Planes.VertexArray->SetDebugName("Planes_VAO");
+			/// Everything before the first move stays where it was
+			const uint32_t unmoved = moves.empty() ? m_Chunks.Allocator->GetUsedSize() : moves.front().Destination;
+			m_Chunks.VertexBuffer->CopyData(previous, 0, 0, static_cast<size_t>(unmoved) * sizeof(BlockMesh));
+			for (const auto& move : moves)
+			{
+				m_Chunks.VertexBuffer->CopyData(previous, static_cast<size_t>(move.Source) * sizeof(BlockMesh),
+					static_cast<size_t>(move.Destination) * sizeof(BlockMesh), static_cast<size_t>(move.Size) * sizeof(BlockMesh));
+			}
+		});
 
-		m_Planes.VertexBuffer = VertexBuffer::Create(VertexBufferDataUsage::Dynamic, m_Planes.MaxVertices * sizeof(VertexPlane));
-		m_Planes.VertexBuffer->SetDebugName("Planes_VBO");
-		m_Planes.VertexBuffer->SetLayout(m_Planes.Shader->GetVertexInputLayout());
-		m_Planes.VertexArray->AddVertexBuffer(m_Planes.VertexBuffer);
+		KC_CORE_INFO("Chunk buffer compacted, {} moves, capacity {} -> {} faces", moves.size(), previousCapacity, capacity);
 
-		std::vector<uint32_t> indices;
-		indices.reserve(m_Planes.MaxIndices);
-		uint32_t offset = 0;
-		for (uint32_t i = 0; i < m_Planes.MaxIndices; i += plane_index_count)
-		{
-			indices.push_back(offset + 0);
-			indices.push_back(offset + 1);
-			indices.push_back(offset + 2);
-			indices.push_back(offset + 2);
-			indices.push_back(offset + 3);
-			indices.push_back(offset + 0);
-
-			offset += quad_vertex_count;
-		}
+		allocation = m_Chunks.Allocator->Allocate(faceCount);
+		KC_CORE_ASSERT(allocation != invalid_buffer_allocation, "Chunk buffer allocation failed after compaction!");
 
-		m_Planes.IndexBuffer = IndexBuffer::Create(indices.data(), m_Planes.MaxIndices);
-		m_Planes.IndexBuffer->SetDebugName("Planes_IBO");
-		m_Planes.VertexArray->SetIndexBuffer(m_Planes.IndexBuffer);
+		return allocation;
+	}
 
-		auto setupTexturesSamplers = [this](Shader* shader) {
-			std::vector<int> samplers;
-			samplers.reserve(m_Config.Renderer.MaxCombinedTextureSlots);
-			for (int i = 0; i < m_Config.Renderer.MaxCombinedTextureSlots; i++)
-				samplers.push_back(i);
+	void Renderer::FreeResidentChunk(ResidentChunk& resident)
+	{
+		for (auto& level : resident.Buffers)
+		{
+			for (auto& section : level)
+			{
+				for (auto& buffer : section)
+				{
+					m_Chunks.Allocator->Free(buffer.Allocation);
+					buffer = {};
+				}
+			}
+		}
+	}
 
-			shader->SetIntArray("u_Textures", samplers.data(), m_Config.Renderer.MaxCombinedTextureSlots);
-		};
+	void Renderer::EvictChunks()
+	{
+		for (auto it = m_Chunks.Resident.begin(); it != m_Chunks.Resident.end(); )
+		{
+			if (it->second.Owner.expired())
+			{
+				FreeResidentChunk(it->second);
+				it = m_Chunks.Resident.erase(it);
+			}
+			else
+				it++;
+		}
+	}
 
-		setupTexturesSamplers(m_Planes.Shader.get());
-		m_Planes.Shader->AddReloadCallback(setupTexturesSamplers);
+	Renderer::ResidentChunk& Renderer::UploadChunkMesh(const Ref<ChunkMesh>& chunkMesh, uint32_t lod)
+	{
+		ResidentChunk& resident = m_Chunks.Resident[chunkMesh.get()];
+		resident.Owner = chunkMesh;
 
-		/// Internal
-		m_Planes.Textures.resize(m_Config.Renderer.MaxCombinedTextureSlots, 0);
-		m_Planes.Textures[0] = m_WhiteTexture->GetRendererID();
+		for (size_t i = 0; i < sections_per_chunk; i++)
+		{
+			const SectionMesh& section = chunkMesh->GetSectionMesh(i, lod);
+			for (size_t bucket = 0; bucket < chunk_mesh_bucket_count; bucket++)
+			{
+				const MeshBuffer&    buffer         = section.Buffers[bucket];
+				ResidentChunkBuffer& residentBuffer = resident.Buffers[lod][i][bucket];
+				if (residentBuffer.Version == buffer.Version)
+					continue;
+
+				/// Freed first so a remeshed section of similar size can take its own place again
+				m_Chunks.Allocator->Free(residentBuffer.Allocation);
+				residentBuffer.Allocation = AllocateChunkFaces(buffer.Size);
+				residentBuffer.Version    = buffer.Version;
+				if (residentBuffer.Allocation == invalid_buffer_allocation)
+					continue;
+
+				const size_t offset = static_cast<size_t>(m_Chunks.Allocator->GetOffset(residentBuffer.Allocation)) * sizeof(BlockMesh);
+				const size_t size   = static_cast<size_t>(buffer.Size) * sizeof(BlockMesh);
+				SetVertexBufferData(m_Chunks.VertexBuffer.get(), buffer.Data, size, offset);
+				m_Stats.ChunkUploadBytes += size;
+			}
+		}
 
-		m_Planes.Vertices.reserve(m_Planes.MaxVertices);
+		return resident;
 	}
 
-	void Renderer::RenderPlanes()
+	void Renderer::RenderChunks()
 	{
-		if (m_Planes.Vertices.empty())
+		EvictChunks();
+
+		if (m_Chunks.Meshes.empty())
 			return;
 
-		SetBlend(true);
-		SetBlendFunc(BlendFunc::SrcAlpha, BlendFunc::OneMinusSrcAlpha);
-		SetCullFace(false);
-		SetDepthTest(true);
-		SetDepthFunc(DepthFunc::LessEqual);
-		SetPolygonMode(PolygonMode::Fill);
-		SetPolygonOffset(false);
+		if (!m_World)
+		{
+			m_Chunks.Meshes.clear();
+			return;
+		}
+
+		const glm::vec3 cameraPosition = m_Camera ? m_Camera->GetPosition() : glm::vec3(0.0f);
 
-		m_Planes.Shader     ->Bind();
-		m_WhiteTexture      ->Bind(0);
-		m_Planes.VertexArray->Bind();
+		struct ResidentDraw
+		{
+			ChunkMesh*     Mesh     = nullptr;
+			uint32_t       Lod      = 0;
+			ResidentChunk* Resident = nullptr;
+			/// Bit per section reached from the camera section
+			uint32_t       Reachable = ~0u;
+			/// Bit per section inside the frustum and reachable
+			uint32_t       Sections  = 0;
+		};
 
-		m_Planes.VertexOffset = 0;
+		/// Without a camera nothing is culled
+		const Frustum frustum = m_Camera ? Frustum(m_Camera->GetViewProjection()) : Frustum();
 
-		StartBatchPlanes();
-		for (size_t i = 0; i < m_Planes.Vertices.size(); i += plane_vertex_count)
+		/// Whole chunks first, chunks outside are neither sorted nor uploaded
+		m_Chunks.Culler.Clear();
+		m_Chunks.Culler.Reserve(m_Chunks.Meshes.size());
+		for (const auto& [mesh, lod] : m_Chunks.Meshes)
+			m_Chunks.Culler.Add(mesh->GetGlobalPosition(), mesh->GetGlobalPosition() + glm::vec3(chunk_size_x, chunk_size_y, chunk_size_z));
+
+		m_Stats.VisibleChunks = m_Chunks.Culler.Cull(frustum, m_Chunks.Visibility);
+		m_Stats.CulledChunks  = m_Chunks.Culler.GetCount() - m_Stats.VisibleChunks;
+
+		auto getChunkCoordinate = [](const ChunkMesh& mesh) {
+			const glm::vec3& position = mesh.GetGlobalPosition();
+			return glm::ivec2((int)std::floor(position.x / chunk_size_x), (int)std::floor(position.z / chunk_size_z));
+		};
+
+		/// Sections reachable from the camera section through open blocks, sealed caves and terrain behind hills are not
+		const bool caveCulling = m_Config.Renderer.CaveCulling && m_Camera;
+		if (caveCulling)
 		{
-			if (m_Planes.CurrentIndexCount == m_Planes.MaxIndices)
-				NextBatchPlanes();
+			Timer visibilityTimer;
 
-			/// TextureSlot temporarily holds the texture rendererID
-			if (m_Planes.Vertices[i].TextureSlot == 0)
+			glm::ivec2 minChunk = glm::ivec2(std::numeric_limits<int>::max());
+			glm::ivec2 maxChunk = glm::ivec2(std::numeric_limits<int>::min());
+			for (const auto& [mesh, lod] : m_Chunks.Meshes)
 			{
-				/// Just color, white texture is bound to slot 0
-				m_Planes.CurrentIndexCount += plane_index_count;
+				minChunk = glm::min(minChunk, getChunkCoordinate(*mesh));
+				maxChunk = glm::max(maxChunk, getChunkCoordinate(*mesh));
 			}
-			else
+
+			m_Chunks.VisibilityGraph.Reset(minChunk, maxChunk);
+			for (const auto& [mesh, lod] : m_Chunks.Meshes)
 			{
-				/// Do we already have assigned slot to that texture?
-				int textureSlot = 0;
-				for (size_t j = 1; j < m_Planes.CurrentTextureSlot; j++)
-				{
-					if (m_Planes.Textures[j] == (RendererID)m_Planes.Vertices[i].TextureSlot) /// TextureSlot temporarily holds the texture rendererID
-					{
-						textureSlot = (int)j;
-						break;
-					}
-				}
+				for (uint32_t i = 0; i < sections_per_chunk; i++)
+					m_Chunks.VisibilityGraph.SetConnectivity(getChunkCoordinate(*mesh), i, mesh->GetSectionConnectivity(i));
+			}
 
-				/// If not, do it
-				if (textureSlot == 0)
-				{
-					if (m_Planes.CurrentTextureSlot >= m_Config.Renderer.MaxCombinedTextureSlots)
-						NextBatchPlanes();
+			m_Chunks.VisibilityGraph.Traverse(cameraPosition, frustum);
+			m_Stats.VisibilityMilliseconds = static_cast<float>(visibilityTimer.GetElapsedMilliseconds());
+		}
 
-					textureSlot = (int)m_Planes.CurrentTextureSlot;
-					m_Planes.Textures[m_Planes.CurrentTextureSlot] = (RendererID)m_Planes.Vertices[i].TextureSlot;
-					m_Planes.CurrentTextureSlot++;
-				}
+		/// Uploads may move meshes into a new buffer, so all of them happen before anything is drawn
+		std::vector<ResidentDraw> draws;
+		draws.reserve(m_Stats.VisibleChunks);
+		for (size_t i = 0; i < m_Chunks.Meshes.size(); i++)
+		{
+			if (!m_Chunks.Visibility[i])
+				continue;
 
-				m_Planes.Vertices[i + 0].TextureSlot = textureSlot;
-				m_Planes.Vertices[i + 1].TextureSlot = textureSlot;
-				m_Planes.Vertices[i + 2].TextureSlot = textureSlot;
-				m_Planes.Vertices[i + 3].TextureSlot = textureSlot;
+			const auto& [mesh, lod] = m_Chunks.Meshes[i];
 
-				m_Planes.CurrentIndexCount += plane_index_count;
+			const uint32_t reachable = caveCulling ? m_Chunks.VisibilityGraph.GetVisibleSections(getChunkCoordinate(*mesh)) : ~0u;
+			if (!reachable)
+			{
+				m_Stats.VisibleChunks--;
+				m_Stats.CulledChunks++;
+				continue;
 			}
+
+			/// Faces inside a chunk are sorted in place and uploaded again. Far LOD chunks keep their faces in build order
+			if (lod == 0 && mesh->HasTranslucentFaces())
+				mesh->SortTranslucentFaces(cameraPosition);
+
+			draws.push_back({ mesh.get(), lod, &UploadChunkMesh(mesh, lod), reachable });
 		}
 
-		FlushPlanes();
+		/// Then sections of visible chunks that have anything to draw
+		m_Chunks.Culler.Clear();
+		for (const auto& draw : draws)
+		{
+			for (size_t i = 0; i < sections_per_chunk; i++)
+			{
+				if (draw.Mesh->GetSectionMesh(i, draw.Lod).IsEmpty())
+					continue;
 
-		m_Planes.Vertices.clear();
-	}
+				const glm::vec3 min = draw.Mesh->GetGlobalPosition() + glm::vec3(0.0f, static_cast<float>(i * section_size_y), 0.0f);
+				m_Chunks.Culler.Add(min, min + glm::vec3(section_size_x, section_size_y, section_size_z));
+			}
+		}
 
-	void Renderer::StartBatchPlanes()
-	{
-		m_Planes.CurrentIndexCount = 0;
-		m_Planes.CurrentTextureSlot = 1; /// 0 is reserved for a default white texture
-	}
+		m_Stats.VisibleSections = m_Chunks.Culler.Cull(frustum, m_Chunks.Visibility);
+		m_Stats.CulledSections  = m_Chunks.Culler.GetCount() - m_Stats.VisibleSections;
 
-	void Renderer::NextBatchPlanes()
-	{
-		FlushPlanes();
-		StartBatchPlanes();
-	}
+		size_t box = 0;
+		for (auto& draw : draws)
+		{
+			for (size_t i = 0; i < sections_per_chunk; i++)
+			{
+				if (draw.Mesh->GetSectionMesh(i, draw.Lod).IsEmpty() || !m_Chunks.Visibility[box++])
+					continue;
 
-	void Renderer::FlushPlanes()
-	{
-		if (m_Planes.CurrentIndexCount == 0)
-			return;
+				if (draw.Reachable & BIT(i))
+					draw.Sections |= BIT(i);
+				else
+					m_Stats.OccludedSections++;
+			}
+		}
+		m_Stats.VisibleSections -= m_Stats.OccludedSections;
+
+		/// Opaque chunks go nearest first so hidden faces fail the depth test early, translucent chunks are blended farthest first.
+		/// Both passes use one shader and the block texture, so only the pass and the distance decide the order
+		const RendererID chunkShader  = m_Chunks.Shader->GetRendererID();
+		const RendererID blockTexture = m_World->GetItemManager()->GetBlockTexture()->GetRendererID();
+		const glm::vec3  chunkCenter  = glm::vec3(chunk_size_x, chunk_size_y, chunk_size_z) * 0.5f;
+
+		RenderQueue& queue = m_Chunks.Queue;
+		queue.Clear();
+		queue.Reserve(draws.size() * 2);
+		for (uint32_t i = 0; i < static_cast<uint32_t>(draws.size()); i++)
+		{
+			const glm::vec3& position = draws[i].Mesh->GetGlobalPosition();
+			const float distance2 = glm::distance2(glm::vec2(position.x + chunkCenter.x, position.z + chunkCenter.z), glm::vec2(cameraPosition.x, cameraPosition.z));
 
-		uint32_t vertexCount = m_Planes.CurrentIndexCount / plane_index_count * plane_vertex_count;
-		m_Planes.VertexBuffer->SetData(&m_Planes.Vertices[m_Planes.VertexOffset], vertexCount * sizeof(VertexPlane));
+			queue.Add(RenderSortKey::Opaque(RenderPass::Opaque, chunkShader, blockTexture, RenderSortKey::FrontToBack(distance2)), i);
+			if (draws[i].Mesh->HasTranslucentFaces(draws[i].Lod))
+				queue.Add(RenderSortKey::Blended(RenderPass::Translucent, RenderSortKey::BackToFront(distance2), chunkShader, blockTexture), i);
+		}
+		queue.Sort();
 
-		m_Planes.VertexOffset += vertexCount;
-		for (int slot = 1; slot < (int)m_Planes.CurrentTextureSlot; slot++)
-			Texture::Bind(slot, m_Planes.Textures[slot]);
+		/// Sections of a chunk are stacked along y, the nearest one to the camera is the camera section clamped to the chunk
+		const int cameraSection = std::clamp((int)std::floor(cameraPosition.y / section_size_y), 0, (int)sections_per_chunk - 1);
 
-		DrawElements(PrimitiveTopology::Triangles, m_Planes.CurrentIndexCount, 0);
-	}
+		ChunkDrawCommandBuilder& commands = m_Chunks.DrawCommands;
+		commands.Clear();
 
-	void Renderer::InitChunks()
-	{
-		m_Chunks.Shader = m_ShaderLibrary.Load(std::filesystem::path("ChunkMesh.glsl"));
-		m_Chunks.Shader->Bind();
+		/// Opaque and cutout faces write depth and are never blended, cutout holes are discarded by the shader
+		const uint32_t opaqueFirst = commands.BeginBatch();
 
-		m_Chunks.VertexArray = VertexArray::Create();
-		m_Chunks.VertexArray->Bind();
-		m_Chunks.VertexArray->SetDebugName("ChunkMesh_VAO");
+		const auto& items = queue.GetItems();
+		size_t item = 0;
+		for (; item < items.size() && RenderSortKey::GetPass(items[item].Key) == RenderPass::Opaque; item++)
+		{
+			const ResidentDraw& draw = draws[items[item].Index];
+			const glm::vec3 origin   = draw.Mesh->GetGlobalPosition() + glm::vec3(0.5f, 0.5f, 0.5f);
+			const float     lodScale = static_cast<float>(BIT(draw.Lod));
+
+			/// Empty sections (air, fully enclosed stone) have nothing resident and are never drawn
+			int below = cameraSection;
+			int above = cameraSection + 1;
+			while (below >= 0 || above < (int)sections_per_chunk)
+			{
+				const int section = below >= 0 && (above >= (int)sections_per_chunk || cameraSection - below <= above - cameraSection) ? below-- : above++;
+				if (!(draw.Sections & BIT(section)))
+					continue;
 
-		m_Chunks.VertexBuffer = VertexBuffer::Create(VertexBufferDataUsage::Dynamic, m_Chunks.MaxVertices * sizeof(BlockMesh));
-		m_Chunks.VertexBuffer->SetDebugName("ChunkMesh_VBO");
-		m_Chunks.VertexBuffer->SetLayout(m_Chunks.Shader->GetVertexInputLayout());
-		m_Chunks.VertexArray->AddVertexBuffer(m_Chunks.VertexBuffer);
+				for (ChunkMeshBucket bucket : { ChunkMeshBucket::Opaque, ChunkMeshBucket::Cutout })
+				{
+					const ResidentChunkBuffer& buffer = draw.Resident->Buffers[draw.Lod][section][static_cast<size_t>(bucket)];
+					if (buffer.Allocation != invalid_buffer_allocation)
+						commands.Add(origin, lodScale, m_Chunks.Allocator->GetOffset(buffer.Allocation), m_Chunks.Allocator->GetSize(buffer.Allocation));
+				}
+			}
+		}
+		const uint32_t opaqueCount = commands.GetBatchSize();
 
-		std::vector<uint32_t> indices;
-		indices.reserve(m_Chunks.MaxIndices);
-		uint32_t offset = 0;
-		for (uint32_t i = 0; i < m_Chunks.MaxIndices; i += block_indicies_per_face)
+		/// Translucent faces are blended over everything else, farthest chunk and section first.
+		/// Commands of one call are drawn in order, so the whole pass still takes one call
+		const uint32_t translucentFirst = commands.BeginBatch();
+		for (; item < items.size(); item++)
 		{
-			indices.push_back(offset + 0);
-			indices.push_back(offset + 1);
-			indices.push_back(offset + 2);
-			indices.push_back(offset + 2);
-			indices.push_back(offset + 3);
-			indices.push_back(offset + 0);
-
-			offset += block_vertices_per_face;
+			const ResidentDraw& draw = draws[items[item].Index];
+			const glm::vec3 origin   = draw.Mesh->GetGlobalPosition() + glm::vec3(0.5f, 0.5f, 0.5f);
+			const float     lodScale = static_cast<float>(BIT(draw.Lod));
+
+			int below = 0;
+			int above = sections_per_chunk - 1;
+			while (below <= above)
+			{
+				const int section = cameraSection - below >= above - cameraSection ? below++ : above--;
+				if (!(draw.Sections & BIT(section)))
+					continue;
+
+				const ResidentChunkBuffer& buffer = draw.Resident->Buffers[draw.Lod][section][static_cast<size_t>(ChunkMeshBucket::Translucent)];
+				if (buffer.Allocation != invalid_buffer_allocation)
+					commands.Add(origin, lodScale, m_Chunks.Allocator->GetOffset(buffer.Allocation), m_Chunks.Allocator->GetSize(buffer.Allocation));
+			}
 		}
+		const uint32_t translucentCount = commands.GetBatchSize();
 
-		m_Chunks.IndexBuffer = IndexBuffer::Create(indices.data(), m_Chunks.MaxIndices);
-		m_Chunks.IndexBuffer->SetDebugName("ChunkMesh_IBO");
-		m_Chunks.VertexArray->SetIndexBuffer(m_Chunks.IndexBuffer);
-	}
+		m_Chunks.Meshes.clear();
 
-	void Renderer::RenderChunks()
-	{
-		if (m_Chunks.Meshes.empty())
+		if (commands.GetCommandCount() == 0)
 			return;
 
-		SetBlend(true);
-		SetBlendFunc(BlendFunc::SrcAlpha, BlendFunc::OneMinusSrcAlpha);
+		SetIndirectBufferData(m_Chunks.IndirectBuffer.get(), commands.GetCommands().data(), commands.GetCommands().size() * sizeof(DrawArraysIndirectCommand));
+		SetStorageBufferData(m_Chunks.DrawDataBuffer.get(), commands.GetDrawData().data(), commands.GetDrawData().size() * sizeof(ChunkDrawData));
+
 		SetCullFace(true);
 		SetCullMode(CullMode::Back);
 		SetDepthTest(true);
@@ -1120,22 +1312,41 @@ namespace KuchCraft {
 		SetPolygonMode(PolygonMode::Fill);
 		SetPolygonOffset(false);
 
-		m_Chunks.Shader     ->Bind();
-		m_Chunks.VertexArray->Bind();
+		BindShader(m_Chunks.Shader);
+		BindVertexArray(m_Chunks.VertexArray);
+		m_Commands.Record(RenderCommands::BindIndirectBuffer{ m_Chunks.IndirectBuffer->GetRendererID() });
 
-		if (!m_World)
-			return;
-		
-		m_World->GetItemManager()->GetBlockTexture()->Bind();
-		for (const auto& mesh : m_Chunks.Meshes)
+		BindTexture(0, m_World->GetItemManager()->GetBlockTexture()->GetRendererID());
+
+		SetBlend(false);
+		DrawChunkBatch(opaqueFirst, opaqueCount);
+
+		if (translucentCount > 0)
 		{
-			m_Chunks.Shader->SetFloat3("u_GlobalPosition", mesh->GetGlobalPosition() + glm::vec3(0.5f, 0.5f, 0.5f));
-			m_Chunks.VertexBuffer->SetData(mesh->GetMeshData().data(), mesh->GetMeshData().size() * sizeof(BlockMesh));
+			SetBlend(true);
+			SetBlendFunc(BlendFunc::SrcAlpha, BlendFunc::OneMinusSrcAlpha);
+			SetDepthWrite(false);
 
-			DrawElements(PrimitiveTopology::Triangles, mesh->GetMeshData().size() / block_vertices_per_face * block_indicies_per_face, 0);
+			DrawChunkBatch(translucentFirst, translucentCount);
+
+			SetDepthWrite(true);
 		}
 
-		m_Chunks.Meshes.clear();
+		m_Commands.Record(RenderCommands::BindIndirectBuffer{ 0 });
+	}
+
+	void Renderer::DrawChunkBatch(uint32_t first, uint32_t count)
+	{
+		if (count == 0)
+			return;
+
+		/// gl_DrawID starts from 0 in every call
+		SetUniformInt(m_Chunks.Shader, "u_DrawDataOffset", static_cast<int>(first));
+		MultiDrawArraysIndirect(PrimitiveTopology::Triangles, first * sizeof(DrawArraysIndirectCommand), count);
+
+		const auto& commands = m_Chunks.DrawCommands.GetCommands();
+		for (uint32_t i = first; i < first + count; i++)
+			m_Stats.Primitives += GetPrimitiveCount(PrimitiveTopology::Triangles, commands[i].Count) * commands[i].InstanceCount;
 	}
 
 }
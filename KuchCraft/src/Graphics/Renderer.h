@@ -11,7 +11,16 @@
 #include "Graphics/Core/FrameBuffer.h"
 #include "Graphics/Core/Texture.h"
 #include "Graphics/Core/UniformBuffer.h"
+#include "Graphics/Core/BufferAllocator.h"
+#include "Graphics/Core/StorageBuffer.h"
+#include "Graphics/Core/IndirectBuffer.h"
+#include "Graphics/Core/Frustum.h"
+#include "Graphics/Core/RenderQueue.h"
+#include "Graphics/Core/BatchRenderer.h"
+#include "Graphics/Core/RenderBackend.h"
+#include "Graphics/Core/RenderThread.h"
 #include "Graphics/KuchCraft/ChunkMesh.h"
+#include "Graphics/KuchCraft/ChunkDrawCommands.h"
 
 #include "KuchCraft/World/World.h"
 
@@ -27,9 +36,24 @@ namespace KuchCraft {
 		void NewFrame();
 		void EndFrame();
 
+		/// Executes the frame recorded since NewFrame, then `present` for whatever draws after it and swaps buffers.
+		/// With a render thread both run there and this only blocks while two frames are still in flight
+		void Present(std::function<void()> present = {});
+
 		/// Should be called by application when window is resized
 		void OnWindowResize(int width, int height);
 
+		/// Moves execution of frames to a render thread, `onStart` and `onStop` run there to take and release the OpenGL context.
+		/// Until StopRenderThread the caller must only use the context through ExecuteWithContext
+		void StartRenderThread(std::function<void()> onStart, std::function<void()> onStop);
+		/// Executes every frame in flight and joins the render thread, the context is released by then
+		void StopRenderThread();
+		bool IsRenderThreadRunning() const { return m_RenderThread != nullptr; }
+
+		/// Sync point for OpenGL work outside recorded frames, like creating or resizing resources and reloading shaders.
+		/// Commands recorded so far are executed first, then `function` runs on the thread that owns the context
+		void ExecuteWithContext(const std::function<void()>& function);
+
 #pragma region DrawCommands
 	public:
 		void DrawLine2D(const glm::vec2& start, const glm::vec2& end, const glm::vec4& color, float thickness);
@@ -56,7 +80,8 @@ namespace KuchCraft {
 		void DrawPlane(const glm::mat4& transform, const glm::vec4& color);
 		void DrawPlane(const glm::mat4& transform, const Ref<Texture2D>& texture, float tilingFactor = 1.0f, const glm::vec4& tintColor = glm::vec4(1.0f), glm::vec2 uv0 = glm::vec2(0.0f), glm::vec2 uv1 = glm::vec2(1.0f));
 
-		void DrawChunkMesh(const Ref<ChunkMesh>& chunkMesh) { m_Chunks.Meshes.push_back(chunkMesh); }
+		/// `lod` must be built, see ChunkMesh::BuildLod
+		void DrawChunkMesh(const Ref<ChunkMesh>& chunkMesh, uint32_t lod = 0) { m_Chunks.Meshes.emplace_back(chunkMesh, lod); }
 
 #pragma endregion
 
@@ -140,6 +165,7 @@ namespace KuchCraft {
 			FaceWinding FrontFaceWinding = FaceWinding::CounterClockwise;
 
 			bool DepthTestEnabled = true;
+			bool DepthWriteEnabled = true;
 			DepthFunc DepthFunc = DepthFunc::LessEqual;
 
 			bool BlendEnabled = true;
@@ -158,6 +184,7 @@ namespace KuchCraft {
 		void InitializeRendererState();
 		void SetPolygonMode(PolygonMode mode);
 		void SetDepthTest(bool enabled);
+		void SetDepthWrite(bool enabled);
 		void SetDepthFunc(DepthFunc func);
 		void SetBlend(bool enabled);
 		void SetBlendFunc(BlendFunc src, BlendFunc dst);
@@ -172,6 +199,7 @@ namespace KuchCraft {
 	private:
 		void DrawArrays(PrimitiveTopology topology, uint32_t firstVertex, uint32_t vertexCount);
 		void DrawArraysInstanced(PrimitiveTopology topology, uint32_t firstVertex, uint32_t vertexCount, uint32_t instanceCount);
+		void DrawArraysInstancedBaseInstance(PrimitiveTopology topology, uint32_t firstVertex, uint32_t vertexCount, uint32_t instanceCount, uint32_t baseInstance);
 
 		void DrawElements(PrimitiveTopology topology, uint32_t indexCount, uint32_t firstIndex);
 		void DrawElementsInstanced(PrimitiveTopology topology, uint32_t indexCount, uint32_t firstIndex, uint32_t instanceCount);
@@ -183,10 +211,40 @@ namespace KuchCraft {
 		void DrawRangeElements(PrimitiveTopology topology, uint32_t start, uint32_t end, uint32_t count);
 
 		void MultiDrawArrays(PrimitiveTopology topology, const std::vector<int>& firsts, const std::vector<int>& counts);
-		void MultiDrawElements(PrimitiveTopology topology, const std::vector<GLsizei>& counts, const std::vector<void*>& offsets);
+		/// `offsets` are in bytes of the bound index buffer
+		void MultiDrawElements(PrimitiveTopology topology, const std::vector<int>& counts, const std::vector<uint64_t>& offsets);
+
+		/// `indirect` is a byte offset into the bound IndirectBuffer
+		void DrawArraysIndirect(PrimitiveTopology topology, uint64_t indirect);
+		void MultiDrawArraysIndirect(PrimitiveTopology topology, uint64_t indirect, uint32_t drawCount);
+		void DrawElementsIndirect(PrimitiveTopology topology, uint64_t indirect);
+
+#pragma endregion
 
-		void DrawArraysIndirect(PrimitiveTopology topology, const void* indirect);
-		void DrawElementsIndirect(PrimitiveTopology topology, const void* indirect);
+#pragma region Commands
+	private:
+		/// Everything drawn in a frame is recorded between NewFrame and EndFrame and executed by the backend in Present,
+		/// on the render thread when it runs. Creating resources happens at sync points, see ExecuteWithContext
+		RenderCommandBuffer  m_Commands;
+		Scope<RenderBackend> m_Backend;
+		Scope<RenderThread>  m_RenderThread;
+
+		/// Commands of the current frame already executed at sync points
+		uint32_t m_FrameCommands     = 0;
+		size_t   m_FrameCommandBytes = 0;
+
+		void SubmitCommands(std::function<void()> present = {});
+
+		void BindShader(const Ref<Shader>& shader);
+		void BindVertexArray(const Ref<VertexArray>& vertexArray);
+		void BindTexture(uint32_t slot, RendererID texture);
+		void SetUniformInt(const Ref<Shader>& shader, const std::string& name, int value);
+
+		/// Data is copied into the command buffer, it may change right after the call
+		void SetVertexBufferData(VertexBuffer* buffer, const void* data, size_t size, size_t offset = 0);
+		void SetUniformBufferData(UniformBuffer* buffer, const void* data, size_t size, size_t offset = 0);
+		void SetStorageBufferData(StorageBuffer* buffer, const void* data, size_t size);
+		void SetIndirectBufferData(IndirectBuffer* buffer, const void* data, size_t size);
 
 #pragma endregion
 
@@ -195,88 +253,111 @@ namespace KuchCraft {
 		struct {
 			uint32_t DrawCalls  = 0;
 			uint32_t Primitives = 0;
+			/// Recorded commands and their size with copied data, of the last executed frame
+			uint32_t Commands     = 0;
+			size_t   CommandBytes = 0;
+			/// Chunk mesh bytes sent to the GPU this frame
+			size_t   ChunkUploadBytes = 0;
+
+			/// Submitted chunks and their non-empty sections, split by the camera frustum
+			uint32_t VisibleChunks   = 0;
+			uint32_t CulledChunks    = 0;
+			uint32_t VisibleSections = 0;
+			uint32_t CulledSections  = 0;
+			/// Inside the frustum but not reachable from the camera section
+			uint32_t OccludedSections = 0;
+			float    VisibilityMilliseconds = 0.0f;
 
 		} m_Stats;
 		
 		void ResetStats();
+		void AddBatchStats(const BatchRendererStats& stats);
 
 	public:
 		const auto& GetStats() const { return m_Stats; }
+		BufferAllocatorStats GetChunkBufferStats() const { return m_Chunks.Allocator->GetStats(); }
+		/// Zeroed stats when there is no render thread
+		RenderThreadStats GetRenderThreadStats() const;
 
 #pragma endregion
 
 #pragma region Sprites
 	private:
-		struct {
-			uint32_t MaxQuadsInBatch = 10'000;
-			uint32_t MaxIndices  = MaxQuadsInBatch * quad_index_count;
-			uint32_t MaxVertices = MaxQuadsInBatch * quad_vertex_count;
-
-			std::vector<VertexQuad2D> Vertices;
-			std::vector<RendererID>   Textures;
-			size_t CurrentTextureSlot = 1; /// 0 is reserved for a default white texture
-
-			uint32_t CurrentIndexCount = 0;
-			size_t   VertexOffset      = 0;
-
-			Ref<VertexArray>  VertexArray;
-			Ref<VertexBuffer> VertexBuffer;
-			Ref<IndexBuffer>  IndexBuffer;
-			Ref<Shader>       Shader;
-		} m_Sprites;
+		/// Quads are drawn back to front, quads at the same depth grouped by texture
+		BatchRenderer<VertexQuad2D, quad_vertex_count, quad_index_count> m_Sprites;
 
 		void InitSprites();
 		void RenderSprites();
-		void StartBatchSprites();
-		void NextBatchSprites();
-		void FlushSprites();
 
 #pragma endregion
 
 #pragma region Planes
 	private:
-		struct {
-			uint32_t MaxPlanesInBatch = 10'000;
-			uint32_t MaxIndices  = MaxPlanesInBatch * quad_index_count;
-			uint32_t MaxVertices = MaxPlanesInBatch * quad_vertex_count;
-
-			std::vector<VertexPlane> Vertices;
-			std::vector<RendererID>  Textures;
-			size_t CurrentTextureSlot = 1; /// 0 is reserved for a default white texture
-
-			uint32_t CurrentIndexCount = 0;
-			size_t   VertexOffset = 0;
-
-			Ref<VertexArray>  VertexArray;
-			Ref<VertexBuffer> VertexBuffer;
-			Ref<IndexBuffer>  IndexBuffer;
-			Ref<Shader>       Shader;
-		} m_Planes;
+		/// Planes are drawn back to front from the camera, planes at the same depth grouped by texture
+		BatchRenderer<VertexPlane, plane_vertex_count, plane_index_count> m_Planes;
 
 		void InitPlanes();
 		void RenderPlanes();
-		void StartBatchPlanes();
-		void NextBatchPlanes();
-		void FlushPlanes();
 
 #pragma endregion
 
 #pragma region Chunk
 		private:
+			/// Where one bucket of a section lives in the chunk buffer and which MeshBuffer::Version it holds
+			struct ResidentChunkBuffer
+			{
+				BufferAllocationID Allocation = invalid_buffer_allocation;
+				uint32_t           Version    = 0;
+			};
+
+			struct ResidentChunk
+			{
+				/// Buffers are freed once the mesh is destroyed
+				std::weak_ptr<ChunkMesh> Owner;
+				std::array<std::array<std::array<ResidentChunkBuffer, chunk_mesh_bucket_count>, sections_per_chunk>, chunk_mesh_lod_count> Buffers;
+			};
+
 			struct {
-				uint32_t MaxVertices = block_count_per_chunk * block_face_count * block_vertices_per_face * sizeof(BlockMesh);
-				uint32_t MaxIndices  = block_count_per_chunk * block_face_count * block_indicies_per_face;
+				/// Meshes stay in one vertex buffer between frames, a section is uploaded again only when it changed.
+				/// Offsets and sizes are counted in faces, one instance per face
+				uint32_t InitialCapacity = 4 * 1024 * 1024;
+
+				/// Mesh and its LOD level
+				std::vector<std::pair<Ref<ChunkMesh>, uint32_t>> Meshes;
+				std::unordered_map<const ChunkMesh*, ResidentChunk> Resident;
 
-				std::vector<Ref<ChunkMesh>> Meshes;
+				Scope<BufferAllocator> Allocator;
 				Ref<VertexArray>  VertexArray;
 				Ref<VertexBuffer> VertexBuffer;
-				Ref<IndexBuffer>  IndexBuffer;
 				Ref<Shader>       Shader;
+
+				/// Every visible section bucket becomes one command, opaque and translucent faces are drawn with one call each
+				ChunkDrawCommandBuilder DrawCommands;
+				/// Visible chunks, opaque faces front to back for early depth test and translucent ones back to front
+				RenderQueue             Queue;
+				Ref<IndirectBuffer>     IndirectBuffer;
+				Ref<StorageBuffer>      DrawDataBuffer;
+
+				/// Bounds of submitted chunks, then of sections of the visible ones
+				FrustumCuller        Culler;
+				std::vector<uint8_t> Visibility;
+				SectionVisibilityGraph VisibilityGraph;
 			} m_Chunks;
 
 			void InitChunks();
 			void RenderChunks();
 
+			void CreateChunkBuffer(uint32_t capacity);
+			/// Compacts the chunk buffer and grows it when it is still too small, returns invalid_buffer_allocation only for empty meshes
+			BufferAllocationID AllocateChunkFaces(uint32_t faceCount);
+			void FreeResidentChunk(ResidentChunk& resident);
+			/// Frees buffers of destroyed meshes
+			void EvictChunks();
+			/// Uploads buckets whose version changed since the last upload
+			ResidentChunk& UploadChunkMesh(const Ref<ChunkMesh>& chunkMesh, uint32_t lod);
+			/// Draws `count` commands of m_Chunks.DrawCommands starting at `first`
+			void DrawChunkBatch(uint32_t first, uint32_t count);
+
 #pragma endregion
 
 	private:
@@ -55,6 +55,23 @@ namespace KuchCraft {
 
 			ImGui::Text("Draw calls: %d", stats.DrawCalls);
 			ImGui::Text("Primitives: %d", stats.Primitives);
+			ImGui::Text("Commands: %u (%.2f KB)", stats.Commands, stats.CommandBytes / 1024.0f);
+			if (m_Renderer->IsRenderThreadRunning())
+			{
+				const RenderThreadStats threadStats = m_Renderer->GetRenderThreadStats();
+				const double frames = std::max(threadStats.Frames, 1u);
+				ImGui::Text("Render thread: %.3f ms execute, %.3f ms waiting per frame, %u syncs", threadStats.ExecuteTime / frames, threadStats.SubmitWaitTime / frames, threadStats.SyncCount);
+			}
+			ImGui::Text("Chunk uploads: %.2f KB", stats.ChunkUploadBytes / 1024.0f);
+			ImGui::Text("Chunks: %u visible, %u culled", stats.VisibleChunks, stats.CulledChunks);
+			ImGui::Text("Sections: %u visible, %u culled, %u occluded", stats.VisibleSections, stats.CulledSections, stats.OccludedSections);
+			ImGui::Checkbox("Cave culling", &m_Renderer->m_Config.Renderer.CaveCulling);
+			ImGui::SameLine();
+			ImGui::Text("%.3f ms", stats.VisibilityMilliseconds);
+
+			const BufferAllocatorStats chunkBuffer = m_Renderer->GetChunkBufferStats();
+			ImGui::Text("Chunk buffer: %.2f / %.2f MB", chunkBuffer.UsedSize * sizeof(BlockMesh) / (1024.0f * 1024.0f), chunkBuffer.Capacity * sizeof(BlockMesh) / (1024.0f * 1024.0f));
+			ImGui::Text("Chunk buffer ranges: %u used, %u free (%.0f%% fragmented)", chunkBuffer.AllocationCount, chunkBuffer.FreeRangeCount, chunkBuffer.GetFragmentation() * 100.0f);
 		}
 		
 		if (ImGui::CollapsingHeader("Shaders##RendererLayer"))
@@ -112,7 +129,9 @@ namespace KuchCraft {
 
 			if (ImGui::Button("Reload All##RendererLayer", ImVec2(ImGui::GetContentRegionAvail().x, 0.0f)))
 			{
-				m_Renderer->m_ShaderLibrary.ReloadAll();
+				m_Renderer->ExecuteWithContext([&]() {
+					m_Renderer->m_ShaderLibrary.ReloadAll();
+				});
 			}
 
 			if (m_ShadersInfo.Selected != -1)
@@ -127,7 +146,9 @@ namespace KuchCraft {
 
 					if (ImGui::Button("Reload##RendererLayer", ImVec2(ImGui::GetContentRegionAvail().x, 0.0f)))
 					{
-						shader->Reload();
+						m_Renderer->ExecuteWithContext([&]() {
+							shader->Reload();
+						});
 					}
 
 					ImGui::SeparatorText("");
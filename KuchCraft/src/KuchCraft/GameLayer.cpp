@@ -257,6 +257,47 @@ namespace KuchCraft {
 			}
 		}
 
+		if (ImGui::CollapsingHeader("World Generator##GameLayer"))
+		{
+			Ref<World> world = m_Scene->GetWorld();
+			if (world)
+			{
+				Ref<WorldGenerator> worldGenerator = world->GetWorldGenerator();
+				ImGui::Text("Seed: %u", worldGenerator->GetSeed());
+
+				const auto& pendingEdits = worldGenerator->GetPendingEdits();
+				ImGui::SeparatorText("Pending edits");
+				ImGui::Text("Target chunks: %zu", pendingEdits.GetTargetCount());
+				ImGui::Text("Edits: %zu", pendingEdits.GetEditCount());
+				ImGui::Text("Memory: %.2f KB", pendingEdits.GetMemoryUsage() / 1024.0f);
+			}
+		}
+
+		if (ImGui::CollapsingHeader("Chunk Meshes##GameLayer"))
+		{
+			Ref<World> world = m_Scene->GetWorld();
+			if (world)
+			{
+				ChunkMeshSettings settings = world->GetMeshSettings();
+				if (ImGui::Checkbox("Greedy meshing", &settings.Greedy))
+					world->SetMeshSettings(settings);
+				if (ImGui::Checkbox("Ambient occlusion", &settings.AmbientOcclusion))
+					world->SetMeshSettings(settings);
+
+				const WorldMeshStats stats = world->GetMeshStats();
+				ImGui::Text("Chunks: %u", stats.ChunkCount);
+				ImGui::Text("Faces: %u", stats.FaceCount);
+				ImGui::Text("Quads: %u", stats.QuadCount);
+				ImGui::Text("Quad reduction: %.2fx", stats.QuadCount > 0 ? (float)stats.FaceCount / (float)stats.QuadCount : 1.0f);
+				ImGui::Text("Drawn quads: %u (%u chunks at LOD)", stats.DrawnQuadCount, stats.LodChunkCount);
+
+				const MeshBufferPoolStats poolStats = MeshBufferPool::Get().GetStats();
+				ImGui::Text("Mesh memory: %.2f MB (%.2f MB allocated)", poolStats.MeshBytes / (1024.0f * 1024.0f), poolStats.UsedBytes / (1024.0f * 1024.0f));
+				ImGui::Text("Pooled buffers: %.2f MB", poolStats.PooledBytes / (1024.0f * 1024.0f));
+				ImGui::Text("Buffer reuses: %llu / %llu", (unsigned long long)poolStats.Reuses, (unsigned long long)(poolStats.Reuses + poolStats.SystemAllocations));
+			}
+		}
+
 		if (ImGui::CollapsingHeader("Item Manager##GameLayer"))
 		{
 			Ref<ItemManager> itemManager = m_Scene->GetItemManager();
@@ -289,27 +330,28 @@ namespace KuchCraft {
 
 			if (m_PerviousItemID != m_SelectedItemID)
 			{
-				{
-					TextureSpecification spec;
-					spec.Format = itemManager->GetItemTexture()->GetFormat();
-					spec.Width  = itemManager->GetItemTexture()->GetWidth();
-					spec.Height = itemManager->GetItemTexture()->GetHeight();
-					spec.Filter = TextureFilter::Nearest;
-
-					m_SelectedItemTexture = Texture2D::Create(spec);
-					itemManager->GetItemTexture()->CopyTo(m_SelectedItemTexture, m_SelectedItemID);
-				}
-				{
-					TextureSpecification spec;
-					spec.Format = itemManager->GetBlockTexture()->GetFormat();
-					spec.Width  = itemManager->GetBlockTexture()->GetWidth();
-					spec.Height = itemManager->GetBlockTexture()->GetHeight();
-					spec.Filter = TextureFilter::Nearest;
-
-					m_SelectedBlockTexture = Texture2D::Create(spec);
-					itemManager->GetBlockTexture()->CopyTo(m_SelectedBlockTexture, itemManager->GetBlockTextureLayers().at(m_SelectedItemID));
-				}
-				
+				m_Renderer->ExecuteWithContext([&]() {
+					{
+						TextureSpecification spec;
+						spec.Format = itemManager->GetItemTexture()->GetFormat();
+						spec.Width  = itemManager->GetItemTexture()->GetWidth();
+						spec.Height = itemManager->GetItemTexture()->GetHeight();
+						spec.Filter = TextureFilter::Nearest;
+
+						m_SelectedItemTexture = Texture2D::Create(spec);
+						itemManager->GetItemTexture()->CopyTo(m_SelectedItemTexture, m_SelectedItemID);
+					}
+					{
+						TextureSpecification spec;
+						spec.Format = itemManager->GetBlockTexture()->GetFormat();
+						spec.Width  = itemManager->GetBlockTexture()->GetWidth();
+						spec.Height = itemManager->GetBlockTexture()->GetHeight();
+						spec.Filter = TextureFilter::Nearest;
+
+						m_SelectedBlockTexture = Texture2D::Create(spec);
+						itemManager->GetBlockTexture()->CopyTo(m_SelectedBlockTexture, itemManager->GetBlockTextureLayers().at(m_SelectedItemID));
+					}
+				});
 			}
 
 			ImGui::Text("Texture:");
@@ -472,8 +514,11 @@ namespace KuchCraft {
 			{
 				m_GameState = GameState::InGame;
 
-				m_Scene = CreateRef<Scene>(m_Config, m_Renderer, name);
-				m_Scene->Load();
+				/// Textures of the previous scene are released and the new ones created with the context
+				m_Renderer->ExecuteWithContext([&]() {
+					m_Scene = CreateRef<Scene>(m_Config, m_Renderer, name);
+					m_Scene->Load();
+				});
 			}
 			else
 			{
@@ -607,7 +652,9 @@ namespace KuchCraft {
 		if (ImGui::Button("Quit", ImVec2(ImGui::GetContentRegionAvail().x, 0.0f)))
 		{
 			m_GameState = GameState::MainMenu;
-			m_Scene.reset();
+			m_Renderer->ExecuteWithContext([&]() {
+				m_Scene.reset();
+			});
 		}
 
 		ImGui::End();
@@ -63,6 +63,57 @@ namespace KuchCraft {
 		All 
 	};
 
+	enum class BlockPropertyFlags : uint8_t
+	{
+		None        = 0,
+		Visible     = BIT(0), ///< Has geometry, false for air and unknown ids
+		Opaque      = BIT(1),
+		Solid       = BIT(2),
+		Transparent = BIT(3),
+		Fluid       = BIT(4),
+		EmitsLight  = BIT(5),
+		/// Opaque full cube, hides every neighbor face that touches it
+		OccludesNeighbors = BIT(6),
+		/// Opaque shape with a full bottom face (slab), hides only the top face of the block below
+		OccludesBelow     = BIT(7)
+	};
+
+	KC_ENUM_FLAG_OPERATORS(BlockPropertyFlags);
+
+	/// Hot subset of BlockData used by meshing.
+	/// ItemManager bakes one entry per possible ItemID, so a table can be indexed directly by Block::GetId()
+	struct BlockProperties
+	{
+		BlockPropertyFlags Flags        = BlockPropertyFlags::None;
+		BlockGeometryType  GeometryType = BlockGeometryType::Cube;
+
+		/// Layer in the block texture array, faces are stored side by side within the layer
+		uint16_t TextureLayer = 0;
+
+		bool Has(BlockPropertyFlags flag) const { return (Flags & flag) != BlockPropertyFlags::None; }
+
+		bool IsVisible()     const { return Has(BlockPropertyFlags::Visible);     }
+		bool IsOpaque()      const { return Has(BlockPropertyFlags::Opaque);      }
+		bool IsSolid()       const { return Has(BlockPropertyFlags::Solid);       }
+		bool IsTransparent() const { return Has(BlockPropertyFlags::Transparent); }
+
+		bool OccludesNeighbors() const { return Has(BlockPropertyFlags::OccludesNeighbors); }
+		bool OccludesBelow()     const { return Has(BlockPropertyFlags::OccludesBelow);     }
+	};
+
+	static_assert(sizeof(BlockProperties) == 4, "BlockProperties should stay 4 bytes!");
+
+	constexpr uint32_t block_properties_count = BIT(block_bits_for_id);
+
+	/// 16 entries per cache line, the whole table is 16 KB
+	struct alignas(64) BlockPropertiesTable
+	{
+		std::array<BlockProperties, block_properties_count> Entries;
+
+		const BlockProperties& operator[](ItemID id) const { return Entries[id]; }
+		BlockProperties& operator[](ItemID id) { return Entries[id]; }
+	};
+
 	struct BlockData
 	{
 		BlockGeometryType GeometryType = BlockGeometryType::Cube;
@@ -35,13 +35,28 @@ namespace KuchCraft {
 
 	void Chunk::BuildMesh()
 	{
-		if (!m_IsBuilt)
+		if (!m_IsBuilt || !m_World)
 			return;
 
+		const auto& properties = m_World->GetItemManager()->GetBlockProperties();
+		const auto& settings   = m_World->GetMeshSettings();
+		const ChunkMeshNeighbors neighbors = ChunkMeshNeighbors::Resolve(*this, settings.AmbientOcclusion);
 		if (!m_Mesh)
+		{
 			m_Mesh = CreateRef<ChunkMesh>(this);
+			m_Mesh->Build(properties, settings, neighbors);
+		}
+		else
+			m_Mesh->Update(properties, settings, neighbors);
+	}
 
-		m_Mesh->Build();
+	void Chunk::InvalidateMesh()
+	{
+		for (auto& section : m_Sections)
+			section.MarkMeshUpdate();
+
+		if (m_Mesh)
+			m_Mesh->DiscardPendingBuilds();
 	}
 
 	Block Chunk::GetBlockSafe(const glm::ivec3& position) const
@@ -65,30 +80,55 @@ namespace KuchCraft {
 			return ;
 		}
 
-		return m_Sections[section].SetBlock(ToSectionCoords(position), block);
+		m_Sections[section].SetBlock(ToSectionCoords(position), block);
+
+		const int inSectionY = position.y & (section_size_y - 1);
+		if (inSectionY == 0 && section > 0)
+			m_Sections[section - 1].MarkMeshUpdate();
+		else if (inSectionY == section_size_y - 1 && section + 1 < sections_per_chunk)
+			m_Sections[section + 1].MarkMeshUpdate();
 	}
 
 	Ref<Chunk> Chunk::GetLeftNeighbor() const
 	{
+		if (!m_World)
+			return nullptr;
+
 		return m_World->GetChunk({ m_Position.x - chunk_size_x, m_Position.y, m_Position.z });	
 	}
 
 	Ref<Chunk> Chunk::GetRightNeighbor() const
 	{
+		if (!m_World)
+			return nullptr;
+
 		return m_World->GetChunk({ m_Position.x + chunk_size_x, m_Position.y, m_Position.z });
-		
 	}
 
 	Ref<Chunk> Chunk::GetFrontNeighbor() const
 	{
+		if (!m_World)
+			return nullptr;
+
 		return m_World->GetChunk({ m_Position.x, m_Position.y, m_Position.z + chunk_size_z });
 	}
 
 	Ref<Chunk> Chunk::GetBackNeighbor() const
 	{
+		if (!m_World)
+			return nullptr;
+
 		return m_World->GetChunk({ m_Position.x, m_Position.y, m_Position.z - chunk_size_z });
 	}
 
+	Ref<Chunk> Chunk::GetNeighbor(int dx, int dz) const
+	{
+		if (!m_World)
+			return nullptr;
+
+		return m_World->GetChunk({ m_Position.x + dx * (int)chunk_size_x, m_Position.y, m_Position.z + dz * (int)chunk_size_z });
+	}
+
 	const auto& Chunk::GetSectionSafe(size_t index) const
 	{
 		if (index < 0 || index >= sections_per_chunk)
@@ -14,7 +14,10 @@ namespace KuchCraft {
 		~ChunkSection() = default;
 
 		bool HasLight() const { return m_HasLight; }
-		bool NeedsMeshUpdate() const { return m_NeedsMeshUpdate; }
+		bool NeedsMeshUpdate() const { return m_NeedsMeshUpdate.load(std::memory_order_acquire); }
+		/// Used when a block next to this section changes, its faces towards the section may appear or disappear.
+		/// Release pairs with the acquire of the mesh build that clears the flag, so the build sees the blocks written before
+		void MarkMeshUpdate() { m_NeedsMeshUpdate.store(true, std::memory_order_release); }
 
 		const std::array<Block, block_count_per_section>& GetBlocks() const { return m_Blocks; }
 
@@ -26,7 +29,7 @@ namespace KuchCraft {
 		void SetBlock(const glm::ivec3& position, Block block)
 		{
 			m_Blocks[Index(position)] = block;
-			m_NeedsMeshUpdate = true;
+			MarkMeshUpdate();
 		}
 
 		int Index(const glm::ivec3& position) const { return (position.y * section_size_z + position.z) * section_size_x + position.x; }
@@ -41,7 +44,8 @@ namespace KuchCraft {
 		std::array<Block, block_count_per_section> m_Blocks;
 
 		bool m_HasLight = false;
-		bool m_NeedsMeshUpdate = false;
+		/// Set on the main thread, cleared by mesh builds that may run on a worker thread
+		std::atomic<bool> m_NeedsMeshUpdate = false;
 
 		friend class ChunkMesh;
 	};
@@ -50,6 +54,7 @@ namespace KuchCraft {
 	class Chunk
 	{
 	public:
+		/// `world` can be nullptr for chunks that live outside of a World (headless tools), such chunks have no neighbors
 		Chunk(const glm::ivec3& position, World* world);
 		~Chunk();
 
@@ -57,12 +62,17 @@ namespace KuchCraft {
 		void OnUpdate(Timestep ts);
 
 		void Build();
+		/// First call builds the whole mesh, later calls rebuild only sections that changed
 		void BuildMesh();
+		/// Marks every section for rebuild and drops results of builds in flight, needed when neighbors or mesh settings change
+		void InvalidateMesh();
+		void MarkSectionMeshUpdate(size_t index) { m_Sections[index].MarkMeshUpdate(); }
 
 		bool IsBuilt() const { return m_IsBuilt; }
 
 		Block GetBlock(const glm::ivec3& position) const { return m_Sections[ToSectionIndex(position.y)].GetBlock(ToSectionCoords(position)); }
 		Block GetBlockSafe(const glm::ivec3& position) const;
+		/// Also marks the section above or below for mesh update when the block is on the section border
 		void  SetBlock(const glm::ivec3& position, Block block);
 
 		inline static int ToSectionIndex(int y) { return y / section_size_y; }
@@ -74,6 +84,8 @@ namespace KuchCraft {
 		Ref<Chunk> GetRightNeighbor() const;
 		Ref<Chunk> GetFrontNeighbor() const;
 		Ref<Chunk> GetBackNeighbor()  const;
+		/// `dx` and `dz` are in chunks, also reaches diagonal neighbors
+		Ref<Chunk> GetNeighbor(int dx, int dz) const;
 
 		const auto& GetSections() const { return m_Sections; }
 		const auto& GetSection(size_t index) const { return m_Sections[index]; }
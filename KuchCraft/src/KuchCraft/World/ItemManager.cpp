@@ -8,7 +8,7 @@
 namespace KuchCraft {
 
 	ItemManager::ItemManager(const Config& config)
-		: m_Config(config)
+		: m_Config(config), m_BlockProperties(CreateScope<BlockPropertiesTable>())
 	{
 
 	}
@@ -17,7 +17,7 @@ namespace KuchCraft {
 	{
 	}
 
-	bool ItemManager::SetDataPack(const std::string& dataPackName)
+	bool ItemManager::SetDataPack(const std::string& dataPackName, bool loadTextures)
 	{
 		const std::filesystem::path dataPackPath = m_Config.Game.DataPacksDir + dataPackName;
 		if (!std::filesystem::exists(dataPackPath))
@@ -39,8 +39,14 @@ namespace KuchCraft {
 
 		LoadConfig();
 		LoadItems();
-		LoadItemTextures();
-		LoadBlockTextures();
+
+		if (loadTextures)
+		{
+			LoadItemTextures();
+			LoadBlockTextures();
+		}
+
+		BakeBlockProperties();
 
 		return true;
 	}
@@ -388,4 +394,43 @@ namespace KuchCraft {
 		}
 	}
 
+	void ItemManager::BakeBlockProperties()
+	{
+		m_BlockProperties->Entries.fill(BlockProperties{});
+
+		for (const auto& [id, item] : m_BlocksData)
+		{
+			if (id >= block_properties_count)
+			{
+				KC_CORE_ERROR("Block '{}' has id {} that does not fit in block id bits", item.Name, id);
+				continue;
+			}
+
+			const BlockData& block = item.Block.value();
+
+			BlockProperties& properties = (*m_BlockProperties)[id];
+			properties.GeometryType = block.GeometryType;
+			properties.TextureLayer = static_cast<uint16_t>(std::max(GetBlockTextureLayer(id), 0));
+
+			if (id != block_type_air)
+				properties.Flags |= BlockPropertyFlags::Visible;
+			if (block.IsOpaque)
+				properties.Flags |= BlockPropertyFlags::Opaque;
+			if (block.IsSolid)
+				properties.Flags |= BlockPropertyFlags::Solid;
+			if (block.Transparent)
+				properties.Flags |= BlockPropertyFlags::Transparent;
+			if (block.IsFluid)
+				properties.Flags |= BlockPropertyFlags::Fluid;
+			if (block.EmitsLight)
+				properties.Flags |= BlockPropertyFlags::EmitsLight;
+
+			/// Only faces that fully cover a neighbor face hide it, a slab does not hide the side faces next to it
+			if (block.IsOpaque && block.GeometryType == BlockGeometryType::Cube)
+				properties.Flags |= BlockPropertyFlags::OccludesNeighbors;
+			if (block.IsOpaque && block.GeometryType == BlockGeometryType::Slab)
+				properties.Flags |= BlockPropertyFlags::OccludesBelow;
+		}
+	}
+
 }
@@ -16,7 +16,8 @@ namespace KuchCraft {
 		ItemManager(const Config& config);
 		~ItemManager();
 
-		bool SetDataPack(const std::string& dataPackName);
+		/// `loadTextures` can be disabled when there is no OpenGL context (headless tools)
+		bool SetDataPack(const std::string& dataPackName, bool loadTextures = true);
 
 		const ItemData* GetItemData(ItemID id) const;
 		const ItemData* GetItemData(const std::string& name) const;
@@ -28,6 +29,10 @@ namespace KuchCraft {
 		const BlockData& GetBlockDataUnsafe(ItemID id) const { return GetItemDataUnsafe(id).Block.value(); };
 		const BlockData& GetBlockDataUnsafe(const std::string& name) const { return GetItemDataUnsafe(name).Block.value();};
 
+		/// Dense table of hot block properties, indexed directly by Block::GetId()
+		const BlockPropertiesTable& GetBlockProperties() const { return *m_BlockProperties; }
+		const BlockProperties& GetBlockProperties(ItemID id) const { return (*m_BlockProperties)[id]; }
+
 		int GetBlockTextureLayer(ItemID id) const
 		{
 			auto it = m_BlockTextureLayers.find(id);
@@ -52,6 +57,7 @@ namespace KuchCraft {
 		ItemData ParseItemJson(const nlohmann::json& itemJson);
 		void LoadItemTextures();
 		void LoadBlockTextures();
+		void BakeBlockProperties();
 
 	private:
 		Config m_Config;
@@ -72,6 +78,8 @@ namespace KuchCraft {
 		Ref<Texture2DArray> m_ItemTexture;
 		Ref<Texture2DArray> m_BlockTexture;
 		std::map<ItemID, int> m_BlockTextureLayers;
+
+		Scope<BlockPropertiesTable> m_BlockProperties;
 	};
 
 }
\ No newline at end of file
@@ -0,0 +1,181 @@
+#include "kcpch.h"
+#include "KuchCraft/World/PendingEdits.h"
+
+#include "KuchCraft/World/Chunk.h"
+
+namespace KuchCraft {
+
+	static inline int FloorDiv(int value, int divisor)
+	{
+		return value >= 0 ? value / divisor : -((-value + divisor - 1) / divisor);
+	}
+
+	void PendingEditBuffer::Record(const glm::ivec3& sourceChunkPosition, const std::vector<PendingWorldEdit>& edits)
+	{
+		/// Writes grouped by target before locking, indexed by the offset of the target from the source
+		constexpr int neighborhood_size = 3;
+		std::array<std::vector<PendingBlockEdit>, neighborhood_size * neighborhood_size> targetEdits;
+
+		for (const auto& edit : edits)
+		{
+			if (edit.Position.y < 0 || edit.Position.y >= (int)chunk_size_y)
+				continue;
+
+			const glm::ivec3 chunkPosition = {
+				FloorDiv(edit.Position.x, chunk_size_x) * (int)chunk_size_x,
+				0,
+				FloorDiv(edit.Position.z, chunk_size_z) * (int)chunk_size_z
+			};
+
+			const int dx = (chunkPosition.x - sourceChunkPosition.x) / (int)chunk_size_x;
+			const int dz = (chunkPosition.z - sourceChunkPosition.z) / (int)chunk_size_z;
+			KC_CORE_ASSERT(std::abs(dx) <= 1 && std::abs(dz) <= 1 && (dx != 0 || dz != 0), "Pending edit has to target a neighbor of its source chunk!");
+
+			PendingBlockEdit blockEdit;
+			blockEdit.BlockRaw   = edit.BlockRaw;
+			blockEdit.LocalIndex = PendingBlockEdit::ToLocalIndex(edit.Position - chunkPosition);
+			blockEdit.Mode       = edit.Mode;
+
+			targetEdits[(dx + 1) * neighborhood_size + dz + 1].push_back(blockEdit);
+		}
+
+		std::lock_guard lock(m_Mutex);
+		for (int dx = -1; dx <= 1; dx++)
+		{
+			for (int dz = -1; dz <= 1; dz++)
+			{
+				if (dx == 0 && dz == 0)
+					continue;
+
+				const glm::ivec3 targetPosition = sourceChunkPosition + glm::ivec3(dx * (int)chunk_size_x, 0, dz * (int)chunk_size_z);
+				std::vector<PendingBlockEdit>& sourceEdits = targetEdits[(dx + 1) * neighborhood_size + dz + 1];
+
+				auto it = m_Targets.find(targetPosition);
+				if (it == m_Targets.end() && sourceEdits.empty())
+					continue;
+
+				TargetEdits& target = it != m_Targets.end() ? it->second : m_Targets[targetPosition];
+				auto source = std::find_if(target.Sources.begin(), target.Sources.end(), [&](const SourceEdits& entry) {
+					return entry.SourcePosition == sourceChunkPosition;
+				});
+
+				if (source == target.Sources.end())
+				{
+					if (!sourceEdits.empty())
+						target.Sources.push_back({ sourceChunkPosition, std::move(sourceEdits), false });
+				}
+				else if (sourceEdits.empty())
+				{
+					target.Sources.erase(source);
+					if (target.Sources.empty())
+						m_Targets.erase(targetPosition);
+				}
+				/// A source generated again records the same writes, the ones already in a loaded target stay applied
+				else if (source->Edits != sourceEdits)
+				{
+					source->Edits   = std::move(sourceEdits);
+					source->Applied = false;
+				}
+			}
+		}
+	}
+
+	uint32_t PendingEditBuffer::ApplyAll(Chunk& chunk)
+	{
+		return Apply(chunk, false);
+	}
+
+	uint32_t PendingEditBuffer::ApplyNew(Chunk& chunk)
+	{
+		return Apply(chunk, true);
+	}
+
+	uint32_t PendingEditBuffer::Apply(Chunk& chunk, bool onlyNew)
+	{
+		std::lock_guard lock(m_Mutex);
+
+		auto it = m_Targets.find(chunk.GetPosition());
+		if (it == m_Targets.end())
+			return 0;
+
+		uint32_t changed = 0;
+		for (SourceEdits& source : it->second.Sources)
+		{
+			if (onlyNew && source.Applied)
+				continue;
+
+			for (const PendingBlockEdit& edit : source.Edits)
+			{
+				const glm::ivec3 position = edit.ToLocalPosition();
+
+				if (edit.Mode == PendingEditMode::ReplaceAir && !chunk.GetBlock(position).IsAir())
+					continue;
+
+				chunk.SetBlock(position, Block{ edit.BlockRaw });
+				changed++;
+			}
+			source.Applied = true;
+		}
+
+		return changed;
+	}
+
+	bool PendingEditBuffer::HasNewEdits(const glm::ivec3& chunkPosition) const
+	{
+		std::lock_guard lock(m_Mutex);
+
+		auto it = m_Targets.find(chunkPosition);
+		if (it == m_Targets.end())
+			return false;
+
+		return std::any_of(it->second.Sources.begin(), it->second.Sources.end(), [](const SourceEdits& source) { return !source.Applied; });
+	}
+
+	void PendingEditBuffer::Release(const glm::ivec3& chunkPosition)
+	{
+		std::lock_guard lock(m_Mutex);
+		m_Targets.erase(chunkPosition);
+	}
+
+	void PendingEditBuffer::Clear()
+	{
+		std::lock_guard lock(m_Mutex);
+		m_Targets.clear();
+	}
+
+	size_t PendingEditBuffer::GetTargetCount() const
+	{
+		std::lock_guard lock(m_Mutex);
+		return m_Targets.size();
+	}
+
+	size_t PendingEditBuffer::GetEditCount() const
+	{
+		std::lock_guard lock(m_Mutex);
+
+		size_t count = 0;
+		for (const auto& [position, target] : m_Targets)
+		{
+			for (const auto& source : target.Sources)
+				count += source.Edits.size();
+		}
+
+		return count;
+	}
+
+	size_t PendingEditBuffer::GetMemoryUsage() const
+	{
+		std::lock_guard lock(m_Mutex);
+
+		size_t bytes = 0;
+		for (const auto& [position, target] : m_Targets)
+		{
+			bytes += sizeof(TargetEdits) + target.Sources.capacity() * sizeof(SourceEdits);
+			for (const auto& source : target.Sources)
+				bytes += source.Edits.capacity() * sizeof(PendingBlockEdit);
+		}
+
+		return bytes;
+	}
+
+}
@@ -0,0 +1,102 @@
+#pragma once
+
+#include "KuchCraft/World/Block.h"
+
+namespace KuchCraft {
+
+	class Chunk;
+
+	enum class PendingEditMode : uint8_t
+	{
+		/// Always overwrite the target block
+		Replace = 0,
+		/// Only write if the target block is air (leaves must not eat terrain)
+		ReplaceAir
+	};
+
+	/// Single block write into a chunk, 8 bytes so large buffers stay compact while the target is unloaded
+	struct PendingBlockEdit
+	{
+		uint32_t BlockRaw   = 0;
+		uint16_t LocalIndex = 0;
+		PendingEditMode Mode = PendingEditMode::Replace;
+
+		bool operator==(const PendingBlockEdit& other) const = default;
+
+		static uint16_t ToLocalIndex(const glm::ivec3& local) { return static_cast<uint16_t>((local.y * chunk_size_z + local.z) * chunk_size_x + local.x); }
+		glm::ivec3 ToLocalPosition() const
+		{
+			const int index = LocalIndex;
+			return { index % (int)chunk_size_x, index / (int)(chunk_size_x * chunk_size_z), (index / (int)chunk_size_x) % (int)chunk_size_z };
+		}
+	};
+	static_assert(sizeof(PendingBlockEdit) == 8, "PendingBlockEdit should stay 8 bytes!");
+	static_assert(block_count_per_chunk <= UINT16_MAX + 1, "Chunk local index does not fit in 16 bits!");
+
+	/// Write as produced by a feature, before the target chunk is known
+	struct PendingWorldEdit
+	{
+		glm::ivec3 Position = { 0, 0, 0 };
+		uint32_t   BlockRaw = 0;
+		PendingEditMode Mode = PendingEditMode::Replace;
+	};
+
+	/// Block writes that generation of one chunk makes into another chunk (trees, ores, structures crossing the border).
+	/// Writes are recorded per target chunk, keyed by chunk position, and applied in one batch once the target has placed its own features,
+	/// so generating a chunk never has to wait for or lock its neighbors.
+	/// Every target keeps the writes of each source chunk separately. A source that is generated again replaces its earlier writes
+	/// instead of adding to them, and writes already in a loaded target are not applied to it again.
+	/// Applied edits are kept until neither the target nor any of its neighbors is loaded, because a target that is
+	/// unloaded and generated again would otherwise lose blocks written by neighbors that stayed loaded.
+	/// All functions are thread safe, chunks may be generated on several threads at once.
+	class PendingEditBuffer
+	{
+	public:
+		PendingEditBuffer()  = default;
+		~PendingEditBuffer() = default;
+
+		/// Records all writes of one feature pass of the source chunk under a single lock, replacing its earlier writes.
+		/// Positions are in blocks, the target chunk is derived from them. Features may only reach the chunks next to the source
+		void Record(const glm::ivec3& sourceChunkPosition, const std::vector<PendingWorldEdit>& edits);
+
+		/// Applies every edit recorded for the chunk, used as the last generation stage of the chunk.
+		/// Returns number of blocks changed
+		uint32_t ApplyAll(Chunk& chunk);
+
+		/// Applies only edits of sources that recorded new or different writes since the last apply, used for chunks
+		/// that are already generated. Returns number of blocks changed
+		uint32_t ApplyNew(Chunk& chunk);
+
+		bool HasNewEdits(const glm::ivec3& chunkPosition) const;
+
+		void Release(const glm::ivec3& chunkPosition);
+		void Clear();
+
+		size_t GetTargetCount() const;
+		size_t GetEditCount()   const;
+		size_t GetMemoryUsage() const;
+
+	private:
+		uint32_t Apply(Chunk& chunk, bool onlyNew);
+
+	private:
+		/// Writes of one source chunk into the target
+		struct SourceEdits
+		{
+			glm::ivec3 SourcePosition = { 0, 0, 0 };
+			std::vector<PendingBlockEdit> Edits;
+			/// Edits are already in the loaded target
+			bool Applied = false;
+		};
+
+		struct TargetEdits
+		{
+			/// In order of the first record of every source, at most one per neighbor
+			std::vector<SourceEdits> Sources;
+		};
+
+		std::unordered_map<glm::ivec3, TargetEdits> m_Targets;
+		mutable std::mutex m_Mutex;
+	};
+
+}
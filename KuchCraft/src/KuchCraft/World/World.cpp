@@ -13,7 +13,10 @@ namespace KuchCraft {
 		m_ItemManager  = m_Scene->GetItemManager();
 		m_Renderer     = m_Scene->GetRenderer();
 
-		m_WorldGenerator = CreateRef<WorldGenerator>(m_Config);
+		m_WorldGenerator = CreateRef<WorldGenerator>(m_Config, WorldGeneratorBlocks::Resolve(*m_ItemManager));
+
+		m_MeshSettings.Greedy           = m_Config.Renderer.GreedyMeshing;
+		m_MeshSettings.AmbientOcclusion = m_Config.Renderer.AmbientOcclusion;
 	}
 
 	World::~World()
@@ -55,15 +58,22 @@ namespace KuchCraft {
 		/// Remove chunks that are too far away from the player position
 		const float deleteDistance  = renderDistance * 2.0f;
 		const float deleteDistance2 = deleteDistance * deleteDistance;
+		std::vector<glm::ivec3> unloadedChunks;
 		for (auto it = m_Chunks.begin(); it != m_Chunks.end();)
 		{
 			float distance2 = glm::length2(glm::vec2(m_PlayerPosition.x, m_PlayerPosition.z) - glm::vec2(it->first));
 			if (distance2 > deleteDistance2)
-				it = m_Chunks.erase(it); 
+			{
+				unloadedChunks.push_back(it->first);
+				it = m_Chunks.erase(it);
+			}
 			else
 				++it; 
 		}
 
+		for (const auto& position : unloadedChunks)
+			ReleasePendingEdits(position);
+
 		uint32_t maxPerFrame = 1;
 		uint32_t count = 0;
 		for (auto& [position, chunk] : m_Chunks)
@@ -74,6 +84,21 @@ namespace KuchCraft {
 				chunk->Build();
 				chunk->BuildMesh();
 
+				/// Features of this chunk may have written into neighbors that are already generated
+				auto& pendingEdits = m_WorldGenerator->GetPendingEdits();
+				ForEachNeighborPosition(position, [&](const glm::ivec3& neighborPosition) {
+					if (!pendingEdits.HasNewEdits(neighborPosition))
+						return;
+
+					Ref<Chunk> neighbor = GetChunk(neighborPosition);
+					if (neighbor && neighbor->IsBuilt() && pendingEdits.ApplyNew(*neighbor) > 0)
+					{
+						/// Border faces of the neighbor towards this chunk were hidden until now
+						neighbor->InvalidateMesh();
+						neighbor->BuildMesh();
+					}
+				});
+
 				count++;
 				if (count >= maxPerFrame)
 					return; 
@@ -87,20 +112,165 @@ namespace KuchCraft {
 
 	void World::OnRender()
 	{
+		/// LOD meshes are built on the main thread, a few per frame
+		constexpr uint32_t max_lod_builds_per_frame = 4;
+
+		const auto& properties = m_ItemManager->GetBlockProperties();
+
+		uint32_t lodBuilds = 0;
+		m_DrawnQuadCount = 0;
+		m_LodChunkCount  = 0;
+		for (auto& [position, chunk] : m_Chunks)
+		{
+			Ref<ChunkMesh> mesh = chunk->GetMesh();
+			if (!mesh)
+				continue;
+
+			/// Frame boundary, sections finished since the last frame become visible together
+			mesh->SwapBuffers();
+
+			if (mesh->IsEmpty())
+				continue;
+
+			/// Out of budget the previous LOD mesh is drawn, or the full mesh if there is none yet
+			uint32_t lod = GetLodLevel(position);
+			if (lod > 0 && mesh->IsLodDirty(lod))
+			{
+				if (lodBuilds < max_lod_builds_per_frame)
+				{
+					mesh->BuildLod(lod, properties);
+					lodBuilds++;
+				}
+				else if (!mesh->HasLod(lod))
+					lod = 0;
+			}
+
+			m_DrawnQuadCount += mesh->GetQuadCount(lod);
+			m_LodChunkCount  += lod > 0;
+			m_Renderer->DrawChunkMesh(mesh, lod);
+		}
+	}
+
+	uint32_t World::GetLodLevel(const glm::ivec3& chunkPosition) const
+	{
+		const glm::vec2 chunkCenter = glm::vec2(chunkPosition.x + chunk_size_x * 0.5f, chunkPosition.z + chunk_size_z * 0.5f);
+		const float distance = glm::distance(chunkCenter, glm::vec2(m_PlayerPosition.x, m_PlayerPosition.z)) / (float)chunk_size_x;
+
+		const auto& renderer = m_Config.Renderer;
+		if (renderer.LodDistance4x > 0 && distance >= renderer.LodDistance4x)
+			return 2;
+		if (renderer.LodDistance2x > 0 && distance >= renderer.LodDistance2x)
+			return 1;
+
+		return 0;
+	}
+
+	void World::SetMeshSettings(const ChunkMeshSettings& settings)
+	{
+		m_MeshSettings = settings;
+		m_Config.Renderer.GreedyMeshing   = settings.Greedy;
+		m_Config.Renderer.AmbientOcclusion = settings.AmbientOcclusion;
+
 		for (auto& [position, chunk] : m_Chunks)
 		{
-			if (chunk->GetMesh() && !chunk->GetMesh()->IsEmpty())
-				m_Renderer->DrawChunkMesh(chunk->GetMesh());
+			chunk->InvalidateMesh();
+			chunk->BuildMesh();
 		}
 	}
 
+	WorldMeshStats World::GetMeshStats() const
+	{
+		WorldMeshStats stats;
+		for (const auto& [position, chunk] : m_Chunks)
+		{
+			Ref<ChunkMesh> mesh = chunk->GetMesh();
+			if (!mesh)
+				continue;
+
+			stats.ChunkCount++;
+			stats.FaceCount += mesh->GetFaceCount();
+			stats.QuadCount += mesh->GetQuadCount();
+		}
+
+		stats.DrawnQuadCount = m_DrawnQuadCount;
+		stats.LodChunkCount  = m_LodChunkCount;
+
+		return stats;
+	}
+
 	Block World::GetBlock(const glm::ivec3& pos) const
 	{
-		return Block(); 
+		if (pos.y < 0 || pos.y >= (int)chunk_size_y)
+			return Block();
+
+		const glm::ivec3 chunkPosition = GetChunkPosition(pos);
+
+		auto it = m_Chunks.find(chunkPosition);
+		if (it == m_Chunks.end() || !it->second->IsBuilt())
+			return Block();
+
+		return it->second->GetBlock(pos - chunkPosition);
 	}
 
 	void World::SetBlock(const glm::ivec3& pos, Block block)
 	{
+		if (pos.y < 0 || pos.y >= (int)chunk_size_y)
+			return;
+
+		const glm::ivec3 chunkPosition = GetChunkPosition(pos);
+
+		Ref<Chunk> chunk = GetChunk(chunkPosition);
+		if (!chunk || !chunk->IsBuilt())
+			return;
+
+		const glm::ivec3 local = pos - chunkPosition;
+		chunk->SetBlock(local, block);
+		chunk->BuildMesh();
+
+		/// Blocks on the chunk border change faces of the neighbor too, only its sections next to the block are rebuilt.
+		/// Ambient occlusion also reads diagonal neighbors, so corner blocks update the diagonal chunk and
+		/// blocks on a section border update the section above or below as well
+		auto updateNeighbor = [&](int dx, int dz) {
+			Ref<Chunk> neighbor = GetChunk(chunkPosition + glm::ivec3(dx * (int)chunk_size_x, 0, dz * (int)chunk_size_z));
+			if (!neighbor || !neighbor->IsBuilt())
+				return;
+
+			const int lowest  = Chunk::ToSectionIndex(std::max(local.y - 1, 0));
+			const int highest = Chunk::ToSectionIndex(std::min(local.y + 1, (int)chunk_size_y - 1));
+			for (int section = lowest; section <= highest; section++)
+				neighbor->MarkSectionMeshUpdate(section);
+
+			neighbor->BuildMesh();
+		};
+
+		const int dx = local.x == 0 ? -1 : local.x == (int)chunk_size_x - 1 ? 1 : 0;
+		const int dz = local.z == 0 ? -1 : local.z == (int)chunk_size_z - 1 ? 1 : 0;
+		if (dx != 0)             updateNeighbor(dx, 0);
+		if (dz != 0)             updateNeighbor(0, dz);
+		if (dx != 0 && dz != 0)  updateNeighbor(dx, dz);
+	}
+
+	void World::ReleasePendingEdits(const glm::ivec3& unloadedPosition)
+	{
+		/// Edits into a chunk are dropped only when none of the chunks that could have written them is loaded,
+		/// they are all generated again together and record the same edits again
+		auto& pendingEdits = m_WorldGenerator->GetPendingEdits();
+
+		auto isNeighborhoodUnloaded = [&](const glm::ivec3& center) {
+			bool unloaded = !m_Chunks.contains(center);
+			ForEachNeighborPosition(center, [&](const glm::ivec3& position) {
+				unloaded = unloaded && !m_Chunks.contains(position);
+			});
+			return unloaded;
+		};
+
+		auto release = [&](const glm::ivec3& position) {
+			if (isNeighborhoodUnloaded(position))
+				pendingEdits.Release(position);
+		};
+
+		release(unloadedPosition);
+		ForEachNeighborPosition(unloadedPosition, release);
 	}
 
 	Ref<Chunk> World::CreateChunk(const glm::vec3& pos)
@@ -11,6 +11,18 @@ namespace KuchCraft {
 	class Scene;
 	class Renderer;
 
+	struct WorldMeshStats
+	{
+		uint32_t ChunkCount = 0;
+		/// Visible block faces and quads actually emitted, they differ when faces are merged
+		uint32_t FaceCount  = 0;
+		uint32_t QuadCount  = 0;
+
+		/// Last frame, with far chunks at their LOD level
+		uint32_t DrawnQuadCount = 0;
+		uint32_t LodChunkCount  = 0;
+	};
+
 	class World
 	{
 	public:
@@ -49,8 +61,34 @@ namespace KuchCraft {
 		Ref<Renderer>       GetRenderer()     const { return m_Renderer; }
 		Ref<WorldGenerator> GetWorldGenerator() const { return m_WorldGenerator; }
 
+		const ChunkMeshSettings& GetMeshSettings() const { return m_MeshSettings; }
+		/// Rebuilds meshes of all loaded chunks
+		void SetMeshSettings(const ChunkMeshSettings& settings);
+
+		WorldMeshStats GetMeshStats() const;
+
 		static glm::ivec3 GetChunkPosition(const glm::vec3& pos) { return glm::ivec3(std::floor(pos.x / chunk_size_x) * chunk_size_x, 0.0f, std::floor(pos.z / chunk_size_z) * chunk_size_z); };
 
+	private:
+		/// Calls `fn` with positions of the 8 chunks around `chunkPosition`
+		template<typename Fn>
+		static void ForEachNeighborPosition(const glm::ivec3& chunkPosition, Fn&& fn)
+		{
+			for (int dz = -1; dz <= 1; dz++)
+			{
+				for (int dx = -1; dx <= 1; dx++)
+				{
+					if (dx != 0 || dz != 0)
+						fn(chunkPosition + glm::ivec3(dx * (int)chunk_size_x, 0, dz * (int)chunk_size_z));
+				}
+			}
+		}
+
+		void ReleasePendingEdits(const glm::ivec3& unloadedPosition);
+
+		/// Level of ChunkMesh::BuildLod the chunk at `chunkPosition` should be drawn with
+		uint32_t GetLodLevel(const glm::ivec3& chunkPosition) const;
+
 	private:
 		Scene* m_Scene = nullptr;
 		Config m_Config;
@@ -59,8 +97,13 @@ namespace KuchCraft {
 		Ref<AssetManager>   m_AssetManager;
 		Ref<WorldGenerator> m_WorldGenerator;
 
+		ChunkMeshSettings m_MeshSettings;
+
 		glm::vec3 m_PlayerPosition = { 0.0f, 0.0f, 0.0f };
 
+		uint32_t m_DrawnQuadCount = 0;
+		uint32_t m_LodChunkCount  = 0;
+
 		std::unordered_map<glm::ivec3, Ref<Chunk>> m_Chunks;
 	};
 
@@ -1,11 +1,38 @@
 #include "kcpch.h"
 #include "KuchCraft/World/WorldGenerator.h"
 
+#include "KuchCraft/World/ItemManager.h"
+
 namespace KuchCraft {
 
-	WorldGenerator::WorldGenerator(Config config)
-		: m_config(config)
+	WorldGeneratorBlocks WorldGeneratorBlocks::Resolve(const ItemManager& itemManager)
 	{
+		const auto& nameToID = itemManager.GetNameToID();
+		auto resolve = [&](const char* name) {
+			auto it = nameToID.find(name);
+			if (it != nameToID.end())
+				return it->second;
+
+			KC_CORE_WARN("World generator block '{}' is missing in data pack: {}", name, itemManager.GetDataPackName());
+			return block_type_air;
+		};
+
+		WorldGeneratorBlocks blocks;
+		for (size_t i = 0; i < terrain_block_names.size(); i++)
+			blocks.Terrain[i] = resolve(terrain_block_names[i]);
+
+		blocks.TreeLog    = resolve(tree_log_name);
+		blocks.TreeLeaves = resolve(tree_leaves_name);
+
+		return blocks;
+	}
+
+	WorldGenerator::WorldGenerator(Config config, const WorldGeneratorBlocks& blocks, uint32_t seed)
+		: m_config(config), m_Blocks(blocks), m_Seed(seed)
+	{
+		FastRandom random(static_cast<int>(m_Seed));
+		m_CaveNoise.SetSeed(random.GetUInt32());
+		m_CaveDetailNoise.SetSeed(random.GetUInt32());
 	}
 
 	WorldGenerator::~WorldGenerator()
@@ -13,6 +40,17 @@ namespace KuchCraft {
 	}
 
 	void WorldGenerator::GenerateChunk(Ref<Chunk> chunk)
+	{
+		GenerateTerrain(chunk);
+		CarveCaves(chunk);
+
+		PlaceFeatures(chunk);
+
+		/// Writes from neighbors go in after own features, so the result does not depend on which chunk was generated first
+		m_PendingEdits.ApplyAll(*chunk);
+	}
+
+	void WorldGenerator::GenerateTerrain(const Ref<Chunk>& chunk)
 	{
 		for (uint32_t y = 0; y < chunk_size_y; y++)
 		{
@@ -23,13 +61,7 @@ namespace KuchCraft {
 					if (y < 50 + glm::sin((x + z) * 0.3) * 5)
 					{
 						Block block;
-
-						if (x % 3 == 0)
-							block.SetId(1);
-						else if (x % 3 == 1)
-							block.SetId(2);
-						else if (x % 3 == 2)
-							block.SetId(3);
+						block.SetId(m_Blocks.Terrain[x % m_Blocks.Terrain.size()]);
 
 						chunk->SetBlock({ x, y, z }, block);
 					}
@@ -37,4 +69,248 @@ namespace KuchCraft {
 			}
 		}
 	}
-}
\ No newline at end of file
+
+	static inline uint32_t CaveLatticeIndex(uint32_t x, uint32_t y, uint32_t z)
+	{
+		return (y * cave_lattice_size_z + z) * cave_lattice_size_x + x;
+	}
+
+	/// Walks the coarse cells and calls `carve(x, y, z)` for every in-chunk voxel whose interpolated density is above the threshold.
+	/// Trilinear interpolation never leaves the range of the cell corners, so cells whose corners are all on one side
+	/// of the threshold are resolved without touching the per-voxel interpolation.
+	template<typename CarveFn>
+	static void ForEachCarvedCaveVoxel(const float* lattice, CarveFn&& carve, uint32_t& skippedCells)
+	{
+		constexpr float inv_cell_x = 1.0f / cave_cell_size_x;
+		constexpr float inv_cell_y = 1.0f / cave_cell_size_y;
+		constexpr float inv_cell_z = 1.0f / cave_cell_size_z;
+
+		for (uint32_t cy = 0; cy < cave_cells_y; cy++)
+		{
+			for (uint32_t cz = 0; cz < cave_cells_z; cz++)
+			{
+				for (uint32_t cx = 0; cx < cave_cells_x; cx++)
+				{
+					const float c000 = lattice[CaveLatticeIndex(cx,     cy,     cz    )];
+					const float c100 = lattice[CaveLatticeIndex(cx + 1, cy,     cz    )];
+					const float c010 = lattice[CaveLatticeIndex(cx,     cy + 1, cz    )];
+					const float c110 = lattice[CaveLatticeIndex(cx + 1, cy + 1, cz    )];
+					const float c001 = lattice[CaveLatticeIndex(cx,     cy,     cz + 1)];
+					const float c101 = lattice[CaveLatticeIndex(cx + 1, cy,     cz + 1)];
+					const float c011 = lattice[CaveLatticeIndex(cx,     cy + 1, cz + 1)];
+					const float c111 = lattice[CaveLatticeIndex(cx + 1, cy + 1, cz + 1)];
+
+					const float minDensity = std::min({ c000, c100, c010, c110, c001, c101, c011, c111 });
+					const float maxDensity = std::max({ c000, c100, c010, c110, c001, c101, c011, c111 });
+
+					const uint32_t baseX = cx * cave_cell_size_x;
+					const uint32_t baseY = cy * cave_cell_size_y;
+					const uint32_t baseZ = cz * cave_cell_size_z;
+
+					/// Fully solid cell, nothing to carve
+					if (maxDensity <= cave_threshold)
+					{
+						skippedCells++;
+						continue;
+					}
+
+					/// Fully empty cell, carve everything without interpolating
+					if (minDensity > cave_threshold)
+					{
+						skippedCells++;
+						for (uint32_t y = std::max(baseY, cave_min_height); y < baseY + cave_cell_size_y; y++)
+							for (uint32_t z = baseZ; z < baseZ + cave_cell_size_z; z++)
+								for (uint32_t x = baseX; x < baseX + cave_cell_size_x; x++)
+									carve(x, y, z);
+						continue;
+					}
+
+					for (uint32_t dy = 0; dy < cave_cell_size_y; dy++)
+					{
+						const uint32_t y = baseY + dy;
+						if (y < cave_min_height)
+							continue;
+
+						const float ty = dy * inv_cell_y;
+						const float e00 = c000 + (c010 - c000) * ty;
+						const float e10 = c100 + (c110 - c100) * ty;
+						const float e01 = c001 + (c011 - c001) * ty;
+						const float e11 = c101 + (c111 - c101) * ty;
+
+						for (uint32_t dz = 0; dz < cave_cell_size_z; dz++)
+						{
+							const float tz = dz * inv_cell_z;
+							const float x0 = e00 + (e01 - e00) * tz;
+							const float x1 = e10 + (e11 - e10) * tz;
+
+							for (uint32_t dx = 0; dx < cave_cell_size_x; dx++)
+							{
+								const float density = x0 + (x1 - x0) * (dx * inv_cell_x);
+								if (density > cave_threshold)
+									carve(baseX + dx, y, baseZ + dz);
+							}
+						}
+					}
+				}
+			}
+		}
+	}
+
+	void WorldGenerator::CarveCaves(const Ref<Chunk>& chunk)
+	{
+		std::array<float, cave_lattice_count> lattice;
+		EvaluateCaveLattice(chunk->GetPosition(), lattice.data());
+
+		uint32_t skippedCells = 0;
+		ForEachCarvedCaveVoxel(lattice.data(), [&](uint32_t x, uint32_t y, uint32_t z) {
+			const glm::ivec3 position = { x, y, z };
+			if (!chunk->GetBlock(position).IsAir())
+				chunk->SetBlock(position, Block());
+		}, skippedCells);
+	}
+
+	int WorldGenerator::GetChunkSeed(const glm::ivec3& chunkPosition) const
+	{
+		uint32_t h = m_Seed;
+		h ^= static_cast<uint32_t>(chunkPosition.x) * 0x8da6b343u;
+		h ^= static_cast<uint32_t>(chunkPosition.z) * 0xcb1ab31fu;
+		h ^= h >> 16;
+		h *= 0x7feb352du;
+		h ^= h >> 15;
+
+		/// FastRandom is a Lehmer generator, seed has to be in [1, 2^31 - 2]
+		return static_cast<int>(h % 0x7ffffffeu) + 1;
+	}
+
+	void WorldGenerator::PlaceFeatures(const Ref<Chunk>& chunk)
+	{
+		FastRandom random(GetChunkSeed(chunk->GetPosition()));
+		std::vector<PendingWorldEdit> outsideEdits;
+
+		const bool hasTreeBlocks = m_Blocks.TreeLog != block_type_air && m_Blocks.TreeLeaves != block_type_air;
+
+		struct TreePlacement
+		{
+			glm::ivec3 Base;
+			int TrunkHeight;
+		};
+
+		/// Surfaces are found before any tree is placed, so trees never grow on top of other trees
+		std::vector<TreePlacement> trees;
+		const int treeCount = hasTreeBlocks ? random.GetInt32InRange(0, tree_max_per_chunk) : 0;
+		for (int i = 0; i < treeCount; i++)
+		{
+			const int x           = random.GetInt32InRange(0, chunk_size_x - 1);
+			const int z           = random.GetInt32InRange(0, chunk_size_z - 1);
+			const int trunkHeight = random.GetInt32InRange(tree_min_trunk_height, tree_max_trunk_height);
+
+			int surface = chunk_size_y - 1;
+			while (surface >= 0 && chunk->GetBlock({ x, surface, z }).IsAir())
+				surface--;
+
+			if (surface < 0 || surface + trunkHeight + (int)tree_leaves_radius >= (int)chunk_size_y)
+				continue;
+
+			trees.push_back({ { x, surface + 1, z }, trunkHeight });
+		}
+
+		for (const auto& tree : trees)
+			PlaceTree(*chunk, tree.Base, tree.TrunkHeight, outsideEdits);
+
+		/// Recorded even without edits, so a source generated again drops writes it no longer makes
+		m_PendingEdits.Record(chunk->GetPosition(), outsideEdits);
+	}
+
+	void WorldGenerator::PlaceTree(Chunk& chunk, const glm::ivec3& base, int trunkHeight, std::vector<PendingWorldEdit>& outsideEdits)
+	{
+		Block leaves;
+		leaves.SetId(m_Blocks.TreeLeaves);
+
+		const int radius = tree_leaves_radius;
+		const int crownY = base.y + trunkHeight - 1;
+		for (int dy = -1; dy <= 1; dy++)
+		{
+			const int layerRadius = dy == 1 ? radius - 1 : radius;
+			for (int dz = -layerRadius; dz <= layerRadius; dz++)
+			{
+				for (int dx = -layerRadius; dx <= layerRadius; dx++)
+				{
+					/// Round the corners
+					if (layerRadius > 1 && std::abs(dx) == layerRadius && std::abs(dz) == layerRadius)
+						continue;
+
+					WriteFeatureBlock(chunk, { base.x + dx, crownY + dy, base.z + dz }, leaves, PendingEditMode::ReplaceAir, outsideEdits);
+				}
+			}
+		}
+		WriteFeatureBlock(chunk, { base.x, crownY + 2, base.z }, leaves, PendingEditMode::ReplaceAir, outsideEdits);
+
+		Block log;
+		log.SetId(m_Blocks.TreeLog);
+		for (int y = 0; y < trunkHeight; y++)
+			WriteFeatureBlock(chunk, { base.x, base.y + y, base.z }, log, PendingEditMode::Replace, outsideEdits);
+	}
+
+	void WorldGenerator::WriteFeatureBlock(Chunk& chunk, const glm::ivec3& position, Block block, PendingEditMode mode, std::vector<PendingWorldEdit>& outsideEdits)
+	{
+		if (position.y < 0 || position.y >= (int)chunk_size_y)
+			return;
+
+		const bool inside = position.x >= 0 && position.z >= 0 && position.x < (int)chunk_size_x && position.z < (int)chunk_size_z;
+		if (!inside)
+		{
+			outsideEdits.push_back({ chunk.GetPosition() + position, block.Raw, mode });
+			return;
+		}
+
+		if (mode == PendingEditMode::ReplaceAir && !chunk.GetBlock(position).IsAir())
+			return;
+
+		chunk.SetBlock(position, block);
+	}
+
+	float WorldGenerator::SampleCaveDensity(float x, float y, float z) const
+	{
+		return m_CaveNoise.Sample(x * cave_frequency_xz, y * cave_frequency_y, z * cave_frequency_xz) +
+			0.5f * m_CaveDetailNoise.Sample(x * cave_frequency_xz * 2.0f, y * cave_frequency_y * 2.0f, z * cave_frequency_xz * 2.0f);
+	}
+
+	void WorldGenerator::EvaluateCaveLattice(const glm::ivec3& chunkPosition, float* lattice) const
+	{
+		std::array<float, cave_lattice_size_x> detail;
+
+		const float startX = static_cast<float>(chunkPosition.x);
+		for (uint32_t ly = 0; ly < cave_lattice_size_y; ly++)
+		{
+			const float y = static_cast<float>(chunkPosition.y + ly * cave_cell_size_y);
+			for (uint32_t lz = 0; lz < cave_lattice_size_z; lz++)
+			{
+				const float z = static_cast<float>(chunkPosition.z + lz * cave_cell_size_z);
+
+				float* row = lattice + CaveLatticeIndex(0, ly, lz);
+				m_CaveNoise.SampleRowX(row, cave_lattice_size_x,
+					startX * cave_frequency_xz, cave_cell_size_x * cave_frequency_xz, y * cave_frequency_y, z * cave_frequency_xz);
+				m_CaveDetailNoise.SampleRowX(detail.data(), cave_lattice_size_x,
+					startX * cave_frequency_xz * 2.0f, cave_cell_size_x * cave_frequency_xz * 2.0f, y * cave_frequency_y * 2.0f, z * cave_frequency_xz * 2.0f);
+
+				for (uint32_t lx = 0; lx < cave_lattice_size_x; lx++)
+					row[lx] += 0.5f * detail[lx];
+			}
+		}
+	}
+
+	uint32_t WorldGenerator::EvaluateCaveMask(const glm::ivec3& chunkPosition, uint8_t* mask) const
+	{
+		std::array<float, cave_lattice_count> lattice;
+		EvaluateCaveLattice(chunkPosition, lattice.data());
+
+		std::fill(mask, mask + block_count_per_chunk, 0);
+
+		uint32_t skippedCells = 0;
+		ForEachCarvedCaveVoxel(lattice.data(), [&](uint32_t x, uint32_t y, uint32_t z) {
+			mask[(y * chunk_size_z + z) * chunk_size_x + x] = 1;
+		}, skippedCells);
+
+		return skippedCells;
+	}
+}
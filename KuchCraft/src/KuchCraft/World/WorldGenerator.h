@@ -1,19 +1,109 @@
 #pragma once
 
 #include "KuchCraft/World/Chunk.h"
+#include "KuchCraft/World/PendingEdits.h"
+
+#include "Core/Noise.h"
 
 namespace KuchCraft {
 
+	constexpr uint32_t default_world_seed = 1337;
+
+	/// Caves are evaluated on a coarse lattice and trilinearly interpolated inside each cell
+	constexpr uint32_t cave_cell_size_x = 4;
+	constexpr uint32_t cave_cell_size_y = 8;
+	constexpr uint32_t cave_cell_size_z = 4;
+
+	constexpr uint32_t cave_cells_x = chunk_size_x / cave_cell_size_x;
+	constexpr uint32_t cave_cells_y = chunk_size_y / cave_cell_size_y;
+	constexpr uint32_t cave_cells_z = chunk_size_z / cave_cell_size_z;
+
+	constexpr uint32_t cave_lattice_size_x = cave_cells_x + 1;
+	constexpr uint32_t cave_lattice_size_y = cave_cells_y + 1;
+	constexpr uint32_t cave_lattice_size_z = cave_cells_z + 1;
+	constexpr uint32_t cave_lattice_count  = cave_lattice_size_x * cave_lattice_size_y * cave_lattice_size_z;
+
+	static_assert(chunk_size_x % cave_cell_size_x == 0, "Cave cell size must divide chunk size!");
+	static_assert(chunk_size_y % cave_cell_size_y == 0, "Cave cell size must divide chunk size!");
+	static_assert(chunk_size_z % cave_cell_size_z == 0, "Cave cell size must divide chunk size!");
+
+	constexpr float    cave_frequency_xz = 1.0f / 32.0f;
+	constexpr float    cave_frequency_y  = 1.0f / 20.0f;
+	constexpr float    cave_threshold    = 0.38f;
+	constexpr uint32_t cave_min_height   = 4;
+
+	/// Trees are placed anywhere in the chunk, so leaves regularly cross into neighbors through pending edits
+	constexpr uint32_t tree_max_per_chunk     = 3;
+	constexpr uint32_t tree_min_trunk_height  = 4;
+	constexpr uint32_t tree_max_trunk_height  = 6;
+	constexpr uint32_t tree_leaves_radius     = 2;
+
+	/// Features may only reach direct neighbors
+	static_assert(tree_leaves_radius < chunk_size_x && tree_leaves_radius < chunk_size_z, "Features can not be wider than a chunk!");
+
+	/// Item names of the blocks the generator places
+	constexpr std::array<const char*, 3> terrain_block_names = { "dirt", "grass_block", "stone" };
+	constexpr const char* tree_log_name    = "oak_log";
+	constexpr const char* tree_leaves_name = "oak_leaves";
+
+	class ItemManager;
+
+	/// Ids of the blocks the generator places, item ids depend on the data pack so they are resolved by name
+	struct WorldGeneratorBlocks
+	{
+		std::array<ItemID, terrain_block_names.size()> Terrain = {};
+		ItemID TreeLog    = block_type_air;
+		ItemID TreeLeaves = block_type_air;
+
+		/// Items missing from the data pack stay air, trees are not placed without both tree blocks
+		static WorldGeneratorBlocks Resolve(const ItemManager& itemManager);
+	};
+
 	class WorldGenerator
 	{
 	public:
-		WorldGenerator(Config config);
+		WorldGenerator(Config config, const WorldGeneratorBlocks& blocks, uint32_t seed = default_world_seed);
 		~WorldGenerator();
 
+		/// Safe to call from several threads for different chunks
 		void GenerateChunk(Ref<Chunk> chunk);
 
+		uint32_t GetSeed() const { return m_Seed; }
+
+		/// Writes that features made into chunks other than the one being generated
+		PendingEditBuffer& GetPendingEdits() { return m_PendingEdits; }
+		const PendingEditBuffer& GetPendingEdits() const { return m_PendingEdits; }
+
+		/// Sets the voxels caves carve out of the chunk at `chunkPosition` to 1 and all others to 0, `mask` holds
+		/// block_count_per_chunk entries in [y][z][x] layout. Uses the coarse lattice like generation does,
+		/// returns number of cells resolved without interpolation
+		uint32_t EvaluateCaveMask(const glm::ivec3& chunkPosition, uint8_t* mask) const;
+		/// Cave density of a single voxel, the lattice approximates it. A voxel above cave_min_height is carved above cave_threshold
+		float SampleCaveDensity(float x, float y, float z) const;
+
 	private:
-		Config m_config;
+		void GenerateTerrain(const Ref<Chunk>& chunk);
+		void CarveCaves(const Ref<Chunk>& chunk);
+		void PlaceFeatures(const Ref<Chunk>& chunk);
+		void PlaceTree(Chunk& chunk, const glm::ivec3& base, int trunkHeight, std::vector<PendingWorldEdit>& outsideEdits);
+
+		/// `position` is relative to the chunk and may be outside of it, such writes are collected in `outsideEdits`
+		void WriteFeatureBlock(Chunk& chunk, const glm::ivec3& position, Block block, PendingEditMode mode, std::vector<PendingWorldEdit>& outsideEdits);
+
+		/// Seed for features of a single chunk, independent of generation order
+		int GetChunkSeed(const glm::ivec3& chunkPosition) const;
+
+		/// Fills `lattice` with cave density at lattice points, layout is [y][z][x]
+		void EvaluateCaveLattice(const glm::ivec3& chunkPosition, float* lattice) const;
+
+	private:
+		Config   m_config;
+		WorldGeneratorBlocks m_Blocks;
+		uint32_t m_Seed = default_world_seed;
+
+		GradientNoise m_CaveNoise;
+		GradientNoise m_CaveDetailNoise;
 
+		PendingEditBuffer m_PendingEdits;
 	};
-}
\ No newline at end of file
+}
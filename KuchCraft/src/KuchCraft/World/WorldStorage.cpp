@@ -0,0 +1,241 @@
+#include "kcpch.h"
+#include "KuchCraft/World/WorldStorage.h"
+
+#include "KuchCraft/World/ItemManager.h"
+
+namespace KuchCraft {
+
+	template<typename T>
+	static void WriteValue(std::ofstream& file, const T& value)
+	{
+		file.write(reinterpret_cast<const char*>(&value), sizeof(T));
+	}
+
+	template<typename T>
+	static bool ReadValue(std::ifstream& file, T& value)
+	{
+		file.read(reinterpret_cast<char*>(&value), sizeof(T));
+		return file.good();
+	}
+
+	static void WriteString(std::ofstream& file, const std::string& value)
+	{
+		WriteValue(file, static_cast<uint16_t>(value.size()));
+		file.write(value.data(), value.size());
+	}
+
+	static bool ReadString(std::ifstream& file, std::string& value)
+	{
+		uint16_t size = 0;
+		if (!ReadValue(file, size))
+			return false;
+
+		value.resize(size);
+		file.read(value.data(), size);
+		return file.good();
+	}
+
+	bool WorldStorage::Save(const std::filesystem::path& filepath, uint32_t seed, const std::vector<Ref<Chunk>>& chunks, const ItemManager& itemManager)
+	{
+		std::error_code error;
+		if (filepath.has_parent_path())
+			std::filesystem::create_directories(filepath.parent_path(), error);
+
+		std::ofstream file(filepath, std::ios::binary);
+		if (!file.is_open())
+		{
+			KC_CORE_ERROR("Failed to open : {}", filepath.string());
+			return false;
+		}
+
+		WriteValue(file, s_Magic);
+		WriteValue(file, s_Version);
+		WriteValue(file, seed);
+
+		/// Palette of item names, so ids can be remapped when the data pack changes
+		WriteString(file, itemManager.GetDataPackName());
+		WriteValue(file, static_cast<uint32_t>(itemManager.GetNameToID().size()));
+		for (const auto& [name, id] : itemManager.GetNameToID())
+		{
+			WriteValue(file, id);
+			WriteString(file, name);
+		}
+
+		WriteValue(file, static_cast<uint32_t>(chunks.size()));
+
+		for (const auto& chunk : chunks)
+		{
+			WriteValue(file, static_cast<int32_t>(chunk->GetPosition().x));
+			WriteValue(file, static_cast<int32_t>(chunk->GetPosition().z));
+
+			uint16_t sectionMask = 0;
+			for (uint32_t i = 0; i < sections_per_chunk; i++)
+			{
+				const auto& blocks = chunk->GetSection(i).GetBlocks();
+				if (std::any_of(blocks.begin(), blocks.end(), [](Block block) { return !block.IsAir(); }))
+					sectionMask |= BIT(i);
+			}
+			WriteValue(file, sectionMask);
+
+			for (uint32_t i = 0; i < sections_per_chunk; i++)
+			{
+				if (!(sectionMask & BIT(i)))
+					continue;
+
+				const auto& blocks = chunk->GetSection(i).GetBlocks();
+
+				std::vector<std::pair<uint16_t, uint32_t>> runs;
+				for (uint32_t b = 0; b < block_count_per_section;)
+				{
+					const uint32_t raw = blocks[b].Raw;
+					uint32_t length = 1;
+					while (b + length < block_count_per_section && length < UINT16_MAX && blocks[b + length].Raw == raw)
+						length++;
+
+					runs.emplace_back(static_cast<uint16_t>(length), raw);
+					b += length;
+				}
+
+				WriteValue(file, static_cast<uint32_t>(runs.size()));
+				for (const auto& [length, raw] : runs)
+				{
+					WriteValue(file, length);
+					WriteValue(file, raw);
+				}
+			}
+		}
+
+		if (!file.good())
+		{
+			KC_CORE_ERROR("Failed to write world file: {}", filepath.string());
+			return false;
+		}
+
+		file.close();
+		if (!file.good())
+		{
+			KC_CORE_ERROR("Failed to close world file: {}", filepath.string());
+			return false;
+		}
+
+		return true;
+	}
+
+	bool WorldStorage::Load(const std::filesystem::path& filepath, uint32_t& seed, std::vector<Ref<Chunk>>& chunks, const ItemManager& itemManager, World* world)
+	{
+		if (!std::filesystem::exists(filepath))
+		{
+			KC_CORE_WARN("File does not exist: {}", filepath.string());
+			return false;
+		}
+
+		std::ifstream file(filepath, std::ios::binary);
+		if (!file.is_open())
+		{
+			KC_CORE_ERROR("Failed to open file: {}", filepath.string());
+			return false;
+		}
+
+		uint32_t magic = 0, version = 0, chunkCount = 0;
+		if (!ReadValue(file, magic) || magic != s_Magic || !ReadValue(file, version) || version != s_Version)
+		{
+			KC_CORE_ERROR("Invalid world file: {}", filepath.string());
+			return false;
+		}
+
+		std::string dataPackName;
+		uint32_t paletteSize = 0;
+		if (!ReadValue(file, seed) || !ReadString(file, dataPackName) || !ReadValue(file, paletteSize))
+		{
+			KC_CORE_ERROR("Invalid world file: {}", filepath.string());
+			return false;
+		}
+
+		if (dataPackName != itemManager.GetDataPackName())
+			KC_CORE_WARN("World file {} was saved with data pack {}, loading with {}", filepath.string(), dataPackName, itemManager.GetDataPackName());
+
+		/// Saved id -> id in the current data pack, unknown ids become air
+		std::vector<ItemID> palette(block_mask_id + 1, block_type_air);
+		for (uint32_t p = 0; p < paletteSize; p++)
+		{
+			ItemID savedID = 0;
+			std::string name;
+			if (!ReadValue(file, savedID) || !ReadString(file, name))
+			{
+				KC_CORE_ERROR("Invalid world file: {}", filepath.string());
+				return false;
+			}
+
+			const auto it = itemManager.GetNameToID().find(name);
+			if (it != itemManager.GetNameToID().end())
+				palette[savedID & block_mask_id] = it->second;
+			else
+				KC_CORE_WARN("Item {} from world file {} is missing in data pack {}, loading it as air", name, filepath.string(), itemManager.GetDataPackName());
+		}
+
+		if (!ReadValue(file, chunkCount))
+		{
+			KC_CORE_ERROR("Invalid world file: {}", filepath.string());
+			return false;
+		}
+
+		chunks.clear();
+		chunks.reserve(chunkCount);
+		for (uint32_t c = 0; c < chunkCount; c++)
+		{
+			int32_t x = 0, z = 0;
+			uint16_t sectionMask = 0;
+			if (!ReadValue(file, x) || !ReadValue(file, z) || !ReadValue(file, sectionMask))
+			{
+				KC_CORE_ERROR("Unexpected end of world file: {}", filepath.string());
+				return false;
+			}
+
+			auto chunk = CreateRef<Chunk>(glm::ivec3(x, 0, z), world);
+			for (uint32_t i = 0; i < sections_per_chunk; i++)
+			{
+				if (!(sectionMask & BIT(i)))
+					continue;
+
+				uint32_t runCount = 0;
+				if (!ReadValue(file, runCount))
+				{
+					KC_CORE_ERROR("Unexpected end of world file: {}", filepath.string());
+					return false;
+				}
+
+				uint32_t b = 0;
+				for (uint32_t r = 0; r < runCount; r++)
+				{
+					uint16_t length = 0;
+					uint32_t raw    = 0;
+					if (!ReadValue(file, length) || !ReadValue(file, raw) || b + length > block_count_per_section)
+					{
+						KC_CORE_ERROR("Corrupted section in world file: {}", filepath.string());
+						return false;
+					}
+
+					Block block{ raw };
+					block.SetId(palette[block.GetId()]);
+
+					for (uint32_t end = b + length; b < end; b++)
+					{
+						const int index = static_cast<int>(b);
+						const glm::ivec3 position = {
+							index % (int)section_size_x,
+							index / (int)(section_size_x * section_size_z) + (int)(i * section_size_y),
+							(index / (int)section_size_x) % (int)section_size_z
+						};
+						chunk->SetBlock(position, block);
+					}
+				}
+			}
+
+			chunk->Build();
+			chunks.push_back(chunk);
+		}
+
+		return true;
+	}
+
+}
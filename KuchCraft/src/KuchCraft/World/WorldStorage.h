@@ -0,0 +1,29 @@
+#pragma once
+
+#include "KuchCraft/World/Chunk.h"
+
+namespace KuchCraft {
+
+	class ItemManager;
+
+	/// Binary storage for generated chunks.
+	/// Sections that are fully air are skipped, the others are stored as runs of equal blocks.
+	/// Item ids depend on the order items are loaded in, so the file keeps the data pack name and the item name of
+	/// every id it uses, and ids are mapped to the ids of the loading data pack by name.
+	class WorldStorage
+	{
+	public:
+		static bool Save(const std::filesystem::path& filepath, uint32_t seed, const std::vector<Ref<Chunk>>& chunks, const ItemManager& itemManager);
+
+		/// Loaded chunks are marked as built and belong to `world` (can be nullptr).
+		/// Blocks missing from the data pack of `itemManager` are loaded as air
+		static bool Load(const std::filesystem::path& filepath, uint32_t& seed, std::vector<Ref<Chunk>>& chunks, const ItemManager& itemManager, World* world = nullptr);
+
+		inline static std::string DefaultExtension = ".kworld";
+
+	private:
+		static constexpr uint32_t s_Magic   = 0x4457434b; ///< "KCWD"
+		static constexpr uint32_t s_Version = 2;
+	};
+
+}
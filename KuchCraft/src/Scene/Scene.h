@@ -41,6 +41,7 @@ namespace KuchCraft {
 		Ref<Renderer>     GetRenderer()     const { return m_Renderer;     }
 		Ref<ItemManager>  GetItemManager()  const { return m_ItemManager;  }
 		Ref<AssetManager> GetAssetManager() const { return m_AssetManager; }
+		Ref<World>        GetWorld()        const { return m_World;        }
 
 		/// Entities
 		Entity CreateEntity(const std::string& name = "Unnamed");
@@ -13,6 +13,8 @@
 #include <string>
 #include <sstream>
 #include <vector>
+#include <array>
+#include <span>
 #include <unordered_map>
 #include <unordered_set>
 #include <map>
@@ -36,6 +38,7 @@
 #include <cstdlib>
 #include <cstring>
 #include <limits>
+#include <bit>
 
 #include <optional>
 #include <variant>
@@ -68,6 +71,7 @@
 #include "Core/ApplicationEvent.h"
 #include "Core/Config.h"
 #include "Core/Timestep.h"
+#include "Core/Timer.h"
 #include "Core/EnumUtils.h"
 #include "Core/CoreUtils.h"
 #include "Core/UUID.h"
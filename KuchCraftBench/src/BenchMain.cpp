@@ -0,0 +1,82 @@
+#include "kcpch.h"
+
+#include "BenchUtils.h"
+#include "WorldGenBenchmark.h"
+#include "CaveBenchmark.h"
+#include "MeshBenchmark.h"
+#include "BufferBenchmark.h"
+#include "CullingBenchmark.h"
+#include "VisibilityBenchmark.h"
+#include "RenderQueueBenchmark.h"
+#include "CommandBufferBenchmark.h"
+#include "RenderThreadBenchmark.h"
+#include "TextureSlotBenchmark.h"
+#include "StreamingRingBenchmark.h"
+
+/// Headless benchmarks, never opens a window or creates an OpenGL context.
+/// Usage: KuchCraftBench <mode> [--options]
+int main(int argc, char** argv)
+{
+	KuchCraft::InitializeCore();
+
+	KuchCraft::Config config;
+	config.Deserialize("config.json");
+
+	KuchCraft::Bench::Arguments args(argc, argv);
+
+	int result = 0;
+	if (args.GetMode() == "worldgen")
+	{
+		result = KuchCraft::Bench::RunWorldGenBenchmark(config, args);
+	}
+	else if (args.GetMode() == "caves")
+	{
+		result = KuchCraft::Bench::RunCaveBenchmark(config, args);
+	}
+	else if (args.GetMode() == "mesh")
+	{
+		result = KuchCraft::Bench::RunMeshBenchmark(config, args);
+	}
+	else if (args.GetMode() == "buffers")
+	{
+		result = KuchCraft::Bench::RunBufferBenchmark(config, args);
+	}
+	else if (args.GetMode() == "culling")
+	{
+		result = KuchCraft::Bench::RunCullingBenchmark(config, args);
+	}
+	else if (args.GetMode() == "visibility")
+	{
+		result = KuchCraft::Bench::RunVisibilityBenchmark(config, args);
+	}
+	else if (args.GetMode() == "sort")
+	{
+		result = KuchCraft::Bench::RunRenderQueueBenchmark(config, args);
+	}
+	else if (args.GetMode() == "commands")
+	{
+		result = KuchCraft::Bench::RunCommandBufferBenchmark(config, args);
+	}
+	else if (args.GetMode() == "pipeline")
+	{
+		result = KuchCraft::Bench::RunRenderThreadBenchmark(config, args);
+	}
+	else if (args.GetMode() == "textures")
+	{
+		result = KuchCraft::Bench::RunTextureSlotBenchmark(config, args);
+	}
+	else if (args.GetMode() == "streaming")
+	{
+		result = KuchCraft::Bench::RunStreamingRingBenchmark(config, args);
+	}
+	else
+	{
+		KC_CORE_ERROR("Unknown benchmark mode: '{}'", args.GetMode());
+		KC_CORE_INFO("Available modes: worldgen, caves, mesh, buffers, culling, visibility, sort, commands, pipeline, textures, streaming");
+		result = 1;
+	}
+
+	KuchCraft::ShutdownCore();
+
+	return result;
+}
@@ -0,0 +1,96 @@
+#include "kcpch.h"
+#include "BenchUtils.h"
+
+#if defined(KC_PLATFORM_WINDOWS)
+	#include <Windows.h>
+	#include <psapi.h>
+#else
+	#include <sys/resource.h>
+#endif
+
+namespace KuchCraft::Bench {
+
+	Arguments::Arguments(int argc, char** argv)
+	{
+		int first = 1;
+		if (argc > 1 && std::string(argv[1]).rfind("--", 0) != 0)
+		{
+			m_Mode = argv[1];
+			first  = 2;
+		}
+
+		for (int i = first; i < argc; i++)
+		{
+			std::string key = argv[i];
+			if (key.rfind("--", 0) != 0)
+			{
+				KC_CORE_WARN("Ignoring argument: {}", key);
+				continue;
+			}
+
+			key = key.substr(2);
+			if (i + 1 < argc && std::string(argv[i + 1]).rfind("--", 0) != 0)
+				m_Values[key] = argv[++i];
+			else
+				m_Values[key] = "";
+		}
+	}
+
+	std::string Arguments::GetString(const std::string& key, const std::string& defaultValue) const
+	{
+		auto it = m_Values.find(key);
+		if (it == m_Values.end() || it->second.empty())
+			return defaultValue;
+
+		return it->second;
+	}
+
+	int Arguments::GetInt(const std::string& key, int defaultValue) const
+	{
+		auto it = m_Values.find(key);
+		if (it == m_Values.end() || it->second.empty())
+			return defaultValue;
+
+		try
+		{
+			return std::stoi(it->second);
+		}
+		catch (const std::exception&)
+		{
+			KC_CORE_WARN("Invalid value for --{}: {}", key, it->second);
+			return defaultValue;
+		}
+	}
+
+	double Percentile(std::vector<double> samples, double percentile)
+	{
+		if (samples.empty())
+			return 0.0;
+
+		const size_t index = std::min(samples.size() - 1, static_cast<size_t>(percentile * (samples.size() - 1) + 0.5));
+		std::nth_element(samples.begin(), samples.begin() + index, samples.end());
+		return samples[index];
+	}
+
+	size_t GetPeakMemoryUsage()
+	{
+#if defined(KC_PLATFORM_WINDOWS)
+		PROCESS_MEMORY_COUNTERS counters{};
+		if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+			return counters.PeakWorkingSetSize;
+#else
+		rusage usage{};
+		if (getrusage(RUSAGE_SELF, &usage) == 0)
+		{
+	#if defined(__APPLE__)
+			return static_cast<size_t>(usage.ru_maxrss);
+	#else
+			/// Kilobytes on Linux
+			return static_cast<size_t>(usage.ru_maxrss) * 1024;
+	#endif
+		}
+#endif
+		return 0;
+	}
+
+}
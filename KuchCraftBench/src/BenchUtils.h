@@ -0,0 +1,28 @@
+#pragma once
+
+namespace KuchCraft::Bench {
+
+	/// Command line in the form `<mode> --key value --flag`
+	class Arguments
+	{
+	public:
+		Arguments(int argc, char** argv);
+
+		const std::string& GetMode() const { return m_Mode; }
+
+		bool        Has(const std::string& key) const { return m_Values.contains(key); }
+		std::string GetString(const std::string& key, const std::string& defaultValue = "") const;
+		int         GetInt(const std::string& key, int defaultValue) const;
+
+	private:
+		std::string m_Mode;
+		std::unordered_map<std::string, std::string> m_Values;
+	};
+
+	/// Returns value at `percentile` in [0, 1], `samples` does not have to be sorted
+	double Percentile(std::vector<double> samples, double percentile);
+
+	/// Peak resident set size of the process in bytes, 0 if unknown
+	size_t GetPeakMemoryUsage();
+
+}
@@ -0,0 +1,222 @@
+#include "kcpch.h"
+#include "BufferBenchmark.h"
+
+#include "Graphics/Core/BufferAllocator.h"
+#include "Graphics/KuchCraft/BlockMesh.h"
+#include "Graphics/KuchCraft/ChunkDrawCommands.h"
+
+namespace KuchCraft::Bench {
+
+	/// Section buckets are mostly small with a long tail, like surface sections next to caves
+	static uint32_t GetRandomFaceCount(FastRandom& random)
+	{
+		const int roll = random.GetInt32InRange(0, 99);
+		if (roll < 60)
+			return static_cast<uint32_t>(random.GetInt32InRange(1, 256));
+		if (roll < 95)
+			return static_cast<uint32_t>(random.GetInt32InRange(256, 2048));
+
+		return static_cast<uint32_t>(random.GetInt32InRange(2048, 12288));
+	}
+
+	/// Allocations may not overlap and must add up to the used size
+	static bool ValidateAllocator(const BufferAllocator& allocator, const std::vector<BufferAllocationID>& allocations)
+	{
+		std::vector<std::pair<uint32_t, uint32_t>> ranges;
+		ranges.reserve(allocations.size());
+
+		uint64_t used = 0;
+		for (BufferAllocationID id : allocations)
+		{
+			if (!allocator.IsValid(id))
+				return false;
+
+			ranges.emplace_back(allocator.GetOffset(id), allocator.GetSize(id));
+			used += allocator.GetSize(id);
+		}
+
+		std::sort(ranges.begin(), ranges.end());
+		for (size_t i = 0; i < ranges.size(); i++)
+		{
+			if (ranges[i].first + ranges[i].second > allocator.GetCapacity())
+				return false;
+			if (i > 0 && ranges[i - 1].first + ranges[i - 1].second > ranges[i].first)
+				return false;
+		}
+
+		const BufferAllocatorStats stats = allocator.GetStats();
+		return used == allocator.GetUsedSize() && stats.AllocationCount == allocations.size() && stats.LargestFreeRange <= allocator.GetFreeSize();
+	}
+
+	/// Every allocation is drawn by exactly one command with the origin it was added with
+	static bool ValidateDrawCommands(const BufferAllocator& allocator, const std::vector<BufferAllocationID>& allocations, uint32_t& commandCount)
+	{
+		constexpr size_t buckets_per_chunk = 16;
+
+		ChunkDrawCommandBuilder builder;
+		builder.BeginBatch();
+
+		/// Offset -> size and origin
+		std::map<uint32_t, std::pair<uint32_t, glm::vec3>> ranges;
+		for (size_t i = 0; i < allocations.size(); i++)
+		{
+			const glm::vec3 origin = { static_cast<float>(i / buckets_per_chunk * chunk_size_x), 0.0f, 0.0f };
+			builder.Add(origin, 1.0f, allocator.GetOffset(allocations[i]), allocator.GetSize(allocations[i]));
+			ranges[allocator.GetOffset(allocations[i])] = { allocator.GetSize(allocations[i]), origin };
+		}
+
+		commandCount = builder.GetCommandCount();
+		if (builder.GetInstanceCount() != allocator.GetUsedSize() || builder.GetCommands().size() != builder.GetDrawData().size())
+			return false;
+
+		size_t covered = 0;
+		for (uint32_t i = 0; i < builder.GetCommandCount(); i++)
+		{
+			const DrawArraysIndirectCommand& command = builder.GetCommands()[i];
+			if (command.Count != block_vertices_per_face || command.First != 0)
+				return false;
+
+			uint32_t offset = command.BaseInstance;
+			while (offset < command.BaseInstance + command.InstanceCount)
+			{
+				auto it = ranges.find(offset);
+				if (it == ranges.end() || it->second.second != builder.GetDrawData()[i].Origin)
+					return false;
+
+				offset += it->second.first;
+				ranges.erase(it);
+				covered++;
+			}
+
+			if (offset != command.BaseInstance + command.InstanceCount)
+				return false;
+		}
+
+		return covered == allocations.size();
+	}
+
+	int RunBufferBenchmark(const Config& config, const Arguments& args)
+	{
+		const int      frames   = std::max(1, args.GetInt("frames", 2000));
+		const int      resident = std::max(1, args.GetInt("resident", 4096));
+		const int      churn    = std::max(1, args.GetInt("churn", 64));
+		const uint32_t capacity = static_cast<uint32_t>(std::max(1, args.GetInt("capacity", 1024 * 1024)));
+
+		FastRandom random(args.GetInt("seed", 1));
+		BufferAllocator allocator(capacity);
+
+		uint32_t compactions = 0;
+		uint64_t movedFaces  = 0;
+		uint64_t uploadFaces = 0;
+		float    peakFragmentation = 0.0f;
+
+		/// Same policy as Renderer::AllocateChunkFaces
+		auto allocate = [&](uint32_t faceCount) {
+			BufferAllocationID allocation = allocator.Allocate(faceCount);
+			if (allocation != invalid_buffer_allocation)
+				return allocation;
+
+			const uint32_t required = allocator.GetUsedSize() + faceCount;
+			uint32_t newCapacity = allocator.GetCapacity();
+			while (newCapacity - newCapacity / 4 < required)
+				newCapacity *= 2;
+
+			for (const auto& move : allocator.Compact())
+				movedFaces += move.Size;
+			allocator.Grow(newCapacity);
+			compactions++;
+
+			return allocator.Allocate(faceCount);
+		};
+
+		std::vector<BufferAllocationID> allocations;
+		allocations.reserve(resident);
+
+		Timer timer;
+		for (int frame = 0; frame < frames; frame++)
+		{
+			/// Chunks coming into view
+			while (allocations.size() < static_cast<size_t>(resident))
+			{
+				const uint32_t faceCount = GetRandomFaceCount(random);
+				allocations.push_back(allocate(faceCount));
+				uploadFaces += faceCount;
+			}
+
+			/// Remeshed sections take a new size, unloaded ones leave a hole until the next chunk loads
+			for (int i = 0; i < churn && !allocations.empty(); i++)
+			{
+				const size_t index = static_cast<size_t>(random.GetInt32InRange(0, static_cast<int>(allocations.size()) - 1));
+				allocator.Free(allocations[index]);
+
+				if (random.GetInt32InRange(0, 3) == 0)
+				{
+					allocations[index] = allocations.back();
+					allocations.pop_back();
+					continue;
+				}
+
+				const uint32_t faceCount = GetRandomFaceCount(random);
+				allocations[index] = allocate(faceCount);
+				uploadFaces += faceCount;
+			}
+
+			peakFragmentation = std::max(peakFragmentation, allocator.GetStats().GetFragmentation());
+
+			if (std::find(allocations.begin(), allocations.end(), invalid_buffer_allocation) != allocations.end() || !ValidateAllocator(allocator, allocations))
+			{
+				KC_CORE_ERROR("Buffer allocator is inconsistent after frame {}", frame);
+				return 1;
+			}
+		}
+		const double seconds = timer.GetElapsedSeconds();
+
+		const BufferAllocatorStats stats = allocator.GetStats();
+		KC_CORE_INFO("Frames:           {}", frames);
+		KC_CORE_INFO("Time:             {:.3f} s ({:.3f} us per frame)", seconds, seconds * 1'000'000.0 / frames);
+		KC_CORE_INFO("Capacity:         {} -> {} faces", capacity, stats.Capacity);
+		KC_CORE_INFO("Used:             {} faces in {} allocations", stats.UsedSize, stats.AllocationCount);
+		KC_CORE_INFO("Free ranges:      {} (largest {})", stats.FreeRangeCount, stats.LargestFreeRange);
+		KC_CORE_INFO("Fragmentation:    {:.1f}% (peak {:.1f}%)", stats.GetFragmentation() * 100.0f, peakFragmentation * 100.0f);
+		KC_CORE_INFO("Compactions:      {} ({:.2f} MB moved)", compactions, movedFaces * sizeof(BlockMesh) / (1024.0 * 1024.0));
+		KC_CORE_INFO("Uploads:          {:.2f} MB", uploadFaces * sizeof(BlockMesh) / (1024.0 * 1024.0));
+
+		uint32_t commandCount = 0;
+		if (!ValidateDrawCommands(allocator, allocations, commandCount))
+		{
+			KC_CORE_ERROR("Draw commands do not match resident allocations");
+			return 1;
+		}
+		KC_CORE_INFO("Draw commands:    {} for {} allocations", commandCount, allocations.size());
+
+		/// Everything packed, one free range left at the end
+		allocator.Compact();
+		if (!ValidateAllocator(allocator, allocations) || allocator.GetStats().FreeRangeCount > 1)
+		{
+			KC_CORE_ERROR("Buffer allocator is inconsistent after final compaction");
+			return 1;
+		}
+
+		/// Buckets of one chunk that ended up next to each other are drawn by one command
+		if (!ValidateDrawCommands(allocator, allocations, commandCount))
+		{
+			KC_CORE_ERROR("Draw commands do not match compacted allocations");
+			return 1;
+		}
+		KC_CORE_INFO("Compacted:        {} draw commands", commandCount);
+
+		/// Freeing everything merges all ranges back into one
+		for (BufferAllocationID id : allocations)
+			allocator.Free(id);
+		if (allocator.GetUsedSize() != 0 || allocator.GetStats().FreeRangeCount != 1 || allocator.GetStats().LargestFreeRange != allocator.GetCapacity())
+		{
+			KC_CORE_ERROR("Buffer allocator did not merge free ranges");
+			return 1;
+		}
+
+		KC_CORE_INFO("Validation:       passed");
+
+		return 0;
+	}
+
+}
@@ -0,0 +1,17 @@
+#pragma once
+
+#include "BenchUtils.h"
+
+namespace KuchCraft::Bench {
+
+	/// Replays chunk mesh uploads, remeshes and unloads on BufferAllocator alone, the way Renderer uses it for the chunk buffer.
+	/// Every allocation is checked against all others after each frame, returns 1 if any two overlap or the stats disagree.
+	/// Ends by building chunk draw commands for the resident allocations and checking that each is drawn exactly once.
+	///   --frames     F      simulated frames (default 2000)
+	///   --resident   N      section buckets kept resident (default 4096)
+	///   --churn      C      buckets remeshed or replaced per frame (default 64)
+	///   --capacity   K      initial capacity in faces (default 1048576)
+	///   --seed       S      random seed
+	int RunBufferBenchmark(const Config& config, const Arguments& args);
+
+}
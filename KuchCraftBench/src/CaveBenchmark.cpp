@@ -0,0 +1,63 @@
+#include "kcpch.h"
+#include "CaveBenchmark.h"
+
+#include "KuchCraft/World/WorldGenerator.h"
+
+namespace KuchCraft::Bench {
+
+	int RunCaveBenchmark(const Config& config, const Arguments& args)
+	{
+		const uint32_t chunkCount = static_cast<uint32_t>(std::max(1, args.GetInt("chunks", 16)));
+		const uint32_t seed       = static_cast<uint32_t>(args.GetInt("seed", static_cast<int>(default_world_seed)));
+
+		/// Caves do not place blocks, so no data pack is needed
+		WorldGenerator generator(config, WorldGeneratorBlocks{}, seed);
+
+		std::vector<uint8_t> naiveMask(block_count_per_chunk);
+		std::vector<uint8_t> coarseMask(block_count_per_chunk);
+
+		double   naiveMilliseconds  = 0.0;
+		double   coarseMilliseconds = 0.0;
+		uint64_t skippedCells       = 0;
+		uint64_t matchingVoxels     = 0;
+
+		for (uint32_t i = 0; i < chunkCount; i++)
+		{
+			const glm::ivec3 chunkPosition = { static_cast<int>(i * chunk_size_x), 0, 0 };
+
+			Timer naiveTimer;
+			for (uint32_t y = 0; y < chunk_size_y; y++)
+			{
+				for (uint32_t z = 0; z < chunk_size_z; z++)
+				{
+					for (uint32_t x = 0; x < chunk_size_x; x++)
+					{
+						const float density = generator.SampleCaveDensity(
+							static_cast<float>(chunkPosition.x + x), static_cast<float>(chunkPosition.y + y), static_cast<float>(chunkPosition.z + z));
+						naiveMask[(y * chunk_size_z + z) * chunk_size_x + x] = y >= cave_min_height && density > cave_threshold;
+					}
+				}
+			}
+			naiveMilliseconds += naiveTimer.GetElapsedMilliseconds();
+
+			Timer coarseTimer;
+			skippedCells += generator.EvaluateCaveMask(chunkPosition, coarseMask.data());
+			coarseMilliseconds += coarseTimer.GetElapsedMilliseconds();
+
+			for (uint32_t v = 0; v < block_count_per_chunk; v++)
+				matchingVoxels += naiveMask[v] == coarseMask[v];
+		}
+
+		const uint64_t totalCells = static_cast<uint64_t>(chunkCount) * cave_cells_x * cave_cells_y * cave_cells_z;
+
+		KC_CORE_INFO("Chunks:           {}, seed {}", chunkCount, seed);
+		KC_CORE_INFO("Naive per-voxel:  {:.3f} ms ({:.3f} ms/chunk)", naiveMilliseconds, naiveMilliseconds / chunkCount);
+		KC_CORE_INFO("Coarse lattice:   {:.3f} ms ({:.3f} ms/chunk)", coarseMilliseconds, coarseMilliseconds / chunkCount);
+		KC_CORE_INFO("Speedup:          {:.1f}x", coarseMilliseconds > 0.0 ? naiveMilliseconds / coarseMilliseconds : 0.0);
+		KC_CORE_INFO("Skipped cells:    {} / {}", skippedCells, totalCells);
+		KC_CORE_INFO("Agreement:        {:.2f}%", matchingVoxels * 100.0 / (static_cast<double>(chunkCount) * block_count_per_chunk));
+
+		return 0;
+	}
+
+}
@@ -0,0 +1,12 @@
+#pragma once
+
+#include "BenchUtils.h"
+
+namespace KuchCraft::Bench {
+
+	/// Compares the coarse lattice cave evaluation used by generation against naive per-voxel 3D noise.
+	///   --chunks   N        chunks to evaluate (default 16)
+	///   --seed     S        world seed
+	int RunCaveBenchmark(const Config& config, const Arguments& args);
+
+}
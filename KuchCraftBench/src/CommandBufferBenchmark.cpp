@@ -0,0 +1,103 @@
+#include "kcpch.h"
+#include "CommandBufferBenchmark.h"
+
+#include "Graphics/Core/RenderBackend.h"
+
+namespace KuchCraft::Bench {
+
+	struct RecordedCounts
+	{
+		uint64_t Draws        = 0;
+		uint64_t StateChanges = 0;
+		uint64_t Uploads      = 0;
+		uint64_t UploadSize   = 0;
+	};
+
+	/// Roughly what the renderer records for batched sprites: a pipeline, then draws with a uniform each,
+	/// textures and blending switched every few draws and vertex data uploaded every batch
+	static RecordedCounts RecordFrame(RenderCommandBuffer& commands, int draws, const std::vector<uint8_t>& vertices)
+	{
+		RecordedCounts counts;
+
+		commands.Record(RenderCommands::BindFrameBuffer{ 0, 1280, 720 });
+		commands.Record(RenderCommands::Clear{ glm::vec4(0.1f, 0.1f, 0.1f, 1.0f) });
+		commands.Record(RenderCommands::BindShader{ 1 });
+		commands.Record(RenderCommands::BindVertexArray{ 1 });
+		counts.StateChanges += 4;
+
+		for (int i = 0; i < draws; i++)
+		{
+			if (i % 1000 == 0)
+			{
+				commands.Record(RenderCommands::SetVertexBufferData{ nullptr, 0, vertices.size(), commands.RecordData(vertices.data(), vertices.size()) });
+				counts.Uploads++;
+				counts.UploadSize += vertices.size();
+			}
+
+			if (i % 16 == 0)
+			{
+				commands.Record(RenderCommands::BindTexture{ static_cast<uint32_t>(i / 16 % 32), static_cast<RendererID>(i / 16 + 1) });
+				commands.Record(RenderCommands::SetBlend{ (i / 16) % 2 == 0 });
+				counts.StateChanges += 2;
+			}
+
+			commands.Record(RenderCommands::SetUniformInt{ 1, 0, i });
+			commands.Record(RenderCommands::DrawElements{ PrimitiveTopology::Triangles, 6, 0, 1, i * 4 });
+			counts.StateChanges++;
+			counts.Draws++;
+		}
+
+		return counts;
+	}
+
+	int RunCommandBufferBenchmark(const Config& config, const Arguments& args)
+	{
+		const int draws      = std::max(1, args.GetInt("draws", 100'000));
+		const int iterations = std::max(1, args.GetInt("iterations", 100));
+
+		/// 1000 quads of sprite vertices
+		const std::vector<uint8_t> vertices(1000 * quad_vertex_count * sizeof(VertexQuad2D), 0x7f);
+
+		RenderCommandBuffer commands;
+		NullRenderBackend   backend;
+
+		RecordedCounts counts;
+		double recordMilliseconds  = 0.0;
+		double executeMilliseconds = 0.0;
+
+		for (int i = 0; i < iterations; i++)
+		{
+			commands.Clear();
+
+			Timer recordTimer;
+			counts = RecordFrame(commands, draws, vertices);
+			recordMilliseconds += recordTimer.GetElapsedMilliseconds();
+
+			backend.Reset();
+
+			Timer executeTimer;
+			backend.Execute(commands);
+			executeMilliseconds += executeTimer.GetElapsedMilliseconds();
+		}
+
+		recordMilliseconds  /= iterations;
+		executeMilliseconds /= iterations;
+
+		const uint64_t recorded = counts.Draws + counts.StateChanges + counts.Uploads;
+		const bool passed =
+			backend.GetCommandCount() == recorded && commands.GetCommandCount() == recorded &&
+			backend.GetDrawCount() == counts.Draws &&
+			backend.GetCount(RenderCommandType::SetVertexBufferData) == counts.Uploads &&
+			backend.GetUploadSize() == counts.UploadSize &&
+			backend.GetCount(RenderCommandType::SetUniformInt) == counts.Draws;
+
+		KC_CORE_INFO("Commands:         {} per frame ({} draws)", commands.GetCommandCount(), counts.Draws);
+		KC_CORE_INFO("Buffer size:      {:.2f} KB ({:.2f} KB of uploaded data)", commands.GetSize() / 1024.0, counts.UploadSize / 1024.0);
+		KC_CORE_INFO("Record:           {:.3f} ms ({:.2f} ns per command)", recordMilliseconds, recordMilliseconds * 1'000'000.0 / recorded);
+		KC_CORE_INFO("Execute (null):   {:.3f} ms ({:.2f} ns per command)", executeMilliseconds, executeMilliseconds * 1'000'000.0 / recorded);
+		KC_CORE_INFO("Validation:       {}", passed ? "passed" : "failed");
+
+		return passed ? 0 : 1;
+	}
+
+}
@@ -0,0 +1,13 @@
+#pragma once
+
+#include "BenchUtils.h"
+
+namespace KuchCraft::Bench {
+
+	/// Records frames of render commands into a RenderCommandBuffer and executes them with NullRenderBackend,
+	/// returns 1 when the backend counts differ from what was recorded.
+	///   --draws      N      draws per frame, each with a uniform and every 16th with state changes (default 100000)
+	///   --iterations I      recorded and executed frames (default 100)
+	int RunCommandBufferBenchmark(const Config& config, const Arguments& args);
+
+}
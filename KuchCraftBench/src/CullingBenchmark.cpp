@@ -0,0 +1,93 @@
+#include "kcpch.h"
+#include "CullingBenchmark.h"
+
+#include "Graphics/Core/Camera.h"
+#include "Graphics/Core/Frustum.h"
+
+namespace KuchCraft::Bench {
+
+	/// Boxes right in front of and right behind the camera
+	static bool ValidateKnownBoxes(const Camera& camera, const Frustum& frustum)
+	{
+		const glm::vec3 ahead  = camera.GetPosition() + camera.GetForwardDirection() * 10.0f;
+		const glm::vec3 behind = camera.GetPosition() - camera.GetForwardDirection() * 10.0f;
+		const glm::vec3 far    = camera.GetPosition() + camera.GetForwardDirection() * (camera.GetFarClip() + 10.0f);
+
+		return frustum.IntersectsAABB(ahead - 0.5f, ahead + 0.5f) && !frustum.IntersectsAABB(behind - 0.5f, behind + 0.5f) &&
+			!frustum.IntersectsAABB(far - 0.5f, far + 0.5f) && Frustum().IntersectsAABB(behind - 0.5f, behind + 0.5f);
+	}
+
+	int RunCullingBenchmark(const Config& config, const Arguments& args)
+	{
+		const int   chunks     = std::max(1, args.GetInt("chunks", 32));
+		const int   iterations = std::max(1, args.GetInt("iterations", 200));
+		const float yaw        = glm::radians(static_cast<float>(args.GetInt("yaw", 30)));
+
+		Camera camera(glm::radians(45.0f), 16.0f / 9.0f, 0.1f, 1000.0f);
+		camera.UpdateTransform(glm::vec3(0.0f, 80.0f, 0.0f), glm::vec3(yaw, glm::radians(-10.0f), 0.0f));
+
+		const Frustum frustum(camera.GetViewProjection());
+		if (!ValidateKnownBoxes(camera, frustum))
+		{
+			KC_CORE_ERROR("Frustum planes are wrong");
+			return 1;
+		}
+
+		std::vector<std::pair<glm::vec3, glm::vec3>> bounds;
+		FrustumCuller culler;
+		culler.Reserve(static_cast<size_t>(chunks) * chunks * sections_per_chunk);
+		for (int z = 0; z < chunks; z++)
+		{
+			for (int x = 0; x < chunks; x++)
+			{
+				for (uint32_t section = 0; section < sections_per_chunk; section++)
+				{
+					const glm::vec3 min = {
+						static_cast<float>((x - chunks / 2) * (int)chunk_size_x),
+						static_cast<float>(section * section_size_y),
+						static_cast<float>((z - chunks / 2) * (int)chunk_size_z)
+					};
+					const glm::vec3 max = min + glm::vec3(section_size_x, section_size_y, section_size_z);
+					culler.Add(min, max);
+					bounds.emplace_back(min, max);
+				}
+			}
+		}
+
+		std::vector<uint8_t> visible;
+		uint32_t visibleCount = 0;
+
+		Timer cullTimer;
+		for (int i = 0; i < iterations; i++)
+			visibleCount = culler.Cull(frustum, visible);
+		const double cullMilliseconds = cullTimer.GetElapsedMilliseconds() / iterations;
+
+		uint32_t referenceCount = 0;
+		Timer referenceTimer;
+		for (int i = 0; i < iterations; i++)
+		{
+			referenceCount = 0;
+			for (const auto& [min, max] : bounds)
+				referenceCount += frustum.IntersectsAABB(min, max);
+		}
+		const double referenceMilliseconds = referenceTimer.GetElapsedMilliseconds() / iterations;
+
+		for (size_t i = 0; i < bounds.size(); i++)
+		{
+			if ((visible[i] != 0) != frustum.IntersectsAABB(bounds[i].first, bounds[i].second))
+			{
+				KC_CORE_ERROR("Section {} culled differently than Frustum::IntersectsAABB", i);
+				return 1;
+			}
+		}
+
+		KC_CORE_INFO("Sections:         {}", bounds.size());
+		KC_CORE_INFO("Visible:          {} ({} culled)", visibleCount, bounds.size() - visibleCount);
+		KC_CORE_INFO("Culler:           {:.3f} ms ({:.2f} ns per section)", cullMilliseconds, cullMilliseconds * 1'000'000.0 / bounds.size());
+		KC_CORE_INFO("Per box:          {:.3f} ms ({:.2f} ns per section)", referenceMilliseconds, referenceMilliseconds * 1'000'000.0 / bounds.size());
+		KC_CORE_INFO("Validation:       {}", visibleCount == referenceCount ? "passed" : "failed");
+
+		return visibleCount == referenceCount ? 0 : 1;
+	}
+
+}
@@ -0,0 +1,14 @@
+#pragma once
+
+#include "BenchUtils.h"
+
+namespace KuchCraft::Bench {
+
+	/// Culls section bounds of a square chunk area around a camera with FrustumCuller and checks every result
+	/// against Frustum::IntersectsAABB, returns 1 on any mismatch.
+	///   --chunks     N      area size in chunks, 16 sections each (default 32, 16384 sections)
+	///   --iterations I      how many times the whole area is culled (default 200)
+	///   --yaw        D      camera yaw in degrees (default 30)
+	int RunCullingBenchmark(const Config& config, const Arguments& args);
+
+}
@@ -0,0 +1,162 @@
+#include "kcpch.h"
+#include "MeshBenchmark.h"
+
+#include "KuchCraft/World/ItemManager.h"
+#include "KuchCraft/World/WorldGenerator.h"
+
+namespace KuchCraft::Bench {
+
+	/// Edits land on the bottom layer of a section, so the section below is rebuilt as well
+	constexpr int bench_edit_height = 64;
+
+	int RunMeshBenchmark(const Config& config, const Arguments& args)
+	{
+		const int      size       = std::max(1, args.GetInt("size", 8));
+		const int      iterations = std::max(1, args.GetInt("iterations", 4));
+		const uint32_t seed       = static_cast<uint32_t>(args.GetInt("seed", static_cast<int>(default_world_seed)));
+		const std::string dataPack = args.GetString("datapack", "default");
+
+		ChunkMeshSettings settings;
+		settings.Greedy           = args.GetInt("greedy", config.Renderer.GreedyMeshing    ? 1 : 0) != 0;
+		settings.AmbientOcclusion = args.GetInt("ao",     config.Renderer.AmbientOcclusion ? 1 : 0) != 0;
+
+		ItemManager itemManager(config);
+		if (!itemManager.SetDataPack(dataPack, false))
+		{
+			KC_CORE_ERROR("Failed to load data pack: {}", dataPack);
+			return 1;
+		}
+
+		WorldGenerator generator(config, WorldGeneratorBlocks::Resolve(itemManager), seed);
+
+		std::vector<Ref<Chunk>> chunks;
+		chunks.reserve(static_cast<size_t>(size) * size);
+		for (int z = 0; z < size; z++)
+		{
+			for (int x = 0; x < size; x++)
+			{
+				const glm::ivec3 position = { (x - size / 2) * (int)chunk_size_x, 0, (z - size / 2) * (int)chunk_size_z };
+				auto chunk = CreateRef<Chunk>(position, nullptr);
+				generator.GenerateChunk(chunk);
+				chunk->Build();
+				chunks.push_back(chunk);
+			}
+		}
+
+		for (auto& chunk : chunks)
+			generator.GetPendingEdits().ApplyNew(*chunk);
+
+		KC_CORE_INFO("Meshing {}x{} chunks, {} iteration(s), greedy: {}, ambient occlusion: {}", size, size, iterations, settings.Greedy, settings.AmbientOcclusion);
+
+		std::vector<double> latencies;
+		latencies.reserve(chunks.size() * iterations);
+
+		size_t quadCount = 0;
+		size_t faceCount   = 0;
+		Timer totalTimer;
+		for (int i = 0; i < iterations; i++)
+		{
+			quadCount = 0;
+			faceCount   = 0;
+			for (auto& chunk : chunks)
+			{
+				/// Chunks have no World, so faces on chunk borders are skipped like next to an unbuilt neighbor
+				ChunkMesh mesh(chunk.get());
+
+				Timer chunkTimer;
+				mesh.Build(itemManager.GetBlockProperties(), settings);
+				mesh.SwapBuffers();
+				latencies.push_back(chunkTimer.GetElapsedMilliseconds());
+
+				quadCount += mesh.GetQuadCount();
+				faceCount   += mesh.GetFaceCount();
+			}
+		}
+		const double totalSeconds = totalTimer.GetElapsedSeconds();
+
+		KC_CORE_INFO("Chunks meshed:    {}", latencies.size());
+		KC_CORE_INFO("Throughput:       {:.1f} chunks/s", totalSeconds > 0.0 ? latencies.size() / totalSeconds : 0.0);
+		KC_CORE_INFO("Latency p50:      {:.3f} ms", Percentile(latencies, 0.50));
+		KC_CORE_INFO("Latency p99:      {:.3f} ms", Percentile(latencies, 0.99));
+		KC_CORE_INFO("Faces:            {}", faceCount);
+		KC_CORE_INFO("Quads:            {} ({:.2f}x reduction)", quadCount, quadCount > 0 ? (double)faceCount / quadCount : 1.0);
+		KC_CORE_INFO("Mesh memory:      {:.2f} MB", quadCount * sizeof(BlockMesh) / (1024.0 * 1024.0));
+
+		/// Meshes of every iteration are destroyed before the next one, so their buffers should come back from the pool
+		const MeshBufferPoolStats poolStats = MeshBufferPool::Get().GetStats();
+		KC_CORE_INFO("Buffer reuse:     {} of {} allocations", poolStats.Reuses, poolStats.Reuses + poolStats.SystemAllocations);
+		KC_CORE_INFO("Pooled memory:    {:.2f} MB", poolStats.PooledBytes / (1024.0 * 1024.0));
+		/// Downsampled meshes of the same chunks, far chunks are drawn with these instead, so every level has to be smaller than level 0
+		bool lodPassed = true;
+		for (uint32_t level = 1; level < chunk_mesh_lod_count; level++)
+		{
+			size_t lodQuadCount = 0;
+			Timer lodTimer;
+			for (auto& chunk : chunks)
+			{
+				ChunkMesh mesh(chunk.get());
+				mesh.BuildLod(level, itemManager.GetBlockProperties());
+				lodQuadCount += mesh.GetQuadCount(level);
+			}
+
+			const bool smaller = lodQuadCount < quadCount;
+			lodPassed = lodPassed && smaller;
+
+			KC_CORE_INFO("LOD {}x quads:     {} ({:.2f}x fewer, {:.3f} ms per chunk){}", 1u << level, lodQuadCount,
+				lodQuadCount > 0 ? (double)quadCount / lodQuadCount : 1.0, lodTimer.GetElapsedMilliseconds() / chunks.size(),
+				smaller ? "" : ", not smaller than level 0");
+		}
+
+		/// Single block edits, only the edited section and the section next to it are rebuilt
+		std::vector<double> editLatencies;
+		editLatencies.reserve(chunks.size());
+
+		uint32_t rebuiltSections = 0;
+		for (auto& chunk : chunks)
+		{
+			ChunkMesh mesh(chunk.get());
+			mesh.Build(itemManager.GetBlockProperties(), settings);
+
+			const glm::ivec3 position = { chunk_size_x / 2, bench_edit_height, chunk_size_z / 2 };
+			const Block previous = chunk->GetBlock(position);
+			chunk->SetBlock(position, Block());
+
+			Timer editTimer;
+			rebuiltSections += mesh.Update(itemManager.GetBlockProperties(), settings);
+			mesh.SwapBuffers();
+			editLatencies.push_back(editTimer.GetElapsedMilliseconds());
+
+			chunk->SetBlock(position, previous);
+		}
+
+		KC_CORE_INFO("Edit remesh p50:  {:.3f} ms ({:.1f} sections per edit)", Percentile(editLatencies, 0.50), (double)rebuiltSections / editLatencies.size());
+		KC_CORE_INFO("Edit remesh p99:  {:.3f} ms", Percentile(editLatencies, 0.99));
+
+		/// Same chunks and iterations with only ambient occlusion toggled
+		auto measurePass = [&](bool ambientOcclusion) {
+			ChunkMeshSettings passSettings = settings;
+			passSettings.AmbientOcclusion = ambientOcclusion;
+
+			Timer passTimer;
+			for (int i = 0; i < iterations; i++)
+			{
+				for (auto& chunk : chunks)
+				{
+					ChunkMesh mesh(chunk.get());
+					mesh.Build(itemManager.GetBlockProperties(), passSettings);
+				}
+			}
+
+			return passTimer.GetElapsedMilliseconds() / (chunks.size() * iterations);
+		};
+
+		const double withoutOcclusion = measurePass(false);
+		const double withOcclusion    = measurePass(true);
+		KC_CORE_INFO("Ambient occlusion: {:.3f} ms -> {:.3f} ms per chunk ({:+.1f}%)", withoutOcclusion, withOcclusion,
+			withoutOcclusion > 0.0 ? (withOcclusion / withoutOcclusion - 1.0) * 100.0 : 0.0);
+		KC_CORE_INFO("Peak memory:      {:.2f} MB", GetPeakMemoryUsage() / (1024.0 * 1024.0));
+
+		return lodPassed ? 0 : 1;
+	}
+
+}
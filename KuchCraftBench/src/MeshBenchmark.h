@@ -0,0 +1,18 @@
+#pragma once
+
+#include "BenchUtils.h"
+
+namespace KuchCraft::Bench {
+
+	/// Generates an N x N chunk area and measures ChunkMesh::Build and single block edit rebuilds on it.
+	///   --size       N      area size in chunks (default 8)
+	///   --iterations I      how many times every chunk is meshed (default 4)
+	///   --seed       S      world seed
+	///   --datapack   name   data pack to load item data from (default "default")
+	///   --greedy     0|1    merge faces into larger quads (default from config)
+	///   --ao         0|1    bake ambient occlusion (default from config)
+	/// Also reports quad counts of the 2x and 4x LOD meshes, returns 1 when one of them is not smaller than the full mesh.
+	/// Ends with one pass of the same chunks with ambient occlusion off and on, to show what baking it costs.
+	int RunMeshBenchmark(const Config& config, const Arguments& args);
+
+}
@@ -0,0 +1,107 @@
+#include "kcpch.h"
+#include "RenderQueueBenchmark.h"
+
+#include "Graphics/Core/RenderQueue.h"
+
+namespace KuchCraft::Bench {
+
+	/// A few shaders and textures, opaque items front to back and blended ones back to front, like a frame of the renderer
+	static std::vector<uint64_t> MakeRendererKeys(FastRandom& random, int count)
+	{
+		std::vector<uint64_t> keys;
+		keys.reserve(count);
+		for (int i = 0; i < count; i++)
+		{
+			const uint32_t shader   = random.GetInt32InRange(1, 4);
+			const uint32_t texture  = random.GetInt32InRange(1, 32);
+			const float    distance = random.GetFloat32InRange(0.0f, 1000.0f);
+
+			if (random.GetInt32InRange(0, 3) == 0)
+				keys.push_back(RenderSortKey::Blended(RenderPass::Translucent, RenderSortKey::BackToFront(distance), shader, texture));
+			else
+				keys.push_back(RenderSortKey::Opaque(RenderPass::Opaque, shader, texture, RenderSortKey::FrontToBack(distance)));
+		}
+
+		return keys;
+	}
+
+	static std::vector<uint64_t> MakeRandomKeys(FastRandom& random, int count)
+	{
+		std::vector<uint64_t> keys;
+		keys.reserve(count);
+		for (int i = 0; i < count; i++)
+			keys.push_back((uint64_t)random.GetUInt32() << 32 | random.GetUInt32());
+
+		return keys;
+	}
+
+	/// Returns false when the queue order differs from std::stable_sort
+	static bool RunKeySet(const char* name, const std::vector<uint64_t>& keys, int iterations)
+	{
+		RenderQueue queue;
+		queue.Reserve(keys.size());
+
+		Timer queueTimer;
+		for (int i = 0; i < iterations; i++)
+		{
+			queue.Clear();
+			for (uint32_t index = 0; index < static_cast<uint32_t>(keys.size()); index++)
+				queue.Add(keys[index], index);
+
+			queue.Sort();
+		}
+		const double queueMilliseconds = queueTimer.GetElapsedMilliseconds() / iterations;
+
+		std::vector<RenderQueueItem> reference;
+		Timer referenceTimer;
+		for (int i = 0; i < iterations; i++)
+		{
+			reference.clear();
+			for (uint32_t index = 0; index < static_cast<uint32_t>(keys.size()); index++)
+				reference.push_back({ keys[index], index });
+
+			std::stable_sort(reference.begin(), reference.end(), [](const RenderQueueItem& a, const RenderQueueItem& b) { return a.Key < b.Key; });
+		}
+		const double referenceMilliseconds = referenceTimer.GetElapsedMilliseconds() / iterations;
+
+		const auto& items = queue.GetItems();
+		const bool passed = std::equal(items.begin(), items.end(), reference.begin(), reference.end(),
+			[](const RenderQueueItem& a, const RenderQueueItem& b) { return a.Key == b.Key && a.Index == b.Index; });
+
+		KC_CORE_INFO("{} keys:", name);
+		KC_CORE_INFO("  Radix sort:     {:.3f} ms ({:.2f} ns per item)", queueMilliseconds, queueMilliseconds * 1'000'000.0 / keys.size());
+		KC_CORE_INFO("  Stable sort:    {:.3f} ms ({:.2f} ns per item)", referenceMilliseconds, referenceMilliseconds * 1'000'000.0 / keys.size());
+		KC_CORE_INFO("  Validation:     {}", passed ? "passed" : "failed");
+
+		return passed;
+	}
+
+	int RunRenderQueueBenchmark(const Config& config, const Arguments& args)
+	{
+		const int items      = std::max(1, args.GetInt("items", 100'000));
+		const int iterations = std::max(1, args.GetInt("iterations", 100));
+
+		FastRandom random(args.GetInt("seed", 1));
+
+		/// Keys of one pass and state only differ in depth, their sorted order has to follow it
+		const bool depthOrder =
+			RenderSortKey::Opaque(RenderPass::Opaque, 1, 1, RenderSortKey::FrontToBack(1.0f)) < RenderSortKey::Opaque(RenderPass::Opaque, 1, 1, RenderSortKey::FrontToBack(2.0f)) &&
+			RenderSortKey::Blended(RenderPass::Translucent, RenderSortKey::BackToFront(2.0f), 1, 1) < RenderSortKey::Blended(RenderPass::Translucent, RenderSortKey::BackToFront(1.0f), 1, 1) &&
+			RenderSortKey::Opaque(RenderPass::Opaque, 4095, 65535, ~0u) < RenderSortKey::Blended(RenderPass::Translucent, 0, 0, 0) &&
+			RenderSortKey::GetPass(RenderSortKey::Blended(RenderPass::Overlay, ~0u, 1, 1)) == RenderPass::Overlay;
+
+		if (!depthOrder)
+		{
+			KC_CORE_ERROR("Sort key fields are in the wrong order");
+			return 1;
+		}
+
+		KC_CORE_INFO("Items:            {}", items);
+
+		const bool rendererPassed = RunKeySet("Renderer", MakeRendererKeys(random, items), iterations);
+		const bool randomPassed   = RunKeySet("Random",   MakeRandomKeys(random, items),   iterations);
+
+		return rendererPassed && randomPassed ? 0 : 1;
+	}
+
+}
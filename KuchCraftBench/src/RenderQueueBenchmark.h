@@ -0,0 +1,14 @@
+#pragma once
+
+#include "BenchUtils.h"
+
+namespace KuchCraft::Bench {
+
+	/// Sorts draw items with RenderQueue and with std::stable_sort, returns 1 when the orders differ.
+	/// Runs once with keys made like the renderer makes them and once with fully random keys.
+	///   --items      N      draw items per sort (default 100000)
+	///   --iterations I      sorts of each key set (default 100)
+	///   --seed       S      random seed (default 1)
+	int RunRenderQueueBenchmark(const Config& config, const Arguments& args);
+
+}
@@ -0,0 +1,125 @@
+#include "kcpch.h"
+#include "RenderThreadBenchmark.h"
+
+#include "Graphics/Core/RenderThread.h"
+
+namespace KuchCraft::Bench {
+
+	/// Keeps the thread busy instead of sleeping, like real update or driver work would
+	static void SimulateWork(double milliseconds)
+	{
+		Timer timer;
+		while (timer.GetElapsedMilliseconds() < milliseconds)
+			;
+	}
+
+	static void RecordFrame(RenderCommandBuffer& commands, int draws)
+	{
+		commands.Record(RenderCommands::BindFrameBuffer{ 0, 1280, 720 });
+		commands.Record(RenderCommands::Clear{ glm::vec4(0.1f, 0.1f, 0.1f, 1.0f) });
+		commands.Record(RenderCommands::BindShader{ 1 });
+		commands.Record(RenderCommands::BindVertexArray{ 1 });
+
+		for (int i = 0; i < draws; i++)
+		{
+			if (i % 16 == 0)
+				commands.Record(RenderCommands::BindTexture{ static_cast<uint32_t>(i / 16 % 32), static_cast<RendererID>(i / 16 + 1) });
+
+			commands.Record(RenderCommands::DrawElements{ PrimitiveTopology::Triangles, 6, 0, 1, i * 4 });
+		}
+	}
+
+	int RunRenderThreadBenchmark(const Config& config, const Arguments& args)
+	{
+		const int    draws     = std::max(1, args.GetInt("draws", 20'000));
+		const int    frames    = std::max(1, args.GetInt("frames", 200));
+		const double updateMs  = std::max(0, args.GetInt("update-us", 4000))  / 1000.0;
+		const double presentMs = std::max(0, args.GetInt("present-us", 4000)) / 1000.0;
+		const int    syncEvery = std::max(0, args.GetInt("sync-every", 50));
+
+		RenderCommandBuffer commands;
+		RecordFrame(commands, draws);
+		const uint64_t commandsPerFrame = commands.GetCommandCount();
+		commands.Clear();
+
+		/// Serial: update, record, execute and present one after another on one thread
+		NullRenderBackend serialBackend;
+		double serialRecordMs  = 0.0;
+		double serialExecuteMs = 0.0;
+
+		Timer serialTimer;
+		for (int frame = 0; frame < frames; frame++)
+		{
+			SimulateWork(updateMs);
+
+			Timer recordTimer;
+			RecordFrame(commands, draws);
+			serialRecordMs += recordTimer.GetElapsedMilliseconds();
+
+			Timer executeTimer;
+			serialBackend.Execute(commands);
+			commands.Clear();
+			SimulateWork(presentMs);
+			serialExecuteMs += executeTimer.GetElapsedMilliseconds();
+		}
+		const double serialMs = serialTimer.GetElapsedMilliseconds();
+
+		/// Pipelined: the main thread records frame N + 1 while the render thread executes frame N
+		NullRenderBackend threadedBackend;
+		RenderThreadStats threadStats;
+		double   threadedRecordMs = 0.0;
+		uint32_t misorderedSyncs  = 0;
+
+		Timer threadedTimer;
+		{
+			RenderThread renderThread(threadedBackend);
+			for (int frame = 0; frame < frames; frame++)
+			{
+				SimulateWork(updateMs);
+
+				Timer recordTimer;
+				RecordFrame(commands, draws);
+				threadedRecordMs += recordTimer.GetElapsedMilliseconds();
+
+				renderThread.Submit(commands, [presentMs]() { SimulateWork(presentMs); });
+
+				/// Like a resize, every submitted frame has to be executed before the task runs
+				if (syncEvery > 0 && (frame + 1) % syncEvery == 0)
+				{
+					const uint64_t submitted = static_cast<uint64_t>(frame + 1) * commandsPerFrame;
+					renderThread.Invoke([&]() {
+						if (threadedBackend.GetCommandCount() != submitted)
+							misorderedSyncs++;
+					});
+				}
+			}
+
+			renderThread.WaitIdle();
+			threadStats = renderThread.GetStats();
+		}
+		const double threadedMs = threadedTimer.GetElapsedMilliseconds();
+
+		/// Both runs do the same work, the wall time saved is work of the two threads that ran at the same time.
+		/// Execute time is wall time of the render thread, it includes time the thread was preempted on a busy machine
+		const double renderBusyMs = threadStats.ExecuteTime;
+		const double overlapMs    = std::max(0.0, serialMs - threadedMs);
+
+		const uint64_t expected = static_cast<uint64_t>(frames) * commandsPerFrame;
+		const bool passed =
+			serialBackend.GetCommandCount()   == expected &&
+			threadedBackend.GetCommandCount() == expected &&
+			threadStats.Frames == static_cast<uint32_t>(frames) &&
+			misorderedSyncs == 0;
+
+		KC_CORE_INFO("Frames:           {} x {} commands, {} hardware threads", frames, commandsPerFrame, std::thread::hardware_concurrency());
+		KC_CORE_INFO("Simulated work:   {:.2f} ms update, {:.2f} ms present", updateMs, presentMs);
+		KC_CORE_INFO("Serial:           {:.3f} ms per frame ({:.3f} ms record, {:.3f} ms execute)", serialMs / frames, serialRecordMs / frames, serialExecuteMs / frames);
+		KC_CORE_INFO("Render thread:    {:.3f} ms per frame ({:.3f} ms record, {:.3f} ms execute)", threadedMs / frames, threadedRecordMs / frames, renderBusyMs / frames);
+		KC_CORE_INFO("Main thread wait: {:.3f} ms per frame on a full queue, {:.3f} ms in {} sync points", threadStats.SubmitWaitTime / frames, threadStats.SyncTime, threadStats.SyncCount);
+		KC_CORE_INFO("Overlap:          {:.3f} ms per frame ({:.1f}% of serial execute and present), speedup {:.2f}x", overlapMs / frames, serialExecuteMs > 0.0 ? overlapMs / serialExecuteMs * 100.0 : 0.0, serialMs / threadedMs);
+		KC_CORE_INFO("Validation:       {}", passed ? "passed" : "failed");
+
+		return passed ? 0 : 1;
+	}
+
+}
@@ -0,0 +1,16 @@
+#pragma once
+
+#include "BenchUtils.h"
+
+namespace KuchCraft::Bench {
+
+	/// Runs the same frames serially and through a RenderThread with NullRenderBackend, then reports how much of the
+	/// main thread work overlapped with execution. Returns 1 when a frame is lost or a sync point runs before earlier frames.
+	///   --draws      N      draws recorded per frame (default 20000)
+	///   --frames     F      frames of each run (default 200)
+	///   --update-us  U      simulated game update on the main thread per frame, in microseconds (default 4000)
+	///   --present-us P      simulated driver and present time on the render thread per frame, in microseconds (default 4000)
+	///   --sync-every S      frames between sync points, 0 disables them (default 50)
+	int RunRenderThreadBenchmark(const Config& config, const Arguments& args);
+
+}
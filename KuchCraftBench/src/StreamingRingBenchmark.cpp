@@ -0,0 +1,108 @@
+#include "kcpch.h"
+#include "StreamingRingBenchmark.h"
+
+#include "Graphics/Core/StreamingRing.h"
+
+namespace KuchCraft::Bench {
+
+	/// Bytes written for one batch that the simulated GPU may still read
+	struct InFlightRange
+	{
+		uint64_t Offset = 0;
+		uint64_t Size   = 0;
+		uint32_t Region = 0;
+		int      Frame  = 0;
+	};
+
+	int RunStreamingRingBenchmark(const Config& config, const Arguments& args)
+	{
+		const int      frames     = std::max(1, args.GetInt("frames", 5000));
+		const int      maxBatches = std::max(1, args.GetInt("batches", 3));
+		const int      maxQuads   = std::max(1, args.GetInt("quads", static_cast<int>(config.Renderer.MaxQuadsInBatch)));
+		const int      lag        = std::max(0, args.GetInt("lag", 2));
+		const uint32_t regions    = static_cast<uint32_t>(std::max(1, args.GetInt("regions", StreamingRing::default_region_count)));
+
+		FastRandom random(args.GetInt("seed", 1));
+
+		/// Sized like the sprite batch renderer sizes its streaming buffer
+		constexpr uint64_t stride = sizeof(VertexQuad2D);
+		const uint64_t batchSize  = static_cast<uint64_t>(maxQuads) * quad_vertex_count * stride;
+		const uint64_t regionSize = batchSize * 2 + stride;
+
+		StreamingRing ring(regionSize * regions, regions);
+
+		/// Frame whose commands the pending fence of each region follows, -1 when there is none
+		std::vector<int>           fenceFrames(regions, -1);
+		std::vector<InFlightRange> inFlight;
+
+		int      gpuFrame       = -1;
+		uint64_t blockedWaits   = 0;
+		uint64_t overwrites     = 0;
+		uint64_t misaligned     = 0;
+		uint64_t failed         = 0;
+		double   allocateMs     = 0.0;
+
+		for (int frame = 0; frame < frames; frame++)
+		{
+			/// The GPU finished everything up to `lag` frames before the one being recorded
+			gpuFrame = std::max(gpuFrame, frame - lag - 1);
+			std::erase_if(inFlight, [gpuFrame](const InFlightRange& range) { return range.Frame <= gpuFrame; });
+
+			const int batches = random.GetInt32InRange(1, maxBatches);
+			for (int batch = 0; batch < batches; batch++)
+			{
+				const uint64_t size = static_cast<uint64_t>(random.GetInt32InRange(1, maxQuads)) * quad_vertex_count * stride;
+
+				Timer allocateTimer;
+				const StreamingAllocation allocation = ring.Allocate(size, stride);
+				allocateMs += allocateTimer.GetElapsedMilliseconds();
+
+				if (!allocation.IsValid())
+				{
+					failed++;
+					continue;
+				}
+
+				if (allocation.ClosedRegion != invalid_streaming_region)
+					fenceFrames[allocation.ClosedRegion] = frame;
+
+				if (allocation.OpenedRegion != invalid_streaming_region)
+				{
+					const uint32_t opened = allocation.OpenedRegion;
+
+					/// Waiting on the fence means the GPU is done with every range of the region, they were all written before it
+					if (fenceFrames[opened] > gpuFrame)
+						blockedWaits++;
+
+					fenceFrames[opened] = -1;
+					std::erase_if(inFlight, [opened](const InFlightRange& range) { return range.Region == opened; });
+				}
+
+				if (allocation.Offset % stride != 0)
+					misaligned++;
+
+				for (const InFlightRange& range : inFlight)
+				{
+					if (allocation.Offset < range.Offset + range.Size && range.Offset < allocation.Offset + size)
+						overwrites++;
+				}
+
+				inFlight.push_back({ allocation.Offset, size, ring.GetRegion(), frame });
+			}
+		}
+
+		const StreamingRingStats& stats = ring.GetStats();
+		const bool passed = failed == 0 && overwrites == 0 && misaligned == 0 && stats.FailedAllocations == 0;
+
+		KC_CORE_INFO("Ring:             {} regions of {:.2f} MB, batches of up to {} quads", regions, regionSize / (1024.0 * 1024.0), maxQuads);
+		KC_CORE_INFO("Frames:           {} with 1 to {} batches, GPU {} frames behind", frames, maxBatches, lag);
+		KC_CORE_INFO("Allocations:      {} ({:.1f} ns each), {:.2f} MB streamed", stats.Allocations, stats.Allocations > 0 ? allocateMs * 1'000'000.0 / stats.Allocations : 0.0, stats.AllocatedBytes / (1024.0 * 1024.0));
+		KC_CORE_INFO("Regions:          {} switches, {:.1f}% padding", stats.RegionSwitches, stats.AllocatedBytes > 0 ? stats.PaddingBytes * 100.0 / (stats.AllocatedBytes + stats.PaddingBytes) : 0.0);
+		KC_CORE_INFO("Fence waits:      {} of {} region switches blocked, the ring holds {:.1f} frames", blockedWaits, stats.RegionSwitches,
+			stats.AllocatedBytes > 0 ? (double)ring.GetCapacity() * frames / (stats.AllocatedBytes + stats.PaddingBytes) : 0.0);
+		KC_CORE_INFO("Validation:       {}", passed ? "passed" : "failed");
+
+		return passed ? 0 : 1;
+	}
+
+}
@@ -0,0 +1,18 @@
+#pragma once
+
+#include "BenchUtils.h"
+
+namespace KuchCraft::Bench {
+
+	/// Streams random sprite batches through a StreamingRing against a simulated GPU that finishes frames a few frames
+	/// behind, waiting on region fences like StreamingBuffer does. Returns 1 when an allocation fails, is misaligned
+	/// or overwrites a range the GPU may still read.
+	///   --frames     F      frames to record (default 5000)
+	///   --batches    B      most batches of one frame, each frame draws 1 to B (default 3)
+	///   --quads      Q      most quads of one batch (default from config)
+	///   --lag        L      frames the GPU runs behind the CPU (default 2)
+	///   --regions    R      regions of the ring (default 3)
+	///   --seed       S      random seed (default 1)
+	int RunStreamingRingBenchmark(const Config& config, const Arguments& args);
+
+}
@@ -0,0 +1,172 @@
+#include "kcpch.h"
+#include "TextureSlotBenchmark.h"
+
+#include "Graphics/Core/RenderQueue.h"
+#include "Graphics/Core/TextureSlotTable.h"
+
+namespace KuchCraft::Bench {
+
+	struct SlotAssignment
+	{
+		std::vector<int> Slots;
+		uint32_t         Batches = 0;
+	};
+
+	/// What the renderer did before TextureSlotTable, every textured sprite scans the slots bound in its batch
+	static void AssignLinear(const std::vector<RendererID>& textures, uint32_t slotCount, uint32_t maxQuadsInBatch, SlotAssignment& result)
+	{
+		std::vector<RendererID> bound(slotCount, 0);
+		uint32_t usedSlots = 1;
+		uint32_t quads     = 0;
+
+		result.Slots.clear();
+		result.Batches = 1;
+		for (const RendererID texture : textures)
+		{
+			if (quads == maxQuadsInBatch)
+			{
+				result.Batches++;
+				usedSlots = 1;
+				quads     = 0;
+			}
+
+			int slot = 0;
+			if (texture != 0)
+			{
+				for (uint32_t i = 1; i < usedSlots; i++)
+				{
+					if (bound[i] == texture)
+					{
+						slot = (int)i;
+						break;
+					}
+				}
+
+				if (slot == 0)
+				{
+					if (usedSlots >= slotCount)
+					{
+						result.Batches++;
+						usedSlots = 1;
+						quads     = 0;
+					}
+
+					slot = (int)usedSlots;
+					bound[usedSlots++] = texture;
+				}
+			}
+
+			result.Slots.push_back(slot);
+			quads++;
+		}
+	}
+
+	static void AssignTable(const std::vector<RendererID>& textures, TextureSlotTable& table, uint32_t maxQuadsInBatch, SlotAssignment& result)
+	{
+		uint32_t quads = 0;
+
+		result.Slots.clear();
+		result.Batches = 1;
+		table.NextBatch();
+		for (const RendererID texture : textures)
+		{
+			if (quads == maxQuadsInBatch)
+			{
+				result.Batches++;
+				table.NextBatch();
+				quads = 0;
+			}
+
+			int slot = 0;
+			if (texture != 0)
+			{
+				slot = table.GetSlot(texture);
+				if (slot == TextureSlotTable::invalid_slot)
+				{
+					result.Batches++;
+					table.NextBatch();
+					quads = 0;
+
+					slot = table.GetSlot(texture);
+				}
+			}
+
+			result.Slots.push_back(slot);
+			quads++;
+		}
+	}
+
+	/// Returns false when both assignments differ
+	static bool RunOrder(const char* name, const std::vector<RendererID>& textures, uint32_t slotCount, uint32_t maxQuadsInBatch, int iterations)
+	{
+		SlotAssignment linear;
+		Timer linearTimer;
+		for (int i = 0; i < iterations; i++)
+			AssignLinear(textures, slotCount, maxQuadsInBatch, linear);
+		const double linearMilliseconds = linearTimer.GetElapsedMilliseconds() / iterations;
+
+		TextureSlotTable table(slotCount, 1);
+		SlotAssignment hashed;
+		Timer tableTimer;
+		for (int i = 0; i < iterations; i++)
+			AssignTable(textures, table, maxQuadsInBatch, hashed);
+		const double tableMilliseconds = tableTimer.GetElapsedMilliseconds() / iterations;
+
+		const bool passed = linear.Slots == hashed.Slots && linear.Batches == hashed.Batches;
+
+		KC_CORE_INFO("{}:", name);
+		KC_CORE_INFO("  Batches:        {}", hashed.Batches);
+		KC_CORE_INFO("  Linear scan:    {:.3f} ms ({:.2f} ns per sprite)", linearMilliseconds, linearMilliseconds * 1'000'000.0 / textures.size());
+		KC_CORE_INFO("  Slot table:     {:.3f} ms ({:.2f} ns per sprite)", tableMilliseconds, tableMilliseconds * 1'000'000.0 / textures.size());
+		KC_CORE_INFO("  Validation:     {}", passed ? "passed" : "failed");
+
+		return passed;
+	}
+
+	int RunTextureSlotBenchmark(const Config& config, const Arguments& args)
+	{
+		const int      sprites    = std::max(1, args.GetInt("sprites", 100'000));
+		const int      textures   = std::max(1, args.GetInt("textures", 200));
+		const uint32_t slotCount  = static_cast<uint32_t>(std::max(2, args.GetInt("slots", config.Renderer.MaxCombinedTextureSlots)));
+		const int      iterations = std::max(1, args.GetInt("iterations", 100));
+
+		FastRandom random(args.GetInt("seed", 1));
+
+		/// Renderer ids of real textures start above a few reserved ones
+		constexpr RendererID first_texture_id = 8;
+
+		std::vector<RendererID> submitted;
+		submitted.reserve(sprites);
+		for (int i = 0; i < sprites; i++)
+			submitted.push_back(random.GetInt32InRange(0, 9) == 0 ? 0 : first_texture_id + random.GetInt32InRange(0, textures - 1));
+
+		/// Sprites of one layer share a depth, so the renderer keys only tell them apart by texture
+		RenderQueue queue;
+		queue.Reserve(sprites);
+
+		Timer sortTimer;
+		for (int i = 0; i < iterations; i++)
+		{
+			queue.Clear();
+			for (uint32_t index = 0; index < static_cast<uint32_t>(sprites); index++)
+				queue.Add(RenderSortKey::Blended(RenderPass::Overlay, RenderSortKey::BackToFront(1.0f), 1, submitted[index]), index);
+
+			queue.Sort();
+		}
+		const double sortMilliseconds = sortTimer.GetElapsedMilliseconds() / iterations;
+
+		std::vector<RendererID> sorted;
+		sorted.reserve(sprites);
+		for (const RenderQueueItem& item : queue.GetItems())
+			sorted.push_back(submitted[item.Index]);
+
+		KC_CORE_INFO("Sprites:          {} over {} textures, {} slots per batch", sprites, textures, slotCount);
+		KC_CORE_INFO("Texture sort:     {:.3f} ms", sortMilliseconds);
+
+		const bool submittedPassed = RunOrder("Submission order", submitted, slotCount, config.Renderer.MaxQuadsInBatch, iterations);
+		const bool sortedPassed    = RunOrder("Sorted by texture", sorted, slotCount, config.Renderer.MaxQuadsInBatch, iterations);
+
+		return submittedPassed && sortedPassed ? 0 : 1;
+	}
+
+}
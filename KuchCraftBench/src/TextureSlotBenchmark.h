@@ -0,0 +1,16 @@
+#pragma once
+
+#include "BenchUtils.h"
+
+namespace KuchCraft::Bench {
+
+	/// Assigns batch texture slots to sprites with a linear scan of the bound textures and with TextureSlotTable,
+	/// once in submission order and once grouped by texture like the renderer sorts them. Returns 1 when the slots differ.
+	///   --sprites    N      sprites per frame, a tenth of them untextured (default 100000)
+	///   --textures   T      distinct textures (default 200)
+	///   --slots      S      texture slots of one batch, the white texture included (default from config)
+	///   --iterations I      frames of each run (default 100)
+	///   --seed       R      random seed (default 1)
+	int RunTextureSlotBenchmark(const Config& config, const Arguments& args);
+
+}
@@ -0,0 +1,140 @@
+#include "kcpch.h"
+#include "VisibilityBenchmark.h"
+
+#include "Graphics/Core/Camera.h"
+#include "Graphics/KuchCraft/SectionVisibility.h"
+#include "KuchCraft/World/Block.h"
+
+namespace KuchCraft::Bench {
+
+	/// Sections below this one are solid, the one above it is the surface
+	constexpr uint32_t bench_ground_section = 4;
+
+	static bool ValidateConnectivity()
+	{
+		SectionOpacity opacity = {};
+		if (ComputeSectionConnectivity(opacity) != section_connectivity_all)
+			return false;
+
+		for (auto& layer : opacity)
+			layer.fill(0xFFFF);
+		if (ComputeSectionConnectivity(opacity) != 0)
+			return false;
+
+		/// Tunnel along x through solid blocks joins only the left and right face
+		opacity[8][8] = 0;
+		if (ComputeSectionConnectivity(opacity) != GetSectionFacePairBit((uint32_t)BlockFace::Left, (uint32_t)BlockFace::Right))
+			return false;
+
+		/// Air pocket that touches no face
+		opacity[8][8] = 0xFFFF & ~0x0180;
+		if (ComputeSectionConnectivity(opacity) != 0)
+			return false;
+
+		/// Solid floor in the middle of air separates top from bottom only
+		for (auto& layer : opacity)
+			layer.fill(0);
+		opacity[8].fill(0xFFFF);
+		const SectionConnectivity topBottom = GetSectionFacePairBit((uint32_t)BlockFace::Top, (uint32_t)BlockFace::Bottom);
+		if (ComputeSectionConnectivity(opacity) != (section_connectivity_all & ~topBottom))
+			return false;
+
+		return true;
+	}
+
+	int RunVisibilityBenchmark(const Config& config, const Arguments& args)
+	{
+		const int radius     = std::max(1, args.GetInt("radius", 32));
+		const int iterations = std::max(1, args.GetInt("iterations", 100));
+
+		if (!ValidateConnectivity())
+		{
+			KC_CORE_ERROR("Section connectivity is wrong");
+			return 1;
+		}
+
+		/// Cost of the flood fill on a section with random holes
+		FastRandom random(args.GetInt("seed", 1));
+		SectionOpacity noise;
+		for (auto& layer : noise)
+		{
+			for (auto& row : layer)
+				row = static_cast<uint16_t>(random.GetUInt32() & random.GetUInt32());
+		}
+
+		constexpr int connectivity_runs = 1000;
+		SectionConnectivity noiseConnectivity = 0;
+		Timer connectivityTimer;
+		for (int i = 0; i < connectivity_runs; i++)
+			noiseConnectivity |= ComputeSectionConnectivity(noise);
+		const double connectivityMicroseconds = connectivityTimer.GetElapsedMilliseconds() * 1000.0 / connectivity_runs;
+
+		/// Open air above the ground, solid sections below it with sealed caves in some columns
+		SectionVisibilityGraph graph;
+		graph.Reset(glm::ivec2(-radius), glm::ivec2(radius));
+
+		std::vector<std::pair<glm::ivec2, uint32_t>> caves;
+		for (int z = -radius; z <= radius; z++)
+		{
+			for (int x = -radius; x <= radius; x++)
+			{
+				for (uint32_t section = 0; section <= bench_ground_section; section++)
+					graph.SetConnectivity({ x, z }, section, 0);
+
+				/// Never next to each other, so every cave stays sealed
+				if ((x & 1) == 0 && (z & 1) == 0 && random.GetInt32InRange(0, 3) == 0)
+				{
+					const uint32_t section = static_cast<uint32_t>(random.GetInt32InRange(1, bench_ground_section - 2));
+					graph.SetConnectivity({ x, z }, section, section_connectivity_all);
+					caves.emplace_back(glm::ivec2(x, z), section);
+				}
+			}
+		}
+
+		Camera camera(glm::radians(90.0f), 16.0f / 9.0f, 0.1f, 2000.0f);
+		camera.UpdateTransform(glm::vec3(8.0f, (bench_ground_section + 1) * section_size_y + 4.0f, 8.0f), glm::vec3(0.0f, glm::radians(-20.0f), 0.0f));
+		const Frustum frustum(camera.GetViewProjection());
+
+		uint32_t visibleCount = 0;
+		Timer traverseTimer;
+		for (int i = 0; i < iterations; i++)
+			visibleCount = graph.Traverse(camera.GetPosition(), frustum);
+		const double traverseMilliseconds = traverseTimer.GetElapsedMilliseconds() / iterations;
+
+		/// Ground is seen from above, nothing under its top section is
+		for (int z = -radius; z <= radius; z++)
+		{
+			for (int x = -radius; x <= radius; x++)
+			{
+				if (graph.GetVisibleSections({ x, z }) & (BIT(bench_ground_section) - 1))
+				{
+					KC_CORE_ERROR("Buried section of chunk ({}, {}) was reached", x, z);
+					return 1;
+				}
+			}
+		}
+
+		/// Walking from inside a cave reaches only the cave itself
+		uint32_t caveVisible = 0;
+		if (!caves.empty())
+		{
+			const auto& [chunk, section] = caves.front();
+			const glm::vec3 inside = { chunk.x * (int)chunk_size_x + 8.0f, section * section_size_y + 8.0f, chunk.y * (int)chunk_size_z + 8.0f };
+			caveVisible = graph.Traverse(inside, Frustum());
+			if (caveVisible > 1 + block_face_count)
+			{
+				KC_CORE_ERROR("Walk from a sealed cave reached {} sections", caveVisible);
+				return 1;
+			}
+		}
+
+		KC_CORE_INFO("Connectivity:     {:.2f} us per section (noise joins 0x{:04x})", connectivityMicroseconds, noiseConnectivity);
+		KC_CORE_INFO("Sections:         {} in {} chunks", graph.GetSectionCount(), (2 * radius + 1) * (2 * radius + 1));
+		KC_CORE_INFO("Reached:          {} from the surface, {} from a cave", visibleCount, caveVisible);
+		KC_CORE_INFO("Walk:             {:.3f} ms", traverseMilliseconds);
+		KC_CORE_INFO("Validation:       passed");
+
+		return 0;
+	}
+
+}
@@ -0,0 +1,14 @@
+#pragma once
+
+#include "BenchUtils.h"
+
+namespace KuchCraft::Bench {
+
+	/// Checks ComputeSectionConnectivity on hand made sections, then walks SectionVisibilityGraph over a synthetic world:
+	/// open air above solid ground with sealed caves in it. Returns 1 if a sealed cave or buried section is reached.
+	///   --radius     R      chunks around the camera (default 32)
+	///   --iterations I      how many times the graph is walked (default 100)
+	///   --seed       S      random seed for cave placement
+	int RunVisibilityBenchmark(const Config& config, const Arguments& args);
+
+}
@@ -0,0 +1,139 @@
+#include "kcpch.h"
+#include "WorldGenBenchmark.h"
+
+#include "KuchCraft/World/ItemManager.h"
+#include "KuchCraft/World/WorldGenerator.h"
+#include "KuchCraft/World/WorldStorage.h"
+
+namespace KuchCraft::Bench {
+
+	int RunWorldGenBenchmark(const Config& config, const Arguments& args)
+	{
+		const int      size        = std::max(1, args.GetInt("size", 16));
+		const uint32_t threadCount = static_cast<uint32_t>(std::max(1, args.GetInt("threads", static_cast<int>(std::max(1u, std::thread::hardware_concurrency())))));
+		const uint32_t seed        = static_cast<uint32_t>(args.GetInt("seed", static_cast<int>(default_world_seed)));
+		const std::string dataPack = args.GetString("datapack", "default");
+
+		/// No OpenGL context, only item data is needed
+		ItemManager itemManager(config);
+		if (!itemManager.SetDataPack(dataPack, false))
+		{
+			KC_CORE_ERROR("Failed to load data pack: {}", dataPack);
+			return 1;
+		}
+
+		WorldGenerator generator(config, WorldGeneratorBlocks::Resolve(itemManager), seed);
+
+		std::vector<Ref<Chunk>> chunks;
+		chunks.reserve(static_cast<size_t>(size) * size);
+		for (int z = 0; z < size; z++)
+		{
+			for (int x = 0; x < size; x++)
+			{
+				const glm::ivec3 position = { (x - size / 2) * (int)chunk_size_x, 0, (z - size / 2) * (int)chunk_size_z };
+				chunks.push_back(CreateRef<Chunk>(position, nullptr));
+			}
+		}
+
+		KC_CORE_INFO("Generating {}x{} chunks on {} thread(s), seed {}", size, size, threadCount, seed);
+
+		std::vector<double> latencies(chunks.size());
+		std::atomic<size_t> nextChunk = 0;
+
+		Timer totalTimer;
+		{
+			std::vector<std::thread> workers;
+			workers.reserve(threadCount);
+			for (uint32_t t = 0; t < threadCount; t++)
+			{
+				workers.emplace_back([&]() {
+					for (size_t i = nextChunk++; i < chunks.size(); i = nextChunk++)
+					{
+						Timer chunkTimer;
+						generator.GenerateChunk(chunks[i]);
+						chunks[i]->Build();
+						latencies[i] = chunkTimer.GetElapsedMilliseconds();
+					}
+				});
+			}
+
+			for (auto& worker : workers)
+				worker.join();
+		}
+		const double generationSeconds = totalTimer.GetElapsedSeconds();
+
+		/// Edits recorded by neighbors that finished after the target, same as World does for loaded chunks
+		Timer editsTimer;
+		uint32_t lateEdits = 0;
+		for (auto& chunk : chunks)
+			lateEdits += generator.GetPendingEdits().ApplyNew(*chunk);
+		const double editsMilliseconds = editsTimer.GetElapsedMilliseconds();
+
+		const double totalSeconds = totalTimer.GetElapsedSeconds();
+
+		/// A chunk generated again next to loaded neighbors, like after it was unloaded, has to replace its writes into them
+		/// instead of adding to them or writing them into the loaded neighbors again
+		const size_t editCount = generator.GetPendingEdits().GetEditCount();
+		generator.GenerateChunk(CreateRef<Chunk>(chunks[chunks.size() / 2]->GetPosition(), nullptr));
+
+		uint32_t reappliedEdits = 0;
+		for (auto& chunk : chunks)
+			reappliedEdits += generator.GetPendingEdits().ApplyNew(*chunk);
+
+		const bool regenerationPassed = reappliedEdits == 0 && generator.GetPendingEdits().GetEditCount() == editCount;
+
+		KC_CORE_INFO("Chunks:           {}", chunks.size());
+		KC_CORE_INFO("Total time:       {:.3f} s", totalSeconds);
+		KC_CORE_INFO("Throughput:       {:.1f} chunks/s", totalSeconds > 0.0 ? chunks.size() / totalSeconds : 0.0);
+		KC_CORE_INFO("Latency p50:      {:.3f} ms", Percentile(latencies, 0.50));
+		KC_CORE_INFO("Latency p99:      {:.3f} ms", Percentile(latencies, 0.99));
+		KC_CORE_INFO("Generation:       {:.3f} s", generationSeconds);
+		KC_CORE_INFO("Late edits:       {} blocks in {:.3f} ms", lateEdits, editsMilliseconds);
+		KC_CORE_INFO("Pending edits:    {} in {} chunk(s), {:.2f} KB", generator.GetPendingEdits().GetEditCount(),
+			generator.GetPendingEdits().GetTargetCount(), generator.GetPendingEdits().GetMemoryUsage() / 1024.0);
+		KC_CORE_INFO("Regeneration:     {} ({} edits applied again)", regenerationPassed ? "passed" : "failed", reappliedEdits);
+		KC_CORE_INFO("Peak memory:      {:.2f} MB", GetPeakMemoryUsage() / (1024.0 * 1024.0));
+
+		if (!regenerationPassed)
+			return 1;
+
+		if (args.Has("output"))
+		{
+			std::filesystem::path output = args.GetString("output", config.Game.WorldsDir + "Pregenerated/world" + WorldStorage::DefaultExtension);
+
+			Timer saveTimer;
+			if (!WorldStorage::Save(output, seed, chunks, itemManager))
+				return 1;
+
+			KC_CORE_INFO("Saved world:      {} ({:.2f} MB in {:.3f} s)", output.string(),
+				std::filesystem::file_size(output) / (1024.0 * 1024.0), saveTimer.GetElapsedSeconds());
+
+			/// The saved world has to load back block for block
+			Timer loadTimer;
+			uint32_t loadedSeed = 0;
+			std::vector<Ref<Chunk>> loadedChunks;
+			if (!WorldStorage::Load(output, loadedSeed, loadedChunks, itemManager))
+				return 1;
+			const double loadSeconds = loadTimer.GetElapsedSeconds();
+
+			bool roundTripPassed = loadedSeed == seed && loadedChunks.size() == chunks.size();
+			for (size_t i = 0; roundTripPassed && i < chunks.size(); i++)
+			{
+				roundTripPassed = loadedChunks[i]->GetPosition() == chunks[i]->GetPosition();
+				for (uint32_t section = 0; roundTripPassed && section < sections_per_chunk; section++)
+				{
+					const auto& expected = chunks[i]->GetSection(section).GetBlocks();
+					const auto& loaded   = loadedChunks[i]->GetSection(section).GetBlocks();
+					roundTripPassed = std::equal(expected.begin(), expected.end(), loaded.begin(), [](Block a, Block b) { return a.Raw == b.Raw; });
+				}
+			}
+
+			KC_CORE_INFO("Loaded world:     {} in {:.3f} s", roundTripPassed ? "matches" : "differs", loadSeconds);
+			if (!roundTripPassed)
+				return 1;
+		}
+
+		return 0;
+	}
+
+}
@@ -0,0 +1,16 @@
+#pragma once
+
+#include "BenchUtils.h"
+
+namespace KuchCraft::Bench {
+
+	/// Generates an N x N chunk area around the origin without a window or OpenGL context. Returns 1 when a chunk
+	/// generated again writes its pending edits into loaded neighbors again.
+	///   --size     N        area size in chunks (default 16)
+	///   --threads  T        worker threads (default hardware concurrency)
+	///   --seed     S        world seed
+	///   --datapack name     data pack to load item data from (default "default")
+	///   --output   path     write the generated area as a pregenerated world and check that it loads back unchanged
+	int RunWorldGenBenchmark(const Config& config, const Arguments& args);
+
+}
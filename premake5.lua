@@ -111,3 +111,108 @@ project "KuchCraft"
         symbols  "off"
         vectorextensions "AVX2"
 		isaextensions { "BMI", "POPCNT", "LZCNT", "F16C" }
+
+project "KuchCraftBench"
+    kind       "ConsoleApp"
+    language   "C++"
+    cppdialect "C++20"
+    location   "KuchCraftBench"
+    targetdir ("%{wks.location}/bin/"     .. outputdir .. "/%{prj.name}")
+    objdir    ("%{wks.location}/bin-int/" .. outputdir .. "/%{prj.name}")
+    debugdir   "%{wks.location}/KuchCraft"
+
+    pchheader "kcpch.h"
+    pchsource "%{wks.location}/KuchCraft/src/kcpch.cpp"
+
+    -- Headless subset of the game, nothing here may need a window or an OpenGL context
+    files
+    {
+        "%{wks.location}/KuchCraftBench/src/**.h",
+        "%{wks.location}/KuchCraftBench/src/**.cpp",
+
+        "%{wks.location}/KuchCraft/src/kcpch.h",
+        "%{wks.location}/KuchCraft/src/kcpch.cpp",
+        "%{wks.location}/KuchCraft/src/Core/Base.cpp",
+        "%{wks.location}/KuchCraft/src/Core/Config.cpp",
+        "%{wks.location}/KuchCraft/src/Core/CoreUtils.cpp",
+        "%{wks.location}/KuchCraft/src/Core/Log.cpp",
+        "%{wks.location}/KuchCraft/src/Core/Noise.cpp",
+        "%{wks.location}/KuchCraft/src/Core/UUID.cpp",
+        "%{wks.location}/KuchCraft/src/KuchCraft/World/**.cpp",
+        "%{wks.location}/KuchCraft/src/Graphics/KuchCraft/ChunkMesh.cpp",
+        "%{wks.location}/KuchCraft/src/Graphics/KuchCraft/MeshBufferPool.cpp",
+        "%{wks.location}/KuchCraft/src/Graphics/KuchCraft/ChunkDrawCommands.cpp",
+        "%{wks.location}/KuchCraft/src/Graphics/KuchCraft/SectionVisibility.cpp",
+        "%{wks.location}/KuchCraft/src/Graphics/Core/BufferAllocator.cpp",
+        "%{wks.location}/KuchCraft/src/Graphics/Core/Camera.cpp",
+        "%{wks.location}/KuchCraft/src/Graphics/Core/Frustum.cpp",
+        "%{wks.location}/KuchCraft/src/Graphics/Core/RenderQueue.cpp",
+        "%{wks.location}/KuchCraft/src/Graphics/Core/RenderCommandBuffer.cpp",
+        "%{wks.location}/KuchCraft/src/Graphics/Core/RenderBackend.cpp",
+        "%{wks.location}/KuchCraft/src/Graphics/Core/RenderThread.cpp",
+        "%{wks.location}/KuchCraft/src/Graphics/Core/TextureSlotTable.cpp",
+        "%{wks.location}/KuchCraft/src/Graphics/Core/StreamingRing.cpp",
+        "%{wks.location}/KuchCraft/src/Graphics/Core/GraphicsUtils.cpp",
+        "%{wks.location}/KuchCraft/src/Graphics/Core/Texture.cpp",
+        "%{wks.location}/KuchCraft/vendor/stb_image/**.cpp"
+    }
+
+    removefiles
+    {
+        "%{wks.location}/KuchCraft/src/KuchCraft/World/World.cpp"
+    }
+
+    includedirs
+    {
+        "%{wks.location}/KuchCraftBench/src",
+        "%{wks.location}/KuchCraft/src",
+        "%{wks.location}/KuchCraft/vendor",
+        "%{wks.location}/KuchCraft/vendor/glfw/include",
+        "%{wks.location}/KuchCraft/vendor/glad/include",
+        "%{wks.location}/KuchCraft/vendor/spdlog/include",
+        "%{wks.location}/KuchCraft/vendor/glm",
+        "%{wks.location}/KuchCraft/vendor/stb_image",
+        "%{wks.location}/KuchCraft/vendor/magic_enum",
+        "%{wks.location}/KuchCraft/vendor/imgui",
+        "%{wks.location}/KuchCraft/vendor/entt/src",
+        "%{wks.location}/KuchCraft/vendor/nlohmann_json",
+    }
+
+    -- Glad is linked only to resolve texture code, it is never loaded
+    links
+    {
+        "Glad"
+    }
+
+    defines
+    {
+        "_CRT_SECURE_NO_WARNINGS",
+        "GLFW_INCLUDE_NONE",
+        "KC_HAS_CONSOLE"
+    }
+
+    filter "system:windows"
+        systemversion "latest"
+        defines { "KC_PLATFORM_WINDOWS" }
+
+    filter   "configurations:Debug"
+        defines  "KC_DEBUG"
+        runtime  "Debug"
+        optimize "off"
+        symbols  "on"
+
+    filter   "configurations:Release"
+        defines  "KC_RELEASE"
+        runtime  "Release"
+        optimize "on"
+        symbols  "on"
+        vectorextensions "AVX2"
+		isaextensions { "BMI", "POPCNT", "LZCNT", "F16C" }
+
+    filter   "configurations:Dist"
+        defines  "KC_DIST"
+        runtime  "Release"
+        optimize "on"
+        symbols  "off"
+        vectorextensions "AVX2"
+		isaextensions { "BMI", "POPCNT", "LZCNT", "F16C" }